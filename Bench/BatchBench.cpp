@@ -0,0 +1,182 @@
+// Evaluacion por lotes (BatchEval.h): prueba diferencial contra Game y
+// Board y velocidad de cada conjunto de instrucciones.
+//
+// Para 3x3, 4x4 y 5x5 genera posiciones al azar de dos tipos:
+//   partidas  jugadas al azar con Game::playTurn, cortadas en cualquier
+//             punto; se comparan contra checkWinner() e isBoardFull()
+//   mascaras  cada casilla libre, X u O al azar (aunque no se pueda llegar
+//             jugando, p. ej. los dos con linea); se comparan contra
+//             Board::hasLine() e isFull() con la misma prioridad de X
+// y evalua el lote con cada conjunto que tenga la CPU. Cualquier diferencia
+// en estado o casillas legales se muestra y el programa sale con 1.
+//
+// Compilar:
+//   g++ -O2 -std=c++17 Bench/BatchBench.cpp Src/BatchEval.cpp Src/Game.cpp Src/PerfectTable.cpp Src/Tablebase.cpp Src/Logger.cpp Src/Metrics.cpp Src/SaveStore.cpp Src/SaveIndex.cpp Src/SaveBlobs.cpp Src/SaveExecutor.cpp Src/FileManager.cpp -pthread -o batch_bench
+// o con CMake: cmake --build build --target batch_bench
+//
+// Uso:
+//   ./batch_bench [--rapido] [posiciones por tipo] [semilla]
+// --rapido: 4096 posiciones por tipo y una sola vuelta de medicion; solo
+// para la prueba diferencial (ctest la corre asi)
+#include "../Src/BatchEval.h"
+#include "../Src/Game.h"
+#include "../Src/Logger.h"
+#include "../Src/Random.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int ROUNDS = 50;  // Repeticiones de cada medicion (1 con --rapido)
+
+template <int Rows, int Cols, int K>
+struct Variant {
+    using GameType = BasicGame<Rows, Cols, K>;
+    using Batch = BoardBatch<Rows, Cols, K>;
+    using Lane = typename Batch::Lane;
+
+    std::vector<GameType> games;       // Solo el tipo 'partidas'
+    std::vector<BatchStatus> expected;
+    std::vector<Lane> expectedLegal;
+    Batch batch;
+};
+
+template <typename Lane>
+Lane emptyCells(Lane occupied, int cells) {
+    Lane full = static_cast<Lane>((cells == 32) ? ~0u : ((1u << cells) - 1));
+    return static_cast<Lane>(full & ~occupied);
+}
+
+template <int Rows, int Cols, int K>
+void fillPositions(Variant<Rows, Cols, K>& variant, int count, std::uint64_t& rng) {
+    using Lane = typename Variant<Rows, Cols, K>::Lane;
+    constexpr int CELLS = Rows * Cols;
+    variant.batch.reserve(2 * count);
+
+    // Partidas al azar a traves de Game, hasta un largo al azar
+    typename Variant<Rows, Cols, K>::GameType game;
+    for (int p = 0; p < count; p++) {
+        game.resetGame();
+        int length = static_cast<int>(nextRandom(rng) % (CELLS + 1));
+        while (game.getMoveCount() < length && !game.isGameEnded()) {
+            int cell = static_cast<int>(nextRandom(rng) % CELLS);
+            game.playTurn(cell / Cols, cell % Cols);
+        }
+        BatchStatus status = BATCH_PLAYING;
+        if (game.checkWinner()) {
+            status = game.getWinner() == 'X' ? BATCH_X_WINS : BATCH_O_WINS;
+        } else if (game.isBoardFull()) {
+            status = BATCH_DRAW;
+        }
+        const auto& board = game.getBoard();
+        Lane occupied = static_cast<Lane>(board.occupied().words[0]);
+        variant.games.push_back(game);
+        variant.expected.push_back(status);
+        variant.expectedLegal.push_back(status == BATCH_PLAYING ? emptyCells<Lane>(occupied, CELLS) : 0);
+        variant.batch.add(board);
+    }
+
+    // Mascaras arbitrarias
+    for (int p = 0; p < count; p++) {
+        Board<Rows, Cols, K> board;
+        for (int cell = 0; cell < CELLS; cell++) {
+            int owner = static_cast<int>(nextRandom(rng) % 3);
+            if (owner < 2) board.play(cell, owner);
+        }
+        BatchStatus status = board.hasLine(0) ? BATCH_X_WINS : board.hasLine(1) ? BATCH_O_WINS :
+                             board.isFull() ? BATCH_DRAW : BATCH_PLAYING;
+        Lane occupied = static_cast<Lane>(board.occupied().words[0]);
+        variant.expected.push_back(status);
+        variant.expectedLegal.push_back(status == BATCH_PLAYING ? emptyCells<Lane>(occupied, CELLS) : 0);
+        variant.batch.add(board);
+    }
+}
+
+template <int Rows, int Cols, int K>
+long long runVariant(int count, std::uint64_t seed, int rounds) {
+    Variant<Rows, Cols, K> variant;
+    std::uint64_t rng = mixSeed(seed, Rows * 100 + Cols * 10 + K);
+    fillPositions(variant, count, rng);
+    auto& batch = variant.batch;
+    const int total = batch.size();
+
+    std::cout << "\n=== " << Rows << "x" << Cols << " (k=" << K << "), " << total << " posiciones, mascaras de "
+              << sizeof(typename Variant<Rows, Cols, K>::Lane) * 8 << " bits ===\n";
+
+    // Referencia: una llamada a checkWinner + isBoardFull por partida
+    long long scalarHits = 0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (auto& game : variant.games) {
+            scalarHits += game.checkWinner() + game.isBoardFull();
+        }
+    }
+    double scalarNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() /
+                      (static_cast<double>(variant.games.size()) * rounds);
+    std::cout << "Game::checkWinner + isBoardFull: " << scalarNs << " ns/tablero (" << scalarHits << ")\n";
+
+    long long mismatches = 0;
+    for (int isa = BATCH_SCALAR; isa <= BATCH_AVX512; isa++) {
+        if (!isBatchIsaSupported(static_cast<BatchIsa>(isa))) {
+            std::cout << batchIsaName(static_cast<BatchIsa>(isa)) << ": no disponible en esta CPU\n";
+            continue;
+        }
+        batch.evaluate(static_cast<BatchIsa>(isa));
+        long long wrong = 0;
+        for (int i = 0; i < total; i++) {
+            if (batch.getStatus(i) == variant.expected[i] && batch.getLegalMoves(i) == variant.expectedLegal[i]) {
+                continue;
+            }
+            if (wrong++ < 5) {
+                std::cout << "  DIFERENCIA en " << i << ": X=" << batch.getXBits(i) << " O=" << batch.getOBits(i)
+                          << " estado " << batch.getStatus(i) << " (esperado " << variant.expected[i]
+                          << "), legales " << batch.getLegalMoves(i) << " (esperado "
+                          << variant.expectedLegal[i] << ")\n";
+            }
+        }
+        mismatches += wrong;
+
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            batch.evaluate(static_cast<BatchIsa>(isa));
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+                    (static_cast<double>(total) * rounds);
+        std::cout << batchIsaName(static_cast<BatchIsa>(isa)) << ": " << ns << " ns/tablero ("
+                  << scalarNs / ns << "x), diferencias: " << wrong << "\n";
+    }
+    return mismatches;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--rapido") {
+            quick = true;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    int count = !positional.empty() ? std::stoi(positional[0]) : (quick ? 4096 : 1 << 16);
+    std::uint64_t seed = positional.size() > 1 ? std::stoull(positional[1]) : 12345;
+    const int rounds = quick ? 1 : ROUNDS;
+    Logger::setLevel(LOG_ERROR);
+
+    std::cout << "Mejor conjunto en esta CPU: " << batchIsaName(bestBatchIsa()) << ", semilla " << seed << "\n";
+    long long mismatches = runVariant<3, 3, 3>(count, seed, rounds);
+    mismatches += runVariant<4, 4, 4>(count, seed, rounds);
+    mismatches += runVariant<5, 5, 4>(count, seed, rounds);
+
+    std::cout << "\n" << (mismatches == 0 ? "Todos los conjuntos coinciden con Game y Board"
+                                          : "HAY DIFERENCIAS: " + std::to_string(mismatches)) << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// Benchmark: deteccion de ganador con tablero char[9] (version original)
+// contra la version con bitboards de Game.
+//
+// Compilar:
+//   g++ -O2 -std=c++17 Bench/BitboardBench.cpp Src/Game.cpp Src/FileManager.cpp -o bitboard_bench
+#include "../Src/Game.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Copia de la representacion anterior: un char por casilla y 24 lecturas
+// con getIndex en el peor caso. Los metodos no se expanden en linea para
+// que ambas versiones paguen una llamada, igual que Game en su propio .cpp
+struct LegacyBoard {
+    char board[9];
+    
+    int getIndex(int row, int col) const { return row * 3 + col; }
+    
+    __attribute__((noinline)) bool checkWinner() const {
+        for (int row = 0; row < 3; row++) {
+            if (board[getIndex(row, 0)] != ' ' &&
+                board[getIndex(row, 0)] == board[getIndex(row, 1)] &&
+                board[getIndex(row, 1)] == board[getIndex(row, 2)]) return true;
+        }
+        for (int col = 0; col < 3; col++) {
+            if (board[getIndex(0, col)] != ' ' &&
+                board[getIndex(0, col)] == board[getIndex(1, col)] &&
+                board[getIndex(1, col)] == board[getIndex(2, col)]) return true;
+        }
+        if (board[getIndex(0, 0)] != ' ' &&
+            board[getIndex(0, 0)] == board[getIndex(1, 1)] &&
+            board[getIndex(1, 1)] == board[getIndex(2, 2)]) return true;
+        if (board[getIndex(0, 2)] != ' ' &&
+            board[getIndex(0, 2)] == board[getIndex(1, 1)] &&
+            board[getIndex(1, 1)] == board[getIndex(2, 0)]) return true;
+        return false;
+    }
+    
+    __attribute__((noinline)) bool isBoardFull() const {
+        for (int i = 0; i < 9; i++) {
+            if (board[i] == ' ') return false;
+        }
+        return true;
+    }
+};
+
+int main() {
+    const int POSITIONS = 256;
+    const int ROUNDS = 20000;
+    
+    std::srand(12345);
+    std::vector<LegacyBoard> legacy(POSITIONS);
+    std::vector<Game> games;
+    games.reserve(POSITIONS);
+    
+    // Generar posiciones aleatorias identicas en ambas representaciones
+    Game proto;
+    for (int p = 0; p < POSITIONS; p++) {
+        proto.resetGame();
+        for (int i = 0; i < 9; i++) legacy[p].board[i] = ' ';
+        
+        int moves = std::rand() % 10;
+        for (int m = 0; m < moves; m++) {
+            int row = std::rand() % 3;
+            int col = std::rand() % 3;
+            if (proto.makeMove(row, col)) {
+                legacy[p].board[row * 3 + col] = proto.getCurrentPlayer();
+                proto.switchPlayer();
+            }
+        }
+        games.push_back(proto);
+    }
+    
+    using Clock = std::chrono::steady_clock;
+    long long legacyHits = 0, bitboardHits = 0;
+    
+    auto t0 = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (const auto& b : legacy) {
+            legacyHits += b.checkWinner() + b.isBoardFull();
+        }
+    }
+    auto t1 = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (auto& g : games) {
+            bitboardHits += g.checkWinner() + g.isBoardFull();
+        }
+    }
+    auto t2 = Clock::now();
+    
+    double calls = static_cast<double>(POSITIONS) * ROUNDS;
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+    double bitboardNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / calls;
+    
+    std::cout << "\n=== BENCHMARK checkWinner + isBoardFull ===\n";
+    std::cout << "Posiciones: " << POSITIONS << ", rondas: " << ROUNDS << "\n";
+    std::cout << "char[9]  : " << legacyNs << " ns/llamada (" << legacyHits << ")\n";
+    std::cout << "bitboard : " << bitboardNs << " ns/llamada (" << bitboardHits << ")\n";
+    std::cout << "Aceleracion: " << legacyNs / bitboardNs << "x\n";
+    std::cout << "===========================================\n";
+    
+    return legacyHits == bitboardHits ? 0 : 1;
+}
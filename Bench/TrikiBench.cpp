@@ -0,0 +1,414 @@
+// Benchmarks de Game y del guardado, con resultados en JSON para comparar
+// versiones y detectar regresiones.
+//   micro  makeMove, checkWinner, isBoardFull, constructor copia y operator=
+//   io     saveGame/loadGame, listSavedGames y cleanOldSaves sobre
+//          directorios sinteticos de 10^2 a 10^6 partidas
+//   juego  partidas aleatorias completas por segundo (3x3 y 4x4)
+//
+// Compilar:
+//   g++ -O2 -std=c++17 Bench/TrikiBench.cpp Src/Game.cpp Src/PerfectTable.cpp Src/Tablebase.cpp Src/Logger.cpp Src/Metrics.cpp Src/SaveStore.cpp Src/SaveIndex.cpp Src/SaveBlobs.cpp Src/SaveExecutor.cpp Src/FileManager.cpp -pthread -o triki_bench
+// o con CMake: cmake --build build --target triki_bench
+//
+// Uso:
+//   ./triki_bench [--salida archivo.json] [--grupo micro|io|juego] [--max-partidas N] [--dir directorio]
+//
+// Todo el trabajo de disco se hace en un directorio temporal (o en --dir)
+// que se borra al terminar. Los mensajes de avance van a std::cerr y el
+// JSON a std::cout o al archivo de --salida.
+#include "../Src/FileManager.h"
+#include "../Src/Game.h"
+#include "../Src/Logger.h"
+#include "../Src/Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int POSITIONS = 256;            // Posiciones de los microbenchmarks
+const int REPETITIONS = 5;            // Se informa la mediana
+const double MIN_SECONDS = 0.05;      // Duracion minima de cada repeticion
+const std::size_t WRITE_BATCH = 4096; // Partidas por tanda al llenar un directorio
+
+struct Result {
+    std::string group;
+    std::string name;
+    long long saves = 0;         // Tamano del directorio (solo io)
+    long long operations = 0;    // Operaciones por repeticion
+    int repetitions = 0;
+    double nsPerOp = 0.0;        // Mediana
+    double minNs = 0.0;
+    double maxNs = 0.0;
+};
+
+std::vector<Result> results;
+std::uint64_t checksum = 0;  // Evita que el compilador descarte el trabajo medido
+
+// Corre body(iteraciones) hasta que dure al menos MIN_SECONDS y luego
+// repite la medicion. body devuelve un valor que se suma al checksum;
+// opsPerIteration convierte iteraciones en operaciones.
+void measure(const std::string& group, const std::string& name, long long opsPerIteration,
+             const std::function<std::uint64_t(long long)>& body, long long saves = 0) {
+    long long iterations = 1;
+    for (;;) {
+        auto start = Clock::now();
+        checksum += body(iterations);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= MIN_SECONDS || iterations >= (1LL << 40)) break;
+        iterations = seconds > 0.0
+            ? std::max(iterations * 2, static_cast<long long>(iterations * MIN_SECONDS * 1.2 / seconds))
+            : iterations * 16;
+    }
+
+    std::vector<double> samples;
+    for (int r = 0; r < REPETITIONS; r++) {
+        auto start = Clock::now();
+        checksum += body(iterations);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(ns / (static_cast<double>(iterations) * opsPerIteration));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.group = group;
+    result.name = name;
+    result.saves = saves;
+    result.operations = iterations * opsPerIteration;
+    result.repetitions = REPETITIONS;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+    results.push_back(result);
+    std::cerr << "  " << name << (saves ? " (" + std::to_string(saves) + " partidas)" : "") << ": "
+              << result.nsPerOp << " ns/op" << std::endl;
+}
+
+// Operacion que no se puede repetir sobre el mismo estado: una sola medicion
+void measureOnce(const std::string& group, const std::string& name, long long saves,
+                 const std::function<void()>& body) {
+    auto start = Clock::now();
+    body();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    Result result;
+    result.group = group;
+    result.name = name;
+    result.saves = saves;
+    result.operations = 1;
+    result.repetitions = 1;
+    result.nsPerOp = result.minNs = result.maxNs = ns;
+    results.push_back(result);
+    std::cerr << "  " << name << " (" << saves << " partidas): " << ns / 1e6 << " ms" << std::endl;
+}
+
+// Casilla aleatoria entre las libres del tablero
+template <typename GameType>
+int randomFreeCell(const GameType& game, std::uint64_t& rng) {
+    const int cells = GameType::BoardType::CELLS;
+    int free = cells - game.getMoveCount();
+    int pick = static_cast<int>(nextRandom(rng) % static_cast<std::uint64_t>(free));
+    for (int cell = 0; cell < cells; cell++) {
+        if (game.getBoard().isEmpty(cell) && pick-- == 0) return cell;
+    }
+    return -1;
+}
+
+// Partida aleatoria completa con la interfaz publica de Game
+template <typename GameType>
+int playRandomGame(GameType& game, std::uint64_t& rng) {
+    const int cols = GameType::BoardType::COLS;
+    game.resetGame();
+    while (!game.isGameEnded()) {
+        int cell = randomFreeCell(game, rng);
+        game.playTurn(cell / cols, cell % cols);
+    }
+    return game.getMoveCount();
+}
+
+// Posiciones de 0 a 9 jugadas, como en BitboardBench
+std::vector<Game> randomPositions(std::uint64_t seed) {
+    std::uint64_t rng = mixSeed(seed, 0);
+    std::vector<Game> positions;
+    positions.reserve(POSITIONS);
+    Game game;
+    for (int p = 0; p < POSITIONS; p++) {
+        game.resetGame();
+        int moves = static_cast<int>(nextRandom(rng) % 10);
+        for (int m = 0; m < moves; m++) {
+            int cell = randomFreeCell(game, rng);
+            game.makeMove(cell / 3, cell % 3);
+            game.switchPlayer();
+        }
+        positions.push_back(game);
+    }
+    return positions;
+}
+
+void runMicro() {
+    std::cerr << "[micro]" << std::endl;
+    std::vector<Game> positions = randomPositions(1);
+
+    // Orden de las 9 casillas de cada partida (permutaciones aleatorias)
+    std::uint64_t rng = mixSeed(2, 0);
+    std::vector<unsigned char> orders(POSITIONS * 9);
+    for (int p = 0; p < POSITIONS; p++) {
+        unsigned char* order = &orders[p * 9];
+        for (int i = 0; i < 9; i++) order[i] = static_cast<unsigned char>(i);
+        for (int i = 8; i > 0; i--) std::swap(order[i], order[nextRandom(rng) % (i + 1)]);
+    }
+
+    // Tablero lleno por partida: 9 jugadas con su cambio de turno y un
+    // resetGame cada 9 jugadas
+    Game game;
+    measure("micro", "game/makeMove", POSITIONS * 9, [&](long long iterations) {
+        std::uint64_t sum = 0;
+        for (long long it = 0; it < iterations; it++) {
+            for (int p = 0; p < POSITIONS; p++) {
+                game.resetGame();
+                const unsigned char* order = &orders[p * 9];
+                for (int i = 0; i < 9; i++) {
+                    sum += game.makeMove(order[i] / 3, order[i] % 3);
+                    game.switchPlayer();
+                }
+            }
+        }
+        return sum;
+    });
+
+    measure("micro", "game/checkWinner", POSITIONS, [&](long long iterations) {
+        std::uint64_t sum = 0;
+        for (long long it = 0; it < iterations; it++) {
+            for (auto& position : positions) sum += position.checkWinner();
+        }
+        return sum;
+    });
+
+    measure("micro", "game/isBoardFull", POSITIONS, [&](long long iterations) {
+        std::uint64_t sum = 0;
+        for (long long it = 0; it < iterations; it++) {
+            for (const auto& position : positions) sum += position.isBoardFull();
+        }
+        return sum;
+    });
+
+    measure("micro", "game/copyConstructor", POSITIONS, [&](long long iterations) {
+        std::uint64_t sum = 0;
+        for (long long it = 0; it < iterations; it++) {
+            for (const auto& position : positions) {
+                Game copy(position);
+                sum += copy.getHash();
+            }
+        }
+        return sum;
+    });
+
+    Game target;
+    measure("micro", "game/copyAssignment", POSITIONS, [&](long long iterations) {
+        std::uint64_t sum = 0;
+        for (long long it = 0; it < iterations; it++) {
+            for (const auto& position : positions) {
+                target = position;
+                sum += target.getHash();
+            }
+        }
+        return sum;
+    });
+}
+
+void runGames() {
+    std::cerr << "[juego]" << std::endl;
+    const int GAMES = 1024;
+
+    Game game;
+    std::uint64_t rng = mixSeed(3, 0);
+    measure("juego", "game/randomGame3x3", GAMES, [&](long long iterations) {
+        std::uint64_t moves = 0;
+        for (long long it = 0; it < iterations * GAMES; it++) moves += playRandomGame(game, rng);
+        return moves;
+    });
+
+    Game4x4 game4;
+    measure("juego", "game/randomGame4x4", GAMES, [&](long long iterations) {
+        std::uint64_t moves = 0;
+        for (long long it = 0; it < iterations * GAMES; it++) moves += playRandomGame(game4, rng);
+        return moves;
+    });
+}
+
+// Llena 'directory' con 'count' partidas aleatorias distintas en tandas
+void fillDirectory(FileManager& fileManager, long long count) {
+    std::uint64_t rng = mixSeed(4, static_cast<std::uint64_t>(count));
+    std::vector<std::string> names;
+    std::vector<std::vector<char>> contents;
+    std::vector<bool> written;
+    Game game;
+    for (long long i = 0; i < count; i++) {
+        playRandomGame(game, rng);
+        names.push_back("p" + std::to_string(i) + ".triki");
+        contents.push_back(game.serialize());
+        if (names.size() == WRITE_BATCH || i + 1 == count) {
+            fileManager.writeSaveFiles(names, contents, {}, written);
+            names.clear();
+            contents.clear();
+        }
+    }
+}
+
+void runIo(long long maxSaves) {
+    std::cerr << "[io]" << std::endl;
+
+    // saveGame y loadGame usan el directorio "saves" del directorio actual
+    Game game;
+    std::uint64_t rng = mixSeed(5, 0);
+    playRandomGame(game, rng);
+    measure("io", "game/saveGame", 1, [&](long long iterations) {
+        std::uint64_t ok = 0;
+        for (long long it = 0; it < iterations; it++) ok += game.saveGame("bench");
+        return ok;
+    });
+    Game loaded;
+    measure("io", "game/loadGame", 1, [&](long long iterations) {
+        std::uint64_t ok = 0;
+        for (long long it = 0; it < iterations; it++) ok += loaded.loadGame("bench");
+        return ok;
+    });
+
+    for (long long saves = 100; saves <= maxSaves; saves *= 10) {
+        std::string directory = "corpus-" + std::to_string(saves);
+        FileManager fileManager(directory);
+        auto start = Clock::now();
+        fillDirectory(fileManager, saves);
+        std::cerr << "  (" << saves << " partidas escritas en "
+                  << std::chrono::duration<double>(Clock::now() - start).count() << " s)" << std::endl;
+
+        measure("io", "fileManager/listSavedGames", 1, [&](long long iterations) {
+            std::uint64_t count = 0;
+            for (long long it = 0; it < iterations; it++) count += fileManager.listSavedGames().size();
+            return count;
+        }, saves);
+
+        // Borra el 10% mas antiguo
+        fileManager.setMaxSavedFiles(static_cast<int>(saves - saves / 10));
+        measureOnce("io", "fileManager/cleanOldSaves", saves, [&]() { fileManager.cleanOldSaves(); });
+    }
+}
+
+std::string isoTimestamp() {
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+void writeJson(std::ostream& out, long long maxSaves) {
+    out << "{\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"timestamp\": \"" << isoTimestamp() << "\",\n";
+    out << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#ifdef NDEBUG
+    out << "  \"assertions\": false,\n";
+#else
+    out << "  \"assertions\": true,\n";
+#endif
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"max_saves\": " << maxSaves << ",\n";
+    out << "  \"checksum\": " << checksum << ",\n";
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << (i ? ",\n    " : "\n    ") << "{\"group\": \"" << r.group << "\", \"name\": \"" << r.name << "\"";
+        if (r.saves) out << ", \"saves\": " << r.saves;
+        out << ", \"ns_per_op\": " << r.nsPerOp << ", \"min_ns\": " << r.minNs << ", \"max_ns\": " << r.maxNs
+            << ", \"ops_per_second\": " << (r.nsPerOp > 0.0 ? 1e9 / r.nsPerOp : 0.0)
+            << ", \"operations\": " << r.operations << ", \"repetitions\": " << r.repetitions << "}";
+    }
+    out << (results.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string output;
+    std::string group;
+    std::string directory;
+    long long maxSaves = 1000000;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--salida") {
+            output = argv[++i];
+        } else if (i + 1 < argc && arg == "--grupo") {
+            group = argv[++i];
+        } else if (i + 1 < argc && arg == "--max-partidas") {
+            maxSaves = std::atoll(argv[++i]);
+        } else if (i + 1 < argc && arg == "--dir") {
+            directory = argv[++i];
+        } else {
+            std::cerr << "Uso: triki_bench [--salida archivo.json] [--grupo micro|io|juego] "
+                         "[--max-partidas N] [--dir directorio]" << std::endl;
+            return 2;
+        }
+    }
+    if (!group.empty() && group != "micro" && group != "io" && group != "juego") {
+        std::cerr << "[ERROR] Grupo desconocido: " << group << std::endl;
+        return 2;
+    }
+
+    // El registro de cada guardado no debe medirse ni mezclarse con el JSON
+    Logger::setLevel(LOG_ERROR);
+
+    // Directorio de trabajo propio: saveGame escribe en "saves" relativo a el
+    const std::string previous = std::filesystem::current_path().string();
+    bool temporary = directory.empty();
+    if (temporary) {
+        char pattern[] = "/tmp/triki-bench-XXXXXX";
+        if (!mkdtemp(pattern)) {
+            std::cerr << "[ERROR] No se pudo crear el directorio temporal" << std::endl;
+            return 1;
+        }
+        directory = pattern;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::filesystem::current_path(directory, error);
+    if (error) {
+        std::cerr << "[ERROR] No se pudo usar " << directory << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    if (group.empty() || group == "micro") runMicro();
+    if (group.empty() || group == "juego") runGames();
+    if (group.empty() || group == "io") runIo(maxSaves);
+
+    std::filesystem::current_path(previous, error);
+    if (temporary) {
+        std::filesystem::remove_all(directory, error);
+    }
+
+    Logger::flush();
+    if (output.empty()) {
+        writeJson(std::cout, maxSaves);
+    } else {
+        std::ofstream file(output);
+        writeJson(file, maxSaves);
+        if (!file) {
+            std::cerr << "[ERROR] No se pudo escribir " << output << std::endl;
+            return 1;
+        }
+        std::cerr << "Resultados en " << output << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,374 @@
+#include "Analytics.h"
+#include "FileManager.h"
+#include "Logger.h"
+#include "SaveFormat.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const std::uint32_t SLOTS_PER_TASK = 4096;  // Tramo del almacen que toma un hilo cada vez
+const int MAX_CELLS = 256;
+
+// Lo que interesa de una partida, leido directo de los bytes
+struct SaveSummary {
+    int rows, cols, k;
+    int moves;
+    bool ended;
+    char winner;
+    bool legacy;
+    char cells[MAX_CELLS];  // '.', 'X' u 'O'
+};
+
+bool parseSave(const unsigned char* in, std::size_t size, SaveSummary& out) {
+    if (size >= static_cast<std::size_t>(SAVE_HEADER_BYTES + SAVE_CHECKSUM_BYTES) &&
+        std::memcmp(in, SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0) {
+        int count = static_cast<int>(readLittleEndian(in + 12, 2));
+        int cellCount = in[5] * in[6];
+        if (in[4] != SAVE_VERSION || cellCount == 0 || cellCount > MAX_CELLS || count > cellCount ||
+            size != static_cast<std::size_t>(SAVE_HEADER_BYTES + count + SAVE_CHECKSUM_BYTES)) {
+            return false;
+        }
+        std::size_t crcOffset = SAVE_HEADER_BYTES + count;
+        if (crc32(in, crcOffset) != readLittleEndian(in + crcOffset, SAVE_CHECKSUM_BYTES)) {
+            return false;
+        }
+        out.rows = in[5];
+        out.cols = in[6];
+        out.k = in[7];
+        out.moves = count;
+        out.ended = in[9] != 0;
+        out.winner = static_cast<char>(in[10]);
+        out.legacy = false;
+        std::memset(out.cells, '.', cellCount);
+        // X mueve primero y los turnos alternan
+        for (int i = 0; i < count; i++) {
+            int cell = in[SAVE_HEADER_BYTES + i];
+            if (cell >= cellCount || out.cells[cell] != '.') {
+                return false;
+            }
+            out.cells[cell] = (i % 2 == 0) ? 'X' : 'O';
+        }
+        return true;
+    }
+    if (size == 12) {
+        // Version 1 (solo 3x3): casillas sueltas, jugador, terminado, ganador
+        out.rows = out.cols = out.k = 3;
+        out.moves = 0;
+        for (int i = 0; i < 9; i++) {
+            char cell = static_cast<char>(in[i]);
+            if (cell == 'X' || cell == 'O') {
+                out.cells[i] = cell;
+                out.moves++;
+            } else if (cell == ' ') {
+                out.cells[i] = '.';
+            } else {
+                return false;
+            }
+        }
+        out.ended = in[10] != 0;
+        out.winner = static_cast<char>(in[11]);
+        out.legacy = true;
+        return true;
+    }
+    return false;
+}
+
+// Totales de un hilo
+struct Partial {
+    long long files = 0;
+    long long valid = 0;
+    long long corrupt = 0;
+    long long legacy = 0;
+    long long xWins = 0;
+    long long oWins = 0;
+    long long draws = 0;
+    long long unfinished = 0;
+    long long early = 0;
+    long long bytes = 0;
+    std::vector<std::string> earlyExamples;
+    std::vector<long long> histogram = std::vector<long long>(MAX_CELLS + 1, 0);
+    std::unordered_map<std::string, long long> positions;
+};
+
+void account(Partial& partial, const AnalyticsConfig& config, const SaveBlobs& blobs, const char* name,
+             std::size_t nameLength, const unsigned char* data, std::size_t size) {
+    partial.files++;
+    partial.bytes += static_cast<long long>(size);
+
+    // Guardado por contenido: se analiza la posicion a la que apunta
+    std::uint64_t positionKey;
+    std::uint32_t variant;
+    std::vector<char> shared;
+    if (SaveBlobs::parseReference(data, size, positionKey, variant)) {
+        if (!blobs.read(positionKey, variant, shared)) {
+            partial.corrupt++;
+            return;
+        }
+        data = reinterpret_cast<const unsigned char*>(shared.data());
+        size = shared.size();
+    }
+
+    SaveSummary save;
+    if (!parseSave(data, size, save)) {
+        partial.corrupt++;
+        return;
+    }
+    partial.valid++;
+    if (save.legacy) partial.legacy++;
+    if (!save.ended) {
+        partial.unfinished++;
+        return;
+    }
+
+    if (save.winner == 'X') {
+        partial.xWins++;
+    } else if (save.winner == 'O') {
+        partial.oWins++;
+    } else {
+        partial.draws++;
+    }
+    partial.histogram[save.moves]++;
+
+    int earlyLimit = config.earlyMoves > 0 ? config.earlyMoves : 2 * save.k - 1;
+    if (save.winner != ' ' && save.moves <= earlyLimit) {
+        partial.early++;
+        // Se guardan los N nombres menores (monticulo de maximos): el
+        // resultado no depende de como se repartieron los hilos
+        auto& examples = partial.earlyExamples;
+        if (config.earlySamples > 0) {
+            examples.emplace_back(name, nameLength);
+            std::push_heap(examples.begin(), examples.end());
+            if (examples.size() > config.earlySamples) {
+                std::pop_heap(examples.begin(), examples.end());
+                examples.pop_back();
+            }
+        }
+    }
+
+    std::string key = std::to_string(save.rows) + "x" + std::to_string(save.cols) + ":";
+    key.append(save.cells, save.rows * save.cols);
+    partial.positions[key]++;
+}
+
+// Un .triki suelto, leido con mmap
+void accountFile(Partial& partial, const AnalyticsConfig& config, const SaveBlobs& blobs,
+                 const std::string& directory, const std::string& name) {
+    std::string path = directory + "/" + name;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0) {
+        if (fd >= 0) ::close(fd);
+        partial.files++;
+        partial.corrupt++;
+        return;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        partial.files++;
+        partial.corrupt++;
+        return;
+    }
+    account(partial, config, blobs, name.data(), name.size(), static_cast<const unsigned char*>(map), size);
+    munmap(map, size);
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        escaped += c;
+    }
+    return escaped;
+}
+
+double rate(long long part, long long total) {
+    return total > 0 ? static_cast<double>(part) / total : 0.0;
+}
+
+}
+
+bool runAnalytics(const AnalyticsConfig& config, AnalyticsReport& report) {
+    report = AnalyticsReport();
+    std::error_code error;
+    if (!std::filesystem::is_directory(config.directory, error)) {
+        TRIKI_ERROR(LOG_IO, "No existe el directorio de partidas: " << config.directory);
+        return false;
+    }
+    FileManager fileManager(config.directory);
+    std::shared_ptr<SaveStore> store = fileManager.getStore();
+    std::vector<std::string> looseFiles;
+    if (!store) {
+        looseFiles = fileManager.listSavedGames();
+    }
+    report.packed = store != nullptr;
+    std::shared_ptr<SaveBlobs> blobs = SaveBlobs::open(config.directory);
+
+    const int threads = std::max(1, config.threads);
+    std::vector<Partial> partials(threads);
+    std::atomic<std::uint32_t> nextTask{0};
+    // Ningun proceso escribe en el almacen mientras se recorre
+    std::unique_ptr<SaveStore::ScanGuard> scan;
+    if (store) {
+        scan.reset(new SaveStore::ScanGuard(*store));
+        if (!scan->isValid()) {
+            TRIKI_ERROR(LOG_IO, "No se pudo leer el almacen de " << config.directory);
+            return false;
+        }
+    }
+    const std::uint32_t slotCount = scan ? scan->getSlotCount() : 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto worker = [&](int id) {
+        Partial& partial = partials[id];
+        if (store) {
+            // Tramos del almacen repartidos a pedido: ningun hilo queda ocioso
+            while (true) {
+                std::uint32_t begin = nextTask.fetch_add(SLOTS_PER_TASK, std::memory_order_relaxed);
+                if (begin >= slotCount) break;
+                store->visitSlots(begin, begin + SLOTS_PER_TASK,
+                    [&](const char* name, std::size_t nameLength, const unsigned char* data, std::size_t size) {
+                        account(partial, config, *blobs, name, nameLength, data, size);
+                    });
+            }
+        } else {
+            while (true) {
+                std::uint32_t index = nextTask.fetch_add(1, std::memory_order_relaxed);
+                if (index >= looseFiles.size()) break;
+                accountFile(partial, config, *blobs, config.directory, looseFiles[index]);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // Suma de los resultados parciales
+    std::unordered_map<std::string, long long> positions;
+    report.movesHistogram.assign(MAX_CELLS + 1, 0);
+    for (auto& partial : partials) {
+        report.files += partial.files;
+        report.valid += partial.valid;
+        report.corrupt += partial.corrupt;
+        report.legacyV1 += partial.legacy;
+        report.firstPlayerWins += partial.xWins;
+        report.secondPlayerWins += partial.oWins;
+        report.draws += partial.draws;
+        report.unfinished += partial.unfinished;
+        report.earlyWins += partial.early;
+        report.bytes += partial.bytes;
+        for (int i = 0; i <= MAX_CELLS; i++) {
+            report.movesHistogram[i] += partial.histogram[i];
+        }
+        report.earlyExamples.insert(report.earlyExamples.end(),
+                                    partial.earlyExamples.begin(), partial.earlyExamples.end());
+        if (positions.empty()) {
+            positions.swap(partial.positions);
+        } else {
+            for (const auto& entry : partial.positions) positions[entry.first] += entry.second;
+        }
+    }
+    while (report.movesHistogram.size() > 1 && report.movesHistogram.back() == 0) {
+        report.movesHistogram.pop_back();
+    }
+    std::sort(report.earlyExamples.begin(), report.earlyExamples.end());
+    if (report.earlyExamples.size() > config.earlySamples) {
+        report.earlyExamples.resize(config.earlySamples);
+    }
+
+    // Solo se ordenan las primeras N posiciones
+    std::vector<std::pair<std::string, long long>> ranked(positions.begin(), positions.end());
+    std::size_t top = std::min(config.topPositions, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + top, ranked.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    ranked.resize(top);
+    report.topFinalPositions = std::move(ranked);
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void writeAnalyticsJson(const AnalyticsReport& report, std::ostream& out) {
+    long long finished = report.finished();
+    out << "{\n";
+    out << "  \"files\": " << report.files << ",\n";
+    out << "  \"valid\": " << report.valid << ",\n";
+    out << "  \"corrupt\": " << report.corrupt << ",\n";
+    out << "  \"legacy_v1\": " << report.legacyV1 << ",\n";
+    out << "  \"finished\": " << finished << ",\n";
+    out << "  \"unfinished\": " << report.unfinished << ",\n";
+    out << "  \"first_player_wins\": " << report.firstPlayerWins << ",\n";
+    out << "  \"second_player_wins\": " << report.secondPlayerWins << ",\n";
+    out << "  \"draws\": " << report.draws << ",\n";
+    out << "  \"first_player_win_rate\": " << rate(report.firstPlayerWins, finished) << ",\n";
+    out << "  \"second_player_win_rate\": " << rate(report.secondPlayerWins, finished) << ",\n";
+    out << "  \"draw_rate\": " << rate(report.draws, finished) << ",\n";
+    out << "  \"early_wins\": " << report.earlyWins << ",\n";
+    out << "  \"early_examples\": [";
+    for (std::size_t i = 0; i < report.earlyExamples.size(); i++) {
+        out << (i ? ", " : "") << '"' << escapeJson(report.earlyExamples[i]) << '"';
+    }
+    out << "],\n";
+    out << "  \"moves_histogram\": [";
+    for (std::size_t i = 0; i < report.movesHistogram.size(); i++) {
+        out << (i ? ", " : "") << report.movesHistogram[i];
+    }
+    out << "],\n";
+    out << "  \"top_final_positions\": [";
+    for (std::size_t i = 0; i < report.topFinalPositions.size(); i++) {
+        out << (i ? ",\n    " : "\n    ") << "{\"position\": \"" << report.topFinalPositions[i].first
+            << "\", \"count\": " << report.topFinalPositions[i].second << "}";
+    }
+    out << (report.topFinalPositions.empty() ? "],\n" : "\n  ],\n");
+    out << "  \"bytes\": " << report.bytes << ",\n";
+    out << "  \"seconds\": " << report.seconds << ",\n";
+    out << "  \"files_per_second\": " << report.filesPerSecond() << "\n";
+    out << "}\n";
+}
+
+void writeAnalyticsCsv(const AnalyticsReport& report, std::ostream& out) {
+    long long finished = report.finished();
+    out << "metrica,valor\n";
+    out << "files," << report.files << "\n";
+    out << "valid," << report.valid << "\n";
+    out << "corrupt," << report.corrupt << "\n";
+    out << "legacy_v1," << report.legacyV1 << "\n";
+    out << "finished," << finished << "\n";
+    out << "unfinished," << report.unfinished << "\n";
+    out << "first_player_wins," << report.firstPlayerWins << "\n";
+    out << "second_player_wins," << report.secondPlayerWins << "\n";
+    out << "draws," << report.draws << "\n";
+    out << "first_player_win_rate," << rate(report.firstPlayerWins, finished) << "\n";
+    out << "second_player_win_rate," << rate(report.secondPlayerWins, finished) << "\n";
+    out << "draw_rate," << rate(report.draws, finished) << "\n";
+    out << "early_wins," << report.earlyWins << "\n";
+    for (std::size_t i = 0; i < report.movesHistogram.size(); i++) {
+        if (report.movesHistogram[i] > 0) out << "moves_" << i << "," << report.movesHistogram[i] << "\n";
+    }
+    for (const auto& position : report.topFinalPositions) {
+        out << "position_" << position.first << "," << position.second << "\n";
+    }
+    out << "bytes," << report.bytes << "\n";
+    out << "seconds," << report.seconds << "\n";
+    out << "files_per_second," << report.filesPerSecond() << "\n";
+}
@@ -0,0 +1,52 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ESTADISTICAS SOBRE TODAS LAS PARTIDAS GUARDADAS
+// Recorre el directorio de un FileManager con varios hilos y lee cada
+// partida directamente de memoria: las casillas del almacen empaquetado
+// (partidas.dat ya proyectado con mmap) o cada .triki suelto con su propio
+// mmap. Los registros se interpretan sin construir un Game (formato v2 con
+// su CRC, y v1); las referencias del guardado por contenido se cambian por
+// su posicion. Cada hilo acumula sus propios totales y al final se suman.
+struct AnalyticsConfig {
+    std::string directory = "saves";
+    int threads = 1;
+    int earlyMoves = 0;          // Victorias en a lo sumo estas jugadas; 0 = 2k-1 (la mas corta posible)
+    std::size_t topPositions = 10;
+    std::size_t earlySamples = 10;  // Nombres de ejemplo de partidas cortas
+};
+
+struct AnalyticsReport {
+    long long files = 0;
+    long long valid = 0;
+    long long corrupt = 0;       // CRC malo, tamaño inesperado o jugadas imposibles
+    long long legacyV1 = 0;
+    long long firstPlayerWins = 0;   // X mueve primero
+    long long secondPlayerWins = 0;
+    long long draws = 0;
+    long long unfinished = 0;
+    long long earlyWins = 0;
+    std::vector<std::string> earlyExamples;
+    std::vector<long long> movesHistogram;  // Partidas terminadas por numero de jugadas
+    std::vector<std::pair<std::string, long long>> topFinalPositions;  // "3x3:XO.X.O..X"
+    long long bytes = 0;
+    double seconds = 0.0;
+    bool packed = false;
+
+    long long finished() const { return firstPlayerWins + secondPlayerWins + draws; }
+    double filesPerSecond() const { return seconds > 0.0 ? files / seconds : 0.0; }
+};
+
+// false si el directorio no existe
+bool runAnalytics(const AnalyticsConfig& config, AnalyticsReport& report);
+
+void writeAnalyticsJson(const AnalyticsReport& report, std::ostream& out);
+void writeAnalyticsCsv(const AnalyticsReport& report, std::ostream& out);  // metrica,valor
+
+#endif
@@ -0,0 +1,323 @@
+#include "BatchEval.h"
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TRIKI_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define TRIKI_BATCH_X86 0
+#endif
+
+namespace {
+
+// Mascaras de las lineas ganadoras en el ancho de cada lote
+template <typename Lane, int Rows, int Cols, int K>
+std::array<Lane, Board<Rows, Cols, K>::NUM_LINES> lineLanes() {
+    std::array<Lane, Board<Rows, Cols, K>::NUM_LINES> lines{};
+    for (int l = 0; l < Board<Rows, Cols, K>::NUM_LINES; l++) {
+        lines[l] = static_cast<Lane>(Board<Rows, Cols, K>::TABLES.lineMasks[l].words[0]);
+    }
+    return lines;
+}
+
+// Referencia sin SIMD: un tablero por vuelta
+template <typename Lane, int Lines>
+void evaluateScalar(const Lane* x, const Lane* o, Lane* status, Lane* legal, int n, const Lane* lines, Lane full) {
+    for (int i = 0; i < n; i++) {
+        bool xWins = false;
+        bool oWins = false;
+        for (int l = 0; l < Lines; l++) {
+            xWins |= (x[i] & lines[l]) == lines[l];
+            oWins |= (o[i] & lines[l]) == lines[l];
+        }
+        Lane occupied = static_cast<Lane>(x[i] | o[i]);
+        if (xWins || oWins) {
+            status[i] = xWins ? BATCH_X_WINS : BATCH_O_WINS;
+            legal[i] = 0;
+        } else {
+            status[i] = occupied == full ? BATCH_DRAW : BATCH_PLAYING;
+            legal[i] = static_cast<Lane>(full & ~occupied);
+        }
+    }
+}
+
+}
+
+#if TRIKI_BATCH_X86
+
+// Cada conjunto de instrucciones se compila aparte con su propio 'target',
+// sin banderas globales: solo se ejecuta si la CPU lo tiene (bestBatchIsa).
+// El cuerpo es el mismo en los tres; las comparaciones dejan todos los bits
+// en 1 donde hay igualdad, asi el estado sale con AND/OR sin saltos.
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2 {
+
+struct Ops16 {
+    using Vec = __m128i;
+    static const int LANES = 8;
+    static Vec load(const std::uint16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::uint16_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static Vec set1(std::uint16_t v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+struct Ops32 {
+    using Vec = __m128i;
+    static const int LANES = 4;
+    static Vec load(const std::uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::uint32_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static Vec set1(std::uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+template <typename Ops, int Lines, typename Lane>
+void evaluate(const Lane* x, const Lane* o, Lane* status, Lane* legal, int n, const Lane* lines, Lane full) {
+    using Vec = typename Ops::Vec;
+    const Vec fullVec = Ops::set1(full);
+    const Vec one = Ops::set1(BATCH_X_WINS), two = Ops::set1(BATCH_O_WINS), three = Ops::set1(BATCH_DRAW);
+    for (int i = 0; i < n; i += Ops::LANES) {
+        Vec xv = Ops::load(x + i);
+        Vec ov = Ops::load(o + i);
+        Vec xWins = _mm_setzero_si128();
+        Vec oWins = _mm_setzero_si128();
+        for (int l = 0; l < Lines; l++) {
+            Vec line = Ops::set1(lines[l]);
+            xWins = _mm_or_si128(xWins, Ops::equal(_mm_and_si128(xv, line), line));
+            oWins = _mm_or_si128(oWins, Ops::equal(_mm_and_si128(ov, line), line));
+        }
+        Vec occupied = _mm_or_si128(xv, ov);
+        Vec ended = _mm_or_si128(xWins, oWins);
+        Vec draw = _mm_andnot_si128(ended, Ops::equal(occupied, fullVec));
+        Vec result = _mm_or_si128(_mm_and_si128(xWins, one),
+                     _mm_or_si128(_mm_and_si128(_mm_andnot_si128(xWins, oWins), two), _mm_and_si128(draw, three)));
+        Ops::store(status + i, result);
+        Ops::store(legal + i, _mm_andnot_si128(ended, _mm_andnot_si128(occupied, fullVec)));
+    }
+}
+
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+
+struct Ops16 {
+    using Vec = __m256i;
+    static const int LANES = 16;
+    static Vec load(const std::uint16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(std::uint16_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec set1(std::uint16_t v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm256_cmpeq_epi16(a, b); }
+};
+
+struct Ops32 {
+    using Vec = __m256i;
+    static const int LANES = 8;
+    static Vec load(const std::uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(std::uint32_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec set1(std::uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm256_cmpeq_epi32(a, b); }
+};
+
+template <typename Ops, int Lines, typename Lane>
+void evaluate(const Lane* x, const Lane* o, Lane* status, Lane* legal, int n, const Lane* lines, Lane full) {
+    using Vec = typename Ops::Vec;
+    const Vec fullVec = Ops::set1(full);
+    const Vec one = Ops::set1(BATCH_X_WINS), two = Ops::set1(BATCH_O_WINS), three = Ops::set1(BATCH_DRAW);
+    for (int i = 0; i < n; i += Ops::LANES) {
+        Vec xv = Ops::load(x + i);
+        Vec ov = Ops::load(o + i);
+        Vec xWins = _mm256_setzero_si256();
+        Vec oWins = _mm256_setzero_si256();
+        for (int l = 0; l < Lines; l++) {
+            Vec line = Ops::set1(lines[l]);
+            xWins = _mm256_or_si256(xWins, Ops::equal(_mm256_and_si256(xv, line), line));
+            oWins = _mm256_or_si256(oWins, Ops::equal(_mm256_and_si256(ov, line), line));
+        }
+        Vec occupied = _mm256_or_si256(xv, ov);
+        Vec ended = _mm256_or_si256(xWins, oWins);
+        Vec draw = _mm256_andnot_si256(ended, Ops::equal(occupied, fullVec));
+        Vec result = _mm256_or_si256(_mm256_and_si256(xWins, one),
+                     _mm256_or_si256(_mm256_and_si256(_mm256_andnot_si256(xWins, oWins), two),
+                                     _mm256_and_si256(draw, three)));
+        Ops::store(status + i, result);
+        Ops::store(legal + i, _mm256_andnot_si256(ended, _mm256_andnot_si256(occupied, fullVec)));
+    }
+}
+
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+namespace avx512 {
+
+// Las comparaciones de AVX-512 devuelven una mascara de bits; se vuelve a
+// expandir a un vector para usar el mismo cuerpo que los demas
+struct Ops16 {
+    using Vec = __m512i;
+    static const int LANES = 32;
+    static Vec load(const std::uint16_t* p) { return _mm512_loadu_si512(p); }
+    static void store(std::uint16_t* p, Vec v) { _mm512_storeu_si512(p, v); }
+    static Vec set1(std::uint16_t v) { return _mm512_set1_epi16(static_cast<short>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm512_maskz_set1_epi16(_mm512_cmpeq_epi16_mask(a, b), -1); }
+};
+
+struct Ops32 {
+    using Vec = __m512i;
+    static const int LANES = 16;
+    static Vec load(const std::uint32_t* p) { return _mm512_loadu_si512(p); }
+    static void store(std::uint32_t* p, Vec v) { _mm512_storeu_si512(p, v); }
+    static Vec set1(std::uint32_t v) { return _mm512_set1_epi32(static_cast<int>(v)); }
+    static Vec equal(Vec a, Vec b) { return _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(a, b), -1); }
+};
+
+// ~a & b sin _mm512_andnot_si512, que en GCC 12 avisa de un valor sin
+// inicializar dentro del propio intrinseco; el compilador lo junta igual
+inline __m512i andNot(__m512i a, __m512i b) {
+    return _mm512_and_si512(_mm512_xor_si512(a, _mm512_set1_epi32(-1)), b);
+}
+
+template <typename Ops, int Lines, typename Lane>
+void evaluate(const Lane* x, const Lane* o, Lane* status, Lane* legal, int n, const Lane* lines, Lane full) {
+    using Vec = typename Ops::Vec;
+    const Vec fullVec = Ops::set1(full);
+    const Vec one = Ops::set1(BATCH_X_WINS), two = Ops::set1(BATCH_O_WINS), three = Ops::set1(BATCH_DRAW);
+    for (int i = 0; i < n; i += Ops::LANES) {
+        Vec xv = Ops::load(x + i);
+        Vec ov = Ops::load(o + i);
+        Vec xWins = _mm512_setzero_si512();
+        Vec oWins = _mm512_setzero_si512();
+        for (int l = 0; l < Lines; l++) {
+            Vec line = Ops::set1(lines[l]);
+            xWins = _mm512_or_si512(xWins, Ops::equal(_mm512_and_si512(xv, line), line));
+            oWins = _mm512_or_si512(oWins, Ops::equal(_mm512_and_si512(ov, line), line));
+        }
+        Vec occupied = _mm512_or_si512(xv, ov);
+        Vec ended = _mm512_or_si512(xWins, oWins);
+        Vec draw = andNot(ended, Ops::equal(occupied, fullVec));
+        Vec result = _mm512_or_si512(_mm512_and_si512(xWins, one),
+                     _mm512_or_si512(_mm512_and_si512(andNot(xWins, oWins), two),
+                                     _mm512_and_si512(draw, three)));
+        Ops::store(status + i, result);
+        Ops::store(legal + i, andNot(ended, andNot(occupied, fullVec)));
+    }
+}
+
+}
+#pragma GCC pop_options
+
+#endif
+
+BatchIsa bestBatchIsa() {
+    static const BatchIsa best = []() {
+#if TRIKI_BATCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return BATCH_AVX512;
+        if (__builtin_cpu_supports("avx2")) return BATCH_AVX2;
+        if (__builtin_cpu_supports("sse2")) return BATCH_SSE2;
+#endif
+        return BATCH_SCALAR;
+    }();
+    return best;
+}
+
+bool isBatchIsaSupported(BatchIsa isa) {
+    return isa <= bestBatchIsa();
+}
+
+const char* batchIsaName(BatchIsa isa) {
+    switch (isa) {
+        case BATCH_SSE2: return "sse2";
+        case BATCH_AVX2: return "avx2";
+        case BATCH_AVX512: return "avx512";
+        default: return "escalar";
+    }
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::clear() {
+    count = 0;
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::reserve(int boards) {
+    std::size_t padded = static_cast<std::size_t>((boards + PADDING - 1) / PADDING * PADDING);
+    xBits.reserve(padded);
+    oBits.reserve(padded);
+    status.reserve(padded);
+    legal.reserve(padded);
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::grow() {
+    std::size_t size = xBits.size() + PADDING;
+    xBits.resize(size, 0);
+    oBits.resize(size, 0);
+    status.resize(size, 0);
+    legal.resize(size, 0);
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::add(Lane x, Lane o) {
+    if (static_cast<std::size_t>(count) == xBits.size()) {
+        grow();
+    }
+    xBits[count] = x;
+    oBits[count] = o;
+    count++;
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::add(const BoardType& board) {
+    add(static_cast<Lane>(board.bits(0).words[0]), static_cast<Lane>(board.bits(1).words[0]));
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::evaluate() {
+    evaluate(bestBatchIsa());
+}
+
+template <int Rows, int Cols, int K>
+void BoardBatch<Rows, Cols, K>::evaluate(BatchIsa isa) {
+    constexpr int LINES = BoardType::NUM_LINES;
+    static const auto lines = lineLanes<Lane, Rows, Cols, K>();
+    const Lane full = static_cast<Lane>(BoardType::TABLES.fullMask.words[0]);
+    // Tambien los tableros de relleno del ultimo bloque: ningun resto
+    const int n = (count + PADDING - 1) / PADDING * PADDING;
+    if (!isBatchIsaSupported(isa)) {
+        isa = bestBatchIsa();
+    }
+
+#if TRIKI_BATCH_X86
+    constexpr bool narrow = sizeof(Lane) == 2;
+    using Sse2 = typename std::conditional<narrow, sse2::Ops16, sse2::Ops32>::type;
+    using Avx2 = typename std::conditional<narrow, avx2::Ops16, avx2::Ops32>::type;
+    using Avx512 = typename std::conditional<narrow, avx512::Ops16, avx512::Ops32>::type;
+    switch (isa) {
+        case BATCH_AVX512:
+            avx512::evaluate<Avx512, LINES>(xBits.data(), oBits.data(), status.data(), legal.data(), n,
+                                            lines.data(), full);
+            return;
+        case BATCH_AVX2:
+            avx2::evaluate<Avx2, LINES>(xBits.data(), oBits.data(), status.data(), legal.data(), n,
+                                        lines.data(), full);
+            return;
+        case BATCH_SSE2:
+            sse2::evaluate<Sse2, LINES>(xBits.data(), oBits.data(), status.data(), legal.data(), n,
+                                        lines.data(), full);
+            return;
+        default:
+            break;
+    }
+#endif
+    evaluateScalar<Lane, LINES>(xBits.data(), oBits.data(), status.data(), legal.data(), n, lines.data(), full);
+}
+
+// INSTANCIACION EXPLICITA - las variantes de Game que caben en 32 bits
+template class BoardBatch<3, 3, 3>;
+template class BoardBatch<4, 4, 4>;
+template class BoardBatch<5, 5, 4>;
@@ -0,0 +1,74 @@
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "Board.h"
+
+// EVALUACION DE TABLEROS POR LOTES (SIMD)
+// Muchos tableros independientes guardados como estructura de arreglos: una
+// mascara de fichas de X y otra de O por tablero, de 16 bits hasta 16
+// casillas (3x3, 4x4) y de 32 bits hasta 32 (5x5). evaluate() calcula para
+// todos a la vez el estado (en juego, gana X, gana O o empate) y las
+// casillas libres donde se puede jugar, comparando contra cada linea
+// ganadora con instrucciones vectoriales:
+//   SSE2     8 tableros de 16 bits (4 de 32) por instruccion
+//   AVX2    16 tableros de 16 bits (8 de 32)
+//   AVX-512 32 tableros de 16 bits (16 de 32), con AVX512BW
+// El conjunto de instrucciones se elige al ejecutar segun la CPU; el mismo
+// binario corre en cualquier x86-64 (y sin SIMD fuera de x86).
+//
+// Mismo resultado que Game: si los dos jugadores tienen linea gana X (el
+// primero que revisa checkWinner), el empate es tablero lleno sin linea y
+// una partida terminada no tiene jugadas legales.
+enum BatchIsa { BATCH_SCALAR = 0, BATCH_SSE2, BATCH_AVX2, BATCH_AVX512 };
+
+enum BatchStatus { BATCH_PLAYING = 0, BATCH_X_WINS = 1, BATCH_O_WINS = 2, BATCH_DRAW = 3 };
+
+// El mejor conjunto disponible en esta CPU (se revisa una sola vez)
+BatchIsa bestBatchIsa();
+bool isBatchIsaSupported(BatchIsa isa);
+const char* batchIsaName(BatchIsa isa);
+
+template <int Rows, int Cols, int K>
+class BoardBatch {
+public:
+    using BoardType = Board<Rows, Cols, K>;
+    static constexpr int CELLS = Rows * Cols;
+    static_assert(CELLS <= 32, "Los lotes usan mascaras de hasta 32 casillas");
+    using Lane = typename std::conditional<CELLS <= 16, std::uint16_t, std::uint32_t>::type;
+
+    // Los arreglos se rellenan con tableros vacios hasta un multiplo de este
+    // numero, asi ningun conjunto de instrucciones tiene que tratar un resto
+    static constexpr int PADDING = 64;
+
+    void clear();
+    void reserve(int boards);
+    void add(const BoardType& board);
+    void add(Lane xBits, Lane oBits);
+    int size() const { return count; }
+
+    // Sin argumento usa bestBatchIsa(); uno que la CPU no tiene baja al
+    // mejor disponible. No reserva memoria.
+    void evaluate();
+    void evaluate(BatchIsa isa);
+
+    // Resultados de la ultima llamada a evaluate()
+    BatchStatus getStatus(int index) const { return static_cast<BatchStatus>(status[index]); }
+    Lane getLegalMoves(int index) const { return legal[index]; }
+
+    Lane getXBits(int index) const { return xBits[index]; }
+    Lane getOBits(int index) const { return oBits[index]; }
+
+private:
+    std::vector<Lane> xBits;
+    std::vector<Lane> oBits;
+    std::vector<Lane> status;
+    std::vector<Lane> legal;
+    int count = 0;
+
+    void grow();  // Un bloque mas de PADDING tableros vacios
+};
+
+#endif
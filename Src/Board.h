@@ -0,0 +1,219 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <array>
+#include <cstdint>
+
+// Jugadores como indices: 0 = 'X', 1 = 'O'
+inline int playerIndex(char symbol) {
+    return (symbol == 'O') ? 1 : 0;
+}
+
+inline char playerSymbol(int player) {
+    return (player == 1) ? 'O' : 'X';
+}
+
+// MASCARA DE CASILLAS - N bits repartidos en palabras de 64 bits.
+// Para tableros de hasta 64 casillas es un solo entero.
+template <int N>
+struct CellMask {
+    static constexpr int WORDS = (N + 63) / 64;
+    std::uint64_t words[WORDS] = {};
+
+    constexpr void set(int cell) { words[cell >> 6] |= std::uint64_t(1) << (cell & 63); }
+    constexpr void reset(int cell) { words[cell >> 6] &= ~(std::uint64_t(1) << (cell & 63)); }
+    constexpr bool test(int cell) const { return (words[cell >> 6] >> (cell & 63)) & 1; }
+
+    // true si todos los bits de 'other' estan tambien en esta mascara
+    constexpr bool contains(const CellMask& other) const {
+        for (int w = 0; w < WORDS; w++) {
+            if ((words[w] & other.words[w]) != other.words[w]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool intersects(const CellMask& other) const {
+        for (int w = 0; w < WORDS; w++) {
+            if (words[w] & other.words[w]) return true;
+        }
+        return false;
+    }
+
+    constexpr bool none() const {
+        for (int w = 0; w < WORDS; w++) {
+            if (words[w]) return false;
+        }
+        return true;
+    }
+
+    constexpr CellMask operator|(const CellMask& other) const {
+        CellMask result;
+        for (int w = 0; w < WORDS; w++) result.words[w] = words[w] | other.words[w];
+        return result;
+    }
+
+    constexpr bool operator==(const CellMask& other) const {
+        for (int w = 0; w < WORDS; w++) {
+            if (words[w] != other.words[w]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const CellMask& other) const { return !(*this == other); }
+
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < WORDS; w++) total += __builtin_popcountll(words[w]);
+        return total;
+    }
+
+    // Primer bit encendido a partir de 'from' (o N si no hay ninguno)
+    int next(int from) const {
+        for (int w = from >> 6; w < WORDS; w++) {
+            std::uint64_t bits = words[w];
+            if (w == (from >> 6)) bits &= ~std::uint64_t(0) << (from & 63);
+            if (bits) return w * 64 + __builtin_ctzll(bits);
+        }
+        return N;
+    }
+};
+
+// TABLAS DE LINEAS GANADORAS - generadas en tiempo de compilacion para
+// cada combinacion (filas, columnas, k)
+template <int Rows, int Cols, int K>
+struct BoardTables {
+    static constexpr int CELLS = Rows * Cols;
+
+    static constexpr int NUM_LINES =
+        (Cols >= K ? Rows * (Cols - K + 1) : 0) +                          // Horizontales
+        (Rows >= K ? Cols * (Rows - K + 1) : 0) +                          // Verticales
+        (Rows >= K && Cols >= K ? 2 * (Rows - K + 1) * (Cols - K + 1) : 0); // Diagonales
+
+    // Una casilla pertenece como maximo a K lineas por cada una de las 4 direcciones
+    static constexpr int MAX_LINES_PER_CELL = 4 * K;
+
+    std::array<CellMask<CELLS>, NUM_LINES> lineMasks{};
+    std::array<std::array<short, K>, NUM_LINES> lineCells{};
+    std::array<std::array<short, MAX_LINES_PER_CELL>, CELLS> cellLines{};
+    std::array<unsigned char, CELLS> cellLineCount{};
+    CellMask<CELLS> fullMask{};
+
+    // Para tableros de hasta 9 casillas: WIN_TABLE[bits] != 0 si 'bits' contiene una linea
+    static constexpr int WIN_TABLE_SIZE = (CELLS <= 9) ? (1 << CELLS) : 1;
+    std::array<unsigned char, WIN_TABLE_SIZE> winTable{};
+
+    static constexpr BoardTables build() {
+        BoardTables t{};
+        const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int line = 0;
+
+        for (const auto& dir : directions) {
+            for (int row = 0; row < Rows; row++) {
+                for (int col = 0; col < Cols; col++) {
+                    int endRow = row + dir[0] * (K - 1);
+                    int endCol = col + dir[1] * (K - 1);
+                    if (endRow < 0 || endRow >= Rows || endCol < 0 || endCol >= Cols) {
+                        continue;
+                    }
+                    for (int i = 0; i < K; i++) {
+                        int cell = (row + dir[0] * i) * Cols + (col + dir[1] * i);
+                        t.lineMasks[line].set(cell);
+                        t.lineCells[line][i] = static_cast<short>(cell);
+                        t.cellLines[cell][t.cellLineCount[cell]++] = static_cast<short>(line);
+                    }
+                    line++;
+                }
+            }
+        }
+
+        for (int cell = 0; cell < CELLS; cell++) {
+            t.fullMask.set(cell);
+        }
+
+        if (CELLS <= 9) {
+            for (int bits = 0; bits < WIN_TABLE_SIZE; bits++) {
+                for (int l = 0; l < NUM_LINES; l++) {
+                    std::uint64_t mask = t.lineMasks[l].words[0];
+                    if ((static_cast<std::uint64_t>(bits) & mask) == mask) {
+                        t.winTable[bits] = 1;
+                    }
+                }
+            }
+        }
+        return t;
+    }
+};
+
+// MOTOR DE TABLERO m,n,k - un bitboard por jugador, sin memoria dinamica.
+// Las dimensiones son parametros de plantilla, asi que todas las tablas y
+// bucles se resuelven en tiempo de compilacion.
+template <int Rows, int Cols, int K>
+class Board {
+public:
+    static_assert(Rows > 0 && Cols > 0, "El tablero necesita al menos una casilla");
+    static_assert(K >= 2 && (K <= Rows || K <= Cols), "k debe caber en el tablero");
+
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr int WIN_LENGTH = K;
+    static constexpr int CELLS = Rows * Cols;
+
+    using Mask = CellMask<CELLS>;
+    using Tables = BoardTables<Rows, Cols, K>;
+    static constexpr int NUM_LINES = Tables::NUM_LINES;
+
+    static constexpr Tables TABLES = Tables::build();
+
+    static constexpr int index(int row, int col) { return row * Cols + col; }
+    static constexpr bool isInside(int row, int col) {
+        return row >= 0 && row < Rows && col >= 0 && col < Cols;
+    }
+
+    bool isEmpty(int cell) const { return !occupied().test(cell); }
+
+    // -1 si esta vacia, 0 para 'X', 1 para 'O'
+    int owner(int cell) const {
+        if (playerBits[0].test(cell)) return 0;
+        if (playerBits[1].test(cell)) return 1;
+        return -1;
+    }
+
+    void play(int cell, int player) { playerBits[player].set(cell); }
+    void unplay(int cell, int player) { playerBits[player].reset(cell); }
+    void clear() { playerBits[0] = Mask{}; playerBits[1] = Mask{}; }
+
+    const Mask& bits(int player) const { return playerBits[player]; }
+    Mask occupied() const { return playerBits[0] | playerBits[1]; }
+    int moveCount() const { return playerBits[0].count() + playerBits[1].count(); }
+
+    bool isFull() const { return occupied() == TABLES.fullMask; }
+
+    // Revisa todas las lineas del tablero (tabla de 512 entradas en 3x3)
+    bool hasLine(int player) const {
+        if constexpr (CELLS <= 9) {
+            return TABLES.winTable[playerBits[player].words[0]] != 0;
+        } else {
+            for (int l = 0; l < NUM_LINES; l++) {
+                if (playerBits[player].contains(TABLES.lineMasks[l])) return true;
+            }
+            return false;
+        }
+    }
+
+    // Solo revisa las lineas que pasan por 'cell' (tras jugar en ella)
+    bool completesLine(int cell, int player) const {
+        for (int i = 0; i < TABLES.cellLineCount[cell]; i++) {
+            if (playerBits[player].contains(TABLES.lineMasks[TABLES.cellLines[cell][i]])) return true;
+        }
+        return false;
+    }
+
+    bool operator==(const Board& other) const {
+        return playerBits[0] == other.playerBits[0] && playerBits[1] == other.playerBits[1];
+    }
+
+private:
+    Mask playerBits[2];
+};
+
+#endif
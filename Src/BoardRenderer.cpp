@@ -0,0 +1,221 @@
+#include "BoardRenderer.h"
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+
+namespace {
+
+// Une dos tramos distintos si entre ellos hay menos iguales que esto: mover
+// el cursor cuesta unos 8 bytes, reescribir un caracter igual solo 1
+const int MERGE_GAP = 8;
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// 'value' alineado a la derecha en 'width' caracteres (como pad() en Console)
+int formatNumber(int value, int width, char* text) {
+    char digits[12];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    int total = std::max(width, length);
+    for (int i = 0; i < total - length; i++) text[i] = ' ';
+    for (int i = 0; i < length; i++) text[total - 1 - i] = digits[i];
+    return total;
+}
+
+void appendNumber(std::string& out, int value) {
+    char text[12];
+    out.append(text, static_cast<std::size_t>(formatNumber(value, 0, text)));
+}
+
+int statusLines(const std::string& status) {
+    if (status.empty()) return 0;
+    int lines = 1 + static_cast<int>(std::count(status.begin(), status.end(), '\n'));
+    return status.back() == '\n' ? lines - 1 : lines;
+}
+
+}
+
+void TextFrame::put(int lineIndex, int column, const char* text, int length) {
+    length = std::min(length, width - column);
+    if (length > 0) {
+        std::copy(text, text + length, chars.begin() + static_cast<std::size_t>(lineIndex) * width + column);
+    }
+}
+
+int TextFrame::lineLength(int index) const {
+    const char* text = line(index);
+    int length = width;
+    while (length > 0 && text[length - 1] == ' ') length--;
+    return length;
+}
+
+void TextFrame::compose(const std::string& title, const char* cells, int rows, int cols,
+                        const std::string& status, int minWidth) {
+    const bool hasBoard = rows > 0 && cols > 0;
+    // Mismo formato que Console::displayBoard: 1 caracter por casilla hasta
+    // 10 columnas, 2 a partir de ahi
+    const int cellWidth = (rows > 10 || cols > 10) ? 2 : 1;
+    const int boardWidth = hasBoard ? cellWidth + 1 + cols * (cellWidth + 3) - 3 : 0;
+    const int statusCount = statusLines(status);
+
+    // Primero el tamano, asi el bufer se reserva una sola vez
+    int needWidth = std::max({minWidth, boardWidth, static_cast<int>(title.size())});
+    for (std::size_t start = 0; start < status.size();) {
+        std::size_t end = status.find('\n', start);
+        if (end == std::string::npos) end = status.size();
+        needWidth = std::max(needWidth, static_cast<int>(end - start));
+        start = end + 1;
+    }
+    width = needWidth;
+    height = (title.empty() ? 0 : 1) + (hasBoard ? 2 * rows : 0) + (hasBoard && statusCount ? 1 : 0) + statusCount;
+    std::size_t size = static_cast<std::size_t>(width) * height;
+    if (chars.size() < size) chars.resize(size);
+    std::fill(chars.begin(), chars.begin() + size, ' ');
+
+    int lineIndex = 0;
+    if (!title.empty()) {
+        put(lineIndex++, 0, title.data(), static_cast<int>(title.size()));
+    }
+    if (hasBoard) {
+        char number[12];
+        for (int col = 0; col < cols; col++) {
+            put(lineIndex, cellWidth + 1 + col * (cellWidth + 3), number, formatNumber(col, cellWidth, number));
+        }
+        lineIndex++;
+        for (int row = 0; row < rows; row++) {
+            put(lineIndex, 0, number, formatNumber(row, cellWidth, number));
+            for (int col = 0; col < cols; col++) {
+                int column = cellWidth + 1 + col * (cellWidth + 3);
+                put(lineIndex, column + cellWidth - 1, &cells[row * cols + col], 1);
+                if (col < cols - 1) put(lineIndex, column + cellWidth + 1, "|", 1);
+            }
+            lineIndex++;
+            if (row < rows - 1) {
+                char* separator = chars.data() + static_cast<std::size_t>(lineIndex) * width + cellWidth + 1;
+                std::fill(separator, separator + cols * (cellWidth + 3) - 3, '-');
+            }
+            lineIndex++;  // Despues de la ultima fila queda en blanco, antes del estado
+        }
+    }
+    for (std::size_t start = 0; start < status.size() && lineIndex < height; lineIndex++) {
+        std::size_t end = status.find('\n', start);
+        if (end == std::string::npos) end = status.size();
+        put(lineIndex, 0, status.data() + start, static_cast<int>(end - start));
+        start = end + 1;
+    }
+}
+
+void TextRenderer::render(const std::string& title, const char* cells, int rows, int cols,
+                          const std::string& status) {
+    frame.compose(title, cells, rows, cols, status, 0);
+    out.clear();
+    out += '\n';
+    for (int i = 0; i < frame.getHeight(); i++) {
+        out.append(frame.line(i), static_cast<std::size_t>(frame.lineLength(i)));
+        out += '\n';
+    }
+    std::cout.flush();  // Lo que ya estaba en std::cout sale antes
+    writeAll(fd, out.data(), out.size());
+    stats.frames++;
+    stats.fullRedraws++;
+    stats.changedChars += static_cast<long long>(frame.getWidth()) * frame.getHeight();
+    stats.bytesWritten += static_cast<long long>(out.size());
+}
+
+void TerminalRenderer::moveTo(int lineIndex, int column) {
+    out += "\x1b[";
+    appendNumber(out, lineIndex + 1);
+    out += ';';
+    appendNumber(out, column + 1);
+    out += 'H';
+}
+
+void TerminalRenderer::render(const std::string& title, const char* cells, int rows, int cols,
+                              const std::string& status) {
+    back.compose(title, cells, rows, cols, status, front.getWidth());
+    const int width = back.getWidth();
+    out.clear();
+
+    // Completo la primera vez, despues de invalidate() o si el ancho crecio
+    if (fullRedraw || width != front.getWidth()) {
+        out += "\x1b[H\x1b[2J";
+        for (int i = 0; i < back.getHeight(); i++) {
+            int length = back.lineLength(i);
+            if (length == 0) continue;
+            moveTo(i, 0);
+            out.append(back.line(i), static_cast<std::size_t>(length));
+            stats.changedChars += length;
+        }
+        stats.fullRedraws++;
+    } else {
+        for (int i = 0; i < back.getHeight(); i++) {
+            const char* now = back.line(i);
+            if (i >= front.getHeight()) {
+                // Linea nueva: ahi pudo quedar lo escrito debajo del cuadro
+                int length = back.lineLength(i);
+                moveTo(i, 0);
+                out.append(now, static_cast<std::size_t>(length));
+                out += "\x1b[K";
+                stats.changedChars += length;
+                continue;
+            }
+            const char* before = front.line(i);
+            int column = 0;
+            while (column < width) {
+                if (now[column] == before[column]) {
+                    column++;
+                    continue;
+                }
+                int start = column;
+                int end = column + 1;
+                for (column++; column < width && column - end < MERGE_GAP; column++) {
+                    if (now[column] != before[column]) {
+                        end = column + 1;
+                        stats.changedChars++;
+                    }
+                }
+                stats.changedChars++;
+                moveTo(i, start);
+                out.append(now + start, static_cast<std::size_t>(end - start));
+                column = end;
+            }
+        }
+    }
+
+    // Cursor debajo del cuadro y el resto de la pantalla en blanco: se van
+    // las lineas sobrantes del cuadro anterior y lo escrito debajo
+    moveTo(back.getHeight(), 0);
+    out += "\x1b[J";
+
+    std::cout.flush();  // Lo que ya estaba en std::cout sale antes
+    writeAll(fd, out.data(), out.size());
+    stats.frames++;
+    stats.bytesWritten += static_cast<long long>(out.size());
+    std::swap(front, back);
+    fullRedraw = false;
+}
+
+std::unique_ptr<BoardRenderer> createRenderer(const std::string& spec) {
+    if (spec == "auto") {
+        return createRenderer(isatty(1) ? "terminal" : "texto");
+    }
+    if (spec == "terminal") return std::unique_ptr<BoardRenderer>(new TerminalRenderer());
+    if (spec == "texto") return std::unique_ptr<BoardRenderer>(new TextRenderer());
+    if (spec == "ninguno") return std::unique_ptr<BoardRenderer>(new NullRenderer());
+    return nullptr;
+}
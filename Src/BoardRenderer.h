@@ -0,0 +1,110 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// DIBUJO DE TABLEROS POR CUADROS
+// Cada cuadro (un titulo, el tablero con el mismo formato que
+// Console::displayBoard y lineas de estado) se arma en un bufer de texto que
+// se reserva una vez y se reutiliza. Segun el renderizador:
+//   TerminalRenderer  compara con el cuadro anterior y escribe solo los
+//                     caracteres que cambiaron, con posicionamiento del
+//                     cursor ANSI, en un solo write() por cuadro
+//   TextRenderer      escribe el cuadro completo (tuberias y archivos)
+//   NullRenderer      no escribe nada (corridas por lotes sin pantalla)
+// En un tablero 15x15 una jugada con TerminalRenderer son unas decenas de
+// bytes en vez de los ~2 KB del tablero completo.
+struct RenderStats {
+    long long frames = 0;
+    long long fullRedraws = 0;    // Cuadros escritos completos
+    long long changedChars = 0;   // Caracteres escritos por ser distintos
+    long long bytesWritten = 0;
+};
+
+class BoardRenderer {
+public:
+    virtual ~BoardRenderer() = default;
+
+    // 'cells' tiene rows*cols casillas por filas ('X', 'O' o ' '); con rows
+    // o cols en 0 solo se dibujan los textos. 'status' puede tener varias
+    // lineas separadas por '\n'.
+    virtual void render(const std::string& title, const char* cells, int rows, int cols,
+                        const std::string& status) = 0;
+
+    // El proximo cuadro se escribe completo (otro texto tapo la pantalla)
+    virtual void invalidate() {}
+
+    const RenderStats& getStats() const { return stats; }
+
+protected:
+    RenderStats stats;
+};
+
+// Cuadro de texto: 'height' lineas de 'width' caracteres rellenas con
+// espacios. El ancho nunca baja de 'minWidth', asi dos cuadros seguidos con
+// lineas de estado de distinto largo se pueden comparar caracter a caracter.
+class TextFrame {
+public:
+    void compose(const std::string& title, const char* cells, int rows, int cols, const std::string& status,
+                 int minWidth);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const char* line(int index) const { return chars.data() + static_cast<std::size_t>(index) * width; }
+    int lineLength(int index) const;  // Sin los espacios del final
+
+private:
+    std::vector<char> chars;
+    int width = 0;
+    int height = 0;
+
+    void put(int lineIndex, int column, const char* text, int length);
+};
+
+class NullRenderer : public BoardRenderer {
+public:
+    void render(const std::string&, const char*, int, int, const std::string&) override { stats.frames++; }
+};
+
+class TextRenderer : public BoardRenderer {
+public:
+    explicit TextRenderer(int fd = 1) : fd(fd) {}
+
+    void render(const std::string& title, const char* cells, int rows, int cols,
+                const std::string& status) override;
+
+private:
+    int fd;
+    TextFrame frame;
+    std::string out;
+};
+
+// El cuadro se dibuja desde la esquina superior de la pantalla; lo que se
+// escriba despues (una pregunta, lo que teclea el usuario) queda debajo y se
+// borra con el cuadro siguiente.
+class TerminalRenderer : public BoardRenderer {
+public:
+    explicit TerminalRenderer(int fd = 1) : fd(fd) {}
+
+    void render(const std::string& title, const char* cells, int rows, int cols,
+                const std::string& status) override;
+    void invalidate() override { fullRedraw = true; }
+
+private:
+    int fd;
+    TextFrame front;  // Lo que hay en pantalla
+    TextFrame back;   // El cuadro nuevo
+    std::string out;  // Secuencias del cuadro, un solo write()
+    bool fullRedraw = true;
+
+    void moveTo(int lineIndex, int column);
+};
+
+// Especificaciones validas: "terminal", "texto", "ninguno" o "auto" (terminal
+// si la salida estandar es una terminal, si no texto). Devuelve nullptr si la
+// especificacion no es valida.
+std::unique_ptr<BoardRenderer> createRenderer(const std::string& spec);
+
+#endif
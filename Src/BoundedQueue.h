@@ -0,0 +1,91 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// COLA ACOTADA PRODUCTOR/CONSUMIDOR
+// push() bloquea cuando la cola esta llena (contrapresion hacia los
+// productores) y pop() bloquea cuando esta vacia. Despues de close(),
+// pop() vacia lo pendiente y luego devuelve false.
+template <typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items;
+    std::size_t capacity;
+    bool closed = false;
+    std::size_t maxDepth = 0;      // Profundidad maxima observada
+    std::size_t blockedPushes = 0; // Veces que un productor tuvo que esperar
+    mutable std::mutex lock;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+    
+    void push(T item) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (items.size() >= capacity) {
+            blockedPushes++;
+            notFull.wait(guard, [this] { return items.size() < capacity || closed; });
+        }
+        items.push_back(std::move(item));
+        if (items.size() > maxDepth) maxDepth = items.size();
+        notEmpty.notify_one();
+    }
+    
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> guard(lock);
+        notEmpty.wait(guard, [this] { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+    
+    // Saca de una vez hasta 'maxItems' (al menos uno): un solo despertar
+    // para una tanda de pedidos chicos
+    bool popBatch(std::vector<T>& batch, std::size_t maxItems) {
+        std::unique_lock<std::mutex> guard(lock);
+        notEmpty.wait(guard, [this] { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        while (!items.empty() && batch.size() < maxItems) {
+            batch.push_back(std::move(items.front()));
+            items.pop_front();
+        }
+        notFull.notify_all();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+    
+    std::size_t size() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return items.size();
+    }
+    
+    std::size_t getMaxDepth() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return maxDepth;
+    }
+    
+    std::size_t getBlockedPushes() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return blockedPushes;
+    }
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "Console.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BoardRenderer.h"
+#include "FileManager.h"
+#include "Logger.h"
+
+template <typename GameType>
+void Console<GameType>::displayBoard(const GameType& game) {
+    constexpr int Rows = GameType::BoardType::ROWS;
+    constexpr int Cols = GameType::BoardType::COLS;
+
+    // Ancho de columna: 1 caracter hasta 10 columnas, 2 a partir de ahi
+    const int width = (Rows > 10 || Cols > 10) ? 2 : 1;
+    auto pad = [width](int value) {
+        std::string text = std::to_string(value);
+        return std::string(width - text.size(), ' ') + text;
+    };
+
+    std::cout << "\n" << std::string(width + 1, ' ');
+    for (int col = 0; col < Cols; col++) {
+        std::cout << pad(col) << (col < Cols - 1 ? "   " : "");
+    }
+    std::cout << "\n";
+    for (int row = 0; row < Rows; row++) {
+        std::cout << pad(row) << " ";
+        for (int col = 0; col < Cols; col++) {
+            std::cout << std::string(width - 1, ' ') << game.getCellValue(row, col);
+            if (col < Cols - 1) std::cout << " | ";
+        }
+        std::cout << "\n";
+        if (row < Rows - 1) std::cout << std::string(width + 1, ' ') << std::string(Cols * (width + 3) - 3, '-') << "\n";
+    }
+    std::cout << "\n";
+}
+
+template <typename GameType>
+void Console<GameType>::playGame(GameType& game) {
+    playGame(game, MoveProvider(), ' ');
+}
+
+// Mismo ciclo de juego, pero los turnos de 'cpuSymbol' los decide 'cpu'
+template <typename GameType>
+void Console<GameType>::playGame(GameType& game, const MoveProvider& cpu, char cpuSymbol) {
+    constexpr int Rows = GameType::BoardType::ROWS;
+    constexpr int Cols = GameType::BoardType::COLS;
+    int row, col;
+
+    std::cout << "=== JUEGO DE TRIKI (con manejo de memoria) ===\n";
+    std::cout << "Coordenadas: fila columna (0-" << Rows - 1 << " / 0-" << Cols - 1 << ")\n";
+    showMemoryInfo(game);  // Mostrar info de memoria
+
+    while (!game.isGameEnded()) {
+        displayBoard(game);
+
+        std::cout << "Turno del jugador " << game.getCurrentPlayer() << "\n";
+
+        if (cpu && game.getCurrentPlayer() == cpuSymbol) {
+            int cell = cpu(game);
+            row = cell / Cols;
+            col = cell % Cols;
+            std::cout << "La CPU juega: " << row << " " << col << "\n";
+        } else {
+            std::cout << "Ingresa fila y columna: ";
+            std::cin >> row >> col;
+        }
+
+        if (game.playTurn(row, col)) {
+            if (game.isGameEnded()) {
+                displayBoard(game);
+                if (game.getWinner() != ' ') {
+                    std::cout << "¡Jugador " << game.getWinner() << " gana!\n";
+                } else {
+                    std::cout << "¡Empate!\n";
+                }
+            }
+        } else {
+            std::cout << "Movimiento inválido. Intenta de nuevo.\n";
+        }
+    }
+}
+
+template <typename GameType>
+void Console<GameType>::playGame(GameType& game, const MoveProvider& cpu, char cpuSymbol, BoardRenderer& renderer) {
+    constexpr int Rows = GameType::BoardType::ROWS;
+    constexpr int Cols = GameType::BoardType::COLS;
+    const std::string title = "=== JUEGO DE TRIKI " + std::to_string(Rows) + "x" + std::to_string(Cols) +
+                              " (coordenadas: fila columna, 0-" + std::to_string(Rows - 1) + " / 0-" +
+                              std::to_string(Cols - 1) + ") ===";
+    std::vector<char> cells(Rows * Cols);
+    std::string message;  // Lo que paso en el turno anterior
+    int row, col;
+
+    auto draw = [&](const std::string& status) {
+        for (int r = 0; r < Rows; r++) {
+            for (int c = 0; c < Cols; c++) {
+                cells[r * Cols + c] = game.getCellValue(r, c);
+            }
+        }
+        renderer.render(title, cells.data(), Rows, Cols, status);
+    };
+
+    while (!game.isGameEnded()) {
+        draw(message + "Turno del jugador " + game.getCurrentPlayer());
+
+        if (cpu && game.getCurrentPlayer() == cpuSymbol) {
+            int cell = cpu(game);
+            row = cell / Cols;
+            col = cell % Cols;
+            message = "La CPU juega: " + std::to_string(row) + " " + std::to_string(col) + "\n";
+        } else {
+            std::cout << "Ingresa fila y columna: " << std::flush;
+            std::cin >> row >> col;
+            message.clear();
+        }
+
+        if (game.playTurn(row, col)) {
+            if (game.isGameEnded()) {
+                draw(message + (game.getWinner() != ' ' ? std::string("¡Jugador ") + game.getWinner() + " gana!"
+                                                        : std::string("¡Empate!")));
+            }
+        } else {
+            message = "Movimiento inválido. Intenta de nuevo.\n";
+        }
+    }
+}
+
+template <typename GameType>
+void Console<GameType>::showMemoryInfo(const GameType& game) {
+    Logger::flush();  // Los mensajes pendientes salen antes del informe
+    std::cout << "\n=== INFORMACIÓN DE MEMORIA ===\n";
+    std::cout << "Bitboard X: " << (void*)&game.board.bits(0) << "\n";
+    std::cout << "Bitboard O: " << (void*)&game.board.bits(1) << "\n";
+    std::cout << "Casillas del tablero: " << game.boardSize << " (" << sizeof(game.board) << " bytes)\n";
+    std::cout << "Contadores de lineas: " << GameType::BoardType::NUM_LINES << " por jugador ("
+              << sizeof(game.lineCounts) << " bytes)\n";
+    std::cout << "Dirección de currentPlayer (stack): " << (void*)&game.currentPlayer << "\n";
+    std::cout << "Valor actual: " << game.currentPlayer << "\n";
+    std::cout << "===============================\n\n";
+}
+
+void showDirectoryInfo(const FileManager& fileManager) {
+    FileManager::DirectoryInfo info = fileManager.getDirectoryInfo();
+    Logger::flush();
+    std::cout << "\n=== INFORMACIÓN DEL FILEMANAGER ===\n";
+    std::cout << "Directorio de guardado: " << info.directory << "\n";
+    std::cout << "Dirección del puntero: " << info.directoryAddress << "\n";
+    std::cout << "Máximo archivos permitidos: " << info.maxSavedFiles << "\n";
+    if (info.packed) {
+        std::cout << "Almacen empaquetado: " << info.storeCount << "/" << info.storeCapacity
+                  << " casillas ocupadas, " << info.storeBytes << " bytes en disco\n";
+    }
+    if (info.hasPositions) {
+        std::cout << "Posiciones compartidas: " << info.positions.positions << " archivos para "
+                  << info.positions.references << " partidas (" << info.positions.bytes << " bytes)"
+                  << (info.contentAddressed ? "" : ", modo apagado") << "\n";
+    }
+    std::cout << "Archivos encontrados: " << info.files.size() << "\n";
+    for (const auto& file : info.files) {
+        std::cout << "  - " << file.name << " (" << file.size << " bytes)\n";
+    }
+    std::cout << "==================================\n" << std::endl;
+}
+
+// INSTANCIACION EXPLICITA - las mismas variantes que Game.cpp
+template class Console<Game>;
+template class Console<Game4x4>;
+template class Console<Game5x5>;
+template class Console<Gomoku>;
@@ -0,0 +1,37 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "Game.h"
+
+class BoardRenderer;
+class FileManager;
+
+// PROGRAMA DE CONSOLA
+// Todo lo que lee de std::cin o escribe en std::cout alrededor de una
+// partida: el tablero, el ciclo de turnos y el informe de memoria. Game solo
+// guarda reglas y estado; el servidor y las herramientas por lotes no pasan
+// por aqui. Instancias para las mismas variantes que Game (Console.cpp).
+template <typename GameType>
+class Console {
+public:
+    using MoveProvider = typename GameType::MoveProvider;
+
+    static void displayBoard(const GameType& game);
+
+    // Ciclo de juego hasta que la partida termine
+    static void playGame(GameType& game);
+    static void playGame(GameType& game, const MoveProvider& cpu, char cpuSymbol);  // Contra la CPU
+
+    // Mismo ciclo dibujado con 'renderer' (BoardRenderer.h): cada turno es un
+    // cuadro con el tablero y el estado; con TerminalRenderer solo se
+    // reescriben las casillas que cambiaron (tableros grandes como Gomoku)
+    static void playGame(GameType& game, const MoveProvider& cpu, char cpuSymbol, BoardRenderer& renderer);
+
+    // Direcciones y tamanos del estado de la partida (educativo)
+    static void showMemoryInfo(const GameType& game);
+};
+
+// Directorio de guardado, almacen y partidas de un FileManager (educativo)
+void showDirectoryInfo(const FileManager& fileManager);
+
+#endif
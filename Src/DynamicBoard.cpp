@@ -0,0 +1,99 @@
+#include "DynamicBoard.h"
+#include <algorithm>
+#include <stdexcept>
+
+DynamicBoard::DynamicBoard(int rows, int cols, int winLength)
+    : rows(rows), cols(cols), winLength(winLength) {
+    if (rows <= 0 || cols <= 0 || winLength < 2 || (winLength > rows && winLength > cols)) {
+        throw std::invalid_argument("Dimensiones m,n,k invalidas");
+    }
+    
+    words = (rows * cols + 63) / 64;
+    playerBits.assign(2 * words, 0);
+    
+    // Generar las lineas en las 4 direcciones (igual que BoardTables)
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    std::vector<std::vector<int>> linesOfCell(rows * cols);
+    int line = 0;
+    
+    for (const auto& dir : directions) {
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                if (!isInside(row + dir[0] * (winLength - 1), col + dir[1] * (winLength - 1))) {
+                    continue;
+                }
+                lineMasks.resize(lineMasks.size() + words, 0);
+                std::uint64_t* lineMask = &lineMasks[line * words];
+                for (int i = 0; i < winLength; i++) {
+                    int cell = index(row + dir[0] * i, col + dir[1] * i);
+                    lineMask[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+                    linesOfCell[cell].push_back(line);
+                }
+                line++;
+            }
+        }
+    }
+    
+    // Aplanar la lista de lineas por casilla
+    cellLineStart.push_back(0);
+    for (const auto& lines : linesOfCell) {
+        cellLineList.insert(cellLineList.end(), lines.begin(), lines.end());
+        cellLineStart.push_back(static_cast<int>(cellLineList.size()));
+    }
+}
+
+bool DynamicBoard::containsLine(int player, int line) const {
+    const std::uint64_t* bits = mask(player);
+    const std::uint64_t* lineMask = &lineMasks[line * words];
+    for (int w = 0; w < words; w++) {
+        if ((bits[w] & lineMask[w]) != lineMask[w]) return false;
+    }
+    return true;
+}
+
+bool DynamicBoard::isEmpty(int cell) const {
+    return owner(cell) < 0;
+}
+
+int DynamicBoard::owner(int cell) const {
+    std::uint64_t bit = std::uint64_t(1) << (cell & 63);
+    if (mask(0)[cell >> 6] & bit) return 0;
+    if (mask(1)[cell >> 6] & bit) return 1;
+    return -1;
+}
+
+void DynamicBoard::play(int cell, int player) {
+    playerBits[player * words + (cell >> 6)] |= std::uint64_t(1) << (cell & 63);
+}
+
+void DynamicBoard::unplay(int cell, int player) {
+    playerBits[player * words + (cell >> 6)] &= ~(std::uint64_t(1) << (cell & 63));
+}
+
+void DynamicBoard::clear() {
+    std::fill(playerBits.begin(), playerBits.end(), 0);
+}
+
+int DynamicBoard::moveCount() const {
+    int total = 0;
+    for (std::uint64_t w : playerBits) total += __builtin_popcountll(w);
+    return total;
+}
+
+bool DynamicBoard::isFull() const {
+    return moveCount() == rows * cols;
+}
+
+bool DynamicBoard::hasLine(int player) const {
+    for (int line = 0; line < getNumLines(); line++) {
+        if (containsLine(player, line)) return true;
+    }
+    return false;
+}
+
+bool DynamicBoard::completesLine(int cell, int player) const {
+    for (int i = cellLineStart[cell]; i < cellLineStart[cell + 1]; i++) {
+        if (containsLine(player, cellLineList[i])) return true;
+    }
+    return false;
+}
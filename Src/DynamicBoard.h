@@ -0,0 +1,50 @@
+#ifndef DYNAMICBOARD_H
+#define DYNAMICBOARD_H
+
+#include <cstdint>
+#include <vector>
+
+// TABLERO m,n,k CON DIMENSIONES EN TIEMPO DE EJECUCION
+// Misma interfaz que Board<Rows, Cols, K> para tamaños que no se conocen
+// al compilar. Las tablas de lineas se generan una vez en el constructor.
+class DynamicBoard {
+private:
+    int rows;
+    int cols;
+    int winLength;
+    int words;                              // Palabras de 64 bits por bitboard
+    std::vector<std::uint64_t> playerBits;  // 2 * words: primero 'X', luego 'O'
+    
+    // Tablas de lineas ganadoras (compartidas por las copias)
+    std::vector<std::uint64_t> lineMasks;   // NUM_LINES * words
+    std::vector<int> cellLineStart;         // Indice CSR: lineas de cada casilla
+    std::vector<int> cellLineList;
+    
+    const std::uint64_t* mask(int player) const { return &playerBits[player * words]; }
+    bool containsLine(int player, int line) const;
+    
+public:
+    DynamicBoard(int rows, int cols, int winLength);
+    
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getWinLength() const { return winLength; }
+    int getCells() const { return rows * cols; }
+    int getNumLines() const { return static_cast<int>(lineMasks.size()) / words; }
+    
+    int index(int row, int col) const { return row * cols + col; }
+    bool isInside(int row, int col) const { return row >= 0 && row < rows && col >= 0 && col < cols; }
+    
+    bool isEmpty(int cell) const;
+    int owner(int cell) const;  // -1 vacia, 0 'X', 1 'O'
+    void play(int cell, int player);
+    void unplay(int cell, int player);
+    void clear();
+    
+    int moveCount() const;
+    bool isFull() const;
+    bool hasLine(int player) const;
+    bool completesLine(int cell, int player) const;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "FileManager.h"
-#include <iostream>
+#include "Logger.h"
+#include "Metrics.h"
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
@@ -14,9 +15,9 @@ FileManager::FileManager() {
     
     // Crear directorio si no existe
     createDirectoryIfNotExists(*saveDirectory);
+    openStorage();
     
-    std::cout << "[DEBUG FileManager] Memoria alocada para directorio: " 
-              << (void*)saveDirectory << std::endl;
+    TRIKI_DEBUG(LOG_MEMORY, "FileManager: memoria alocada para directorio: " << (void*)saveDirectory);
 }
 
 // CONSTRUCTOR CON DIRECTORIO PERSONALIZADO
@@ -25,15 +26,20 @@ FileManager::FileManager(const std::string& customDir) {
     maxSavedFiles = 10;
     
     createDirectoryIfNotExists(*saveDirectory);
+    openStorage();
     
-    std::cout << "[DEBUG FileManager] Directorio personalizado creado: " 
-              << *saveDirectory << std::endl;
+    TRIKI_DEBUG(LOG_MEMORY, "FileManager: directorio personalizado creado: " << *saveDirectory);
 }
 
 // DESTRUCTOR - Libera memoria del heap
 FileManager::~FileManager() {
     delete saveDirectory;
-    std::cout << "[DEBUG FileManager] Memoria liberada del directorio" << std::endl;
+    TRIKI_DEBUG(LOG_MEMORY, "FileManager: memoria liberada del directorio");
+}
+
+FileManager& FileManager::shared() {
+    static FileManager instance;
+    return instance;
 }
 
 // CONSTRUCTOR COPIA (Regla de los 3)
@@ -41,9 +47,11 @@ FileManager::FileManager(const FileManager& other) {
     // Alocar nueva memoria
     saveDirectory = new std::string(*(other.saveDirectory));
     maxSavedFiles = other.maxSavedFiles;
+    store = other.store;
+    index = other.index;
+    blobs = other.blobs;
     
-    std::cout << "[DEBUG FileManager] Copia creada con directorio: " 
-              << *saveDirectory << std::endl;
+    TRIKI_DEBUG(LOG_MEMORY, "FileManager: copia creada con directorio: " << *saveDirectory);
 }
 
 // OPERADOR ASIGNACIÃ“N (Regla de los 3)
@@ -55,6 +63,9 @@ FileManager& FileManager::operator=(const FileManager& other) {
         // Alocar nueva memoria y copiar
         saveDirectory = new std::string(*(other.saveDirectory));
         maxSavedFiles = other.maxSavedFiles;
+        store = other.store;
+        index = other.index;
+        blobs = other.blobs;
     }
     return *this;
 }
@@ -65,122 +76,305 @@ bool FileManager::createDirectoryIfNotExists(const std::string& path) {
         // std::filesystem es C++17, manejo moderno de archivos
         if (!std::filesystem::exists(path)) {
             std::filesystem::create_directories(path);
-            std::cout << "[INFO] Directorio creado: " << path << std::endl;
+            TRIKI_INFO(LOG_IO, "Directorio creado: " << path);
             return true;
         }
         return true;
     } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "[ERROR] No se pudo crear directorio: " << e.what() << std::endl;
+        TRIKI_ERROR(LOG_IO, "No se pudo crear directorio: " << e.what());
         return false;
     }
 }
 
+// Almacen empaquetado o, si no se puede, indice del directorio
+void FileManager::openStorage() {
+    store = SaveStore::open(*saveDirectory);
+    index = store ? nullptr : SaveIndex::open(*saveDirectory);
+    blobs = SaveBlobs::open(*saveDirectory);
+}
+
 // LISTAR PARTIDAS GUARDADAS
 std::vector<std::string> FileManager::listSavedGames() const {
+    MetricTimer timer(METRIC_SCAN_LATENCY);
     std::vector<std::string> gameFiles;
     
-    try {
-        // Iterar por todos los archivos del directorio
-        for (const auto& entry : std::filesystem::directory_iterator(*saveDirectory)) {
-            if (entry.is_regular_file()) {
-                std::string filename = entry.path().filename().string();
-                
-                // Solo archivos .triki
-                if (filename.length() > 6 && 
-                    filename.substr(filename.length() - 6) == ".triki") {
-                    gameFiles.push_back(filename);
-                }
-            }
+    if (store) {
+        // Una pasada por la memoria del almacen, sin leer el directorio
+        for (const auto& entry : store->list()) {
+            gameFiles.push_back(entry.name);
         }
-        
-        // Ordenar alfabÃ©ticamente
         std::sort(gameFiles.begin(), gameFiles.end());
-        
-    } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "[ERROR] Error accediendo al directorio: " << e.what() << std::endl;
+    } else {
+        // El indice ya viene ordenado por nombre
+        for (const auto& entry : index->list()) {
+            gameFiles.push_back(entry.name);
+        }
     }
     
+    TRIKI_COUNT(METRIC_DIRECTORY_SCANS, 1);
+    TRIKI_COUNT(METRIC_SCANNED_ENTRIES, gameFiles.size());
     return gameFiles;
 }
 
 // VERIFICAR SI ARCHIVO EXISTE
 bool FileManager::fileExists(const std::string& filename) const {
-    std::string fullPath = *saveDirectory + "/" + filename;
-    return std::filesystem::exists(fullPath);
+    if (store) {
+        return store->contains(filename);
+    }
+    return index->contains(filename);
 }
 
 // ELIMINAR PARTIDA GUARDADA
 bool FileManager::deleteGame(const std::string& filename) {
     if (!fileExists(filename)) {
-        std::cout << "[WARNING] Archivo no existe: " << filename << std::endl;
+        TRIKI_WARNING(LOG_IO, "Archivo no existe: " << filename);
         return false;
     }
     
+    // Si era una referencia, la posicion pierde una despues de borrar el nombre
+    std::uint64_t key;
+    std::uint32_t variant;
+    bool reference = findReference(filename, key, variant);
+    
+    if (store) {
+        store->remove(filename);
+        if (reference) blobs->release(key, variant);
+        TRIKI_INFO(LOG_IO, "Partida eliminada del almacen: " << filename);
+        return true;
+    }
+    
     try {
         std::string fullPath = *saveDirectory + "/" + filename;
         std::filesystem::remove(fullPath);
-        std::cout << "[INFO] Archivo eliminado: " << filename << std::endl;
+        index->forget(filename);
+        if (reference) blobs->release(key, variant);
+        TRIKI_INFO(LOG_IO, "Archivo eliminado: " << filename);
         return true;
     } catch (const std::filesystem::filesystem_error& e) {
-        std::cerr << "[ERROR] No se pudo eliminar: " << e.what() << std::endl;
+        TRIKI_ERROR(LOG_IO, "No se pudo eliminar: " << e.what());
         return false;
     }
 }
 
-// OPTIMIZACIÃ“N DE MEMORIA - Limpiar archivos antiguos
-void FileManager::cleanOldSaves() {
-    auto gameFiles = listSavedGames();
+// ESCRIBIR PARTIDA - si el nombre era una referencia, su posicion pierde
+// una recien cuando el contenido nuevo ya esta escrito
+bool FileManager::writeSaveFile(const std::string& filename, const std::vector<char>& data) {
+    std::uint64_t oldKey;
+    std::uint32_t oldVariant;
+    bool replacesReference = findReference(filename, oldKey, oldVariant);
+    if (!writeRaw(filename, data)) {
+        return false;
+    }
+    if (replacesReference) {
+        blobs->release(oldKey, oldVariant);
+    }
+    return true;
+}
+
+// GUARDADO POR CONTENIDO - primero se suma la referencia a la posicion y
+// despues se escribe el nombre: un corte nunca deja una referencia rota
+bool FileManager::writeSaveFile(const std::string& filename, const std::vector<char>& data,
+                                std::uint64_t positionKey) {
+    if (!blobs->isEnabled()) {
+        return writeSaveFile(filename, data);
+    }
+    std::uint32_t variant;
+    if (!blobs->acquire(positionKey, data, variant)) {
+        return false;
+    }
+    if (!writeSaveFile(filename, SaveBlobs::makeReference(positionKey, variant))) {
+        blobs->release(positionKey, variant);
+        return false;
+    }
+    TRIKI_DEBUG(LOG_IO, filename << " -> posicion " << std::hex << positionKey << "-" << variant << std::dec);
+    return true;
+}
+
+// ESCRITURA DIRECTA - temporal + renombrado atomico
+bool FileManager::writeRaw(const std::string& filename, const std::vector<char>& data) {
+    if (store) {
+        return store->write(filename, data);
+    }
+    
+    std::string fullPath = *saveDirectory + "/" + filename;
+    std::string tempPath = fullPath + ".tmp";
     
-    if (gameFiles.size() <= static_cast<size_t>(maxSavedFiles)) {
-        std::cout << "[INFO] No hay archivos que limpiar (" 
-                  << gameFiles.size() << "/" << maxSavedFiles << ")" << std::endl;
+    {
+        // Sin buffer del stream: el contenido sale en una sola llamada a write
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(nullptr, 0);
+        file.open(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.close();
+        if (file.fail()) {
+            std::filesystem::remove(tempPath);
+            return false;
+        }
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(tempPath, fullPath, error);
+    if (error) {
+        TRIKI_ERROR(LOG_IO, "No se pudo reemplazar " << fullPath << ": " << error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    index->refreshFile(filename);
+    return true;
+}
+
+// ESCRIBIR VARIAS PARTIDAS
+void FileManager::writeSaveFiles(const std::vector<std::string>& filenames,
+                                 const std::vector<std::vector<char>>& contents,
+                                 const std::vector<std::uint64_t>& positionKeys, std::vector<bool>& results) {
+    // Con posiciones compartidas cada partida sigue su propio camino
+    bool sharing = blobs->isEnabled() && positionKeys.size() == filenames.size();
+    if (store && !sharing && !blobs->hasPositions()) {
+        store->writeBatch(filenames, contents, results);
         return;
     }
+    results.assign(filenames.size(), false);
+    for (std::size_t i = 0; i < filenames.size(); i++) {
+        results[i] = sharing ? writeSaveFile(filenames[i], contents[i], positionKeys[i])
+                             : writeSaveFile(filenames[i], contents[i]);
+    }
+}
+
+// LEER PARTIDA - una referencia se cambia por el contenido de su posicion
+bool FileManager::readSaveFile(const std::string& filename, std::vector<char>& data) const {
+    if (!readRaw(filename, data)) {
+        return false;
+    }
+    std::uint64_t key;
+    std::uint32_t variant;
+    if (SaveBlobs::parseReference(data.data(), data.size(), key, variant)) {
+        return blobs->read(key, variant, data);
+    }
+    return true;
+}
+
+// LECTURA DIRECTA - tamaño conocido, una sola lectura
+bool FileManager::readRaw(const std::string& filename, std::vector<char>& data) const {
+    if (store) {
+        return store->read(filename, data);
+    }
     
-    // Ordenar por fecha de modificaciÃ³n (mÃ¡s antiguos primero)
-    std::vector<std::pair<std::string, std::filesystem::file_time_type>> filesWithTime;
+    std::string fullPath = *saveDirectory + "/" + filename;
     
-    for (const auto& file : gameFiles) {
-        std::string fullPath = *saveDirectory + "/" + file;
-        auto lastWrite = std::filesystem::last_write_time(fullPath);
-        filesWithTime.push_back({file, lastWrite});
+    std::error_code error;
+    auto size = std::filesystem::file_size(fullPath, error);
+    if (error) {
+        return false;
     }
     
-    // Ordenar por tiempo (mÃ¡s antiguos primero)
-    std::sort(filesWithTime.begin(), filesWithTime.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second < b.second;
-              });
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(nullptr, 0);
+    file.open(fullPath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<std::size_t>(size));
+    file.read(data.data(), static_cast<std::streamsize>(size));
+    return file.gcount() == static_cast<std::streamsize>(size);
+}
+
+bool FileManager::findReference(const std::string& filename, std::uint64_t& key, std::uint32_t& variant) const {
+    // Sin posiciones guardadas no puede haber referencias: no se lee nada
+    if (!blobs->hasPositions()) {
+        return false;
+    }
+    std::vector<char> data;
+    return readRaw(filename, data) && SaveBlobs::parseReference(data.data(), data.size(), key, variant);
+}
+
+// OPTIMIZACIÃ“N DE MEMORIA - Limpiar archivos antiguos
+void FileManager::cleanOldSaves() {
+    MetricTimer timer(METRIC_CLEANUP_LATENCY);
+    TRIKI_COUNT(METRIC_CLEANUPS, 1);
+    
+    // Fecha de cada partida: de memoria, sin llamadas al sistema
+    auto filesWithTime = listEntries();
+    
+    if (filesWithTime.size() <= static_cast<size_t>(maxSavedFiles)) {
+        TRIKI_INFO(LOG_IO, "No hay archivos que limpiar ("
+                   << filesWithTime.size() << "/" << maxSavedFiles << ")");
+        return;
+    }
+    
+    // Monticulo de minimos por fecha: solo se extraen los que sobran,
+    // sin ordenar la lista completa
+    auto newer = [](const SaveStore::Entry& a, const SaveStore::Entry& b) {
+        return a.modified > b.modified;
+    };
+    std::make_heap(filesWithTime.begin(), filesWithTime.end(), newer);
     
     // Eliminar archivos mÃ¡s antiguos
-    int filesToDelete = gameFiles.size() - maxSavedFiles;
+    int filesToDelete = filesWithTime.size() - maxSavedFiles;
     for (int i = 0; i < filesToDelete; i++) {
-        deleteGame(filesWithTime[i].first);
+        std::pop_heap(filesWithTime.begin(), filesWithTime.end(), newer);
+        if (deleteGame(filesWithTime.back().name)) {
+            TRIKI_COUNT(METRIC_CLEANUP_DELETIONS, 1);
+        }
+        filesWithTime.pop_back();
     }
     
-    std::cout << "[INFO] Limpieza completada. Eliminados: " << filesToDelete 
-              << " archivos antiguos" << std::endl;
+    TRIKI_INFO(LOG_IO, "Limpieza completada. Eliminados: " << filesToDelete
+               << " archivos antiguos");
 }
 
-// MOSTRAR INFORMACIÃ“N DEL DIRECTORIO
-void FileManager::showDirectoryInfo() const {
-    std::cout << "\n=== INFORMACIÃ“N DEL FILEMANAGER ===" << std::endl;
-    std::cout << "Directorio de guardado: " << *saveDirectory << std::endl;
-    std::cout << "DirecciÃ³n del puntero: " << (void*)saveDirectory << std::endl;
-    std::cout << "MÃ¡ximo archivos permitidos: " << maxSavedFiles << std::endl;
-    
-    auto files = listSavedGames();
-    std::cout << "Archivos encontrados: " << files.size() << std::endl;
+// INFORMACION DEL DIRECTORIO - solo datos: la consola decide como mostrarlos
+FileManager::DirectoryInfo FileManager::getDirectoryInfo() const {
+    DirectoryInfo info;
+    info.directory = *saveDirectory;
+    info.directoryAddress = saveDirectory;
+    info.maxSavedFiles = maxSavedFiles;
+    info.packed = store != nullptr;
+    if (store) {
+        info.storeCount = store->getCount();
+        info.storeCapacity = store->getCapacity();
+        info.storeBytes = store->getFileBytes();
+    }
+    info.hasPositions = blobs->hasPositions();
+    info.contentAddressed = blobs->isEnabled();
+    if (info.hasPositions) {
+        info.positions = blobs->summarize();
+    }
     
-    for (const auto& file : files) {
-        std::string fullPath = *saveDirectory + "/" + file;
-        auto fileSize = std::filesystem::file_size(fullPath);
-        std::cout << "  - " << file << " (" << fileSize << " bytes)" << std::endl;
+    info.files = listEntries();
+    std::sort(info.files.begin(), info.files.end(),
+              [](const auto& a, const auto& b) { return a.name < b.name; });
+    return info;
+}
+
+// NOMBRE, TAMANO Y FECHA DE CADA PARTIDA
+std::vector<SaveStore::Entry> FileManager::listEntries() const {
+    if (store) {
+        return store->list();
     }
-    std::cout << "==================================\n" << std::endl;
+    
+    return index->list();
 }
 
 // GETTERS Y SETTERS
+bool FileManager::isPacked() const {
+    return store != nullptr;
+}
+
+void FileManager::setContentAddressed(bool enabled) {
+    blobs->setEnabled(enabled);
+}
+
+bool FileManager::isContentAddressed() const {
+    return blobs->isEnabled();
+}
+
+std::shared_ptr<SaveStore> FileManager::getStore() const {
+    return store;
+}
+
 std::string FileManager::getSaveDirectory() const {
     return *saveDirectory;  // Desreferenciar el puntero
 }
@@ -188,6 +382,7 @@ std::string FileManager::getSaveDirectory() const {
 void FileManager::setSaveDirectory(const std::string& newDir) {
     *saveDirectory = newDir;  // Asignar nuevo valor al contenido del puntero
     createDirectoryIfNotExists(newDir);
+    openStorage();
 }
 
 int FileManager::getMaxSavedFiles() const {
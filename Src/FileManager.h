@@ -1,23 +1,45 @@
 #ifndef FILEMANAGER_H
 #define FILEMANAGER_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
+#include "SaveBlobs.h"
+#include "SaveIndex.h"
+#include "SaveStorage.h"
+#include "SaveStore.h"
 
-class FileManager {
+// Implementacion de disco de SaveStorage: directorio "saves" por defecto
+class FileManager : public SaveStorage {
 private:
     // PUNTERO DINAMICO - Demuestra uso de memoria heap
     std::string* saveDirectory;  // Directorio donde se guardan las partidas
     int maxSavedFiles;          // Limite de archivos guardados
     
+    // Almacen empaquetado del directorio (compartido por todas las instancias).
+    // nullptr: se usa un archivo por partida, como antes
+    std::shared_ptr<SaveStore> store;
+    // Sin almacen: nombres, tamanos y fechas en memoria, al dia con inotify
+    std::shared_ptr<SaveIndex> index;
+    // Posiciones compartidas del guardado por contenido (siempre abierto:
+    // las referencias se leen y se borran aunque el modo este apagado)
+    std::shared_ptr<SaveBlobs> blobs;
+    
     // METODO PRIVADO - Helper function
     bool createDirectoryIfNotExists(const std::string& path);
+    void openStorage();
+    bool writeRaw(const std::string& filename, const std::vector<char>& data);
+    bool readRaw(const std::string& filename, std::vector<char>& data) const;
+    // Clave y variante si 'filename' es hoy una referencia a una posicion
+    bool findReference(const std::string& filename, std::uint64_t& key, std::uint32_t& variant) const;
+    std::vector<SaveStore::Entry> listEntries() const;  // Nombre, tamano y fecha de cada partida
     
 public:
     // CONSTRUCTOR Y DESTRUCTOR - Manejo de memoria dinamica
     FileManager();
     FileManager(const std::string& customDir);  // Constructor con directorio personalizado
-    ~FileManager();
+    ~FileManager() override;
     
     // CONSTRUCTOR COPIA Y OPERADOR ASIGNACION (Regla de los 3)
     FileManager(const FileManager& other);
@@ -28,11 +50,46 @@ public:
     bool fileExists(const std::string& filename) const;
     bool deleteGame(const std::string& filename);
     
+    // LECTURA Y ESCRITURA DE PARTIDAS COMPLETAS
+    // Escritura atomica: en el almacen la casilla nueva se publica entera
+    // antes de liberar la vieja; sin almacen el contenido va a un temporal y
+    // se renombra sobre el destino. Un corte nunca deja una partida a medias
+    bool writeSaveFile(const std::string& filename, const std::vector<char>& data);
+    // Con el guardado por contenido activo, 'data' va a la posicion
+    // compartida de clave 'positionKey' y el nombre queda como referencia
+    bool writeSaveFile(const std::string& filename, const std::vector<char>& data, std::uint64_t positionKey) override;
+    bool readSaveFile(const std::string& filename, std::vector<char>& data) const override;  // Resuelve referencias
+    // Tanda de partidas (ejecutor de E/S): en el almacen, un solo candado.
+    // positionKeys puede ir vacio (sin guardado por contenido)
+    void writeSaveFiles(const std::vector<std::string>& filenames, const std::vector<std::vector<char>>& contents,
+                        const std::vector<std::uint64_t>& positionKeys, std::vector<bool>& results) override;
+    
     // OPTIMIZACION DE MEMORIA
-    void cleanOldSaves();  // Elimina archivos antiguos si superan el limite
-    void showDirectoryInfo() const;  // Muestra info del directorio y archivos
+    void cleanOldSaves();  // Elimina los mas antiguos si superan el limite (monticulo por fecha)
+    
+    // Estado del directorio para el menu (lo imprime showDirectoryInfo de Console.h)
+    struct DirectoryInfo {
+        std::string directory;
+        const void* directoryAddress;  // El puntero dinamico al nombre
+        int maxSavedFiles;
+        bool packed;
+        int storeCount = 0;
+        int storeCapacity = 0;
+        std::size_t storeBytes = 0;
+        bool hasPositions;
+        bool contentAddressed;
+        SaveBlobs::Summary positions;
+        std::vector<SaveStore::Entry> files;  // Ordenadas por nombre
+    };
+    DirectoryInfo getDirectoryInfo() const;
     
     // GETTERS Y SETTERS
+    bool isPacked() const;  // true si las partidas van al almacen empaquetado
+    // Guardado por contenido: partidas iguales comparten un archivo en
+    // <directorio>/posiciones (ver SaveBlobs.h). Vale para todo el directorio
+    void setContentAddressed(bool enabled);
+    bool isContentAddressed() const;
+    std::shared_ptr<SaveStore> getStore() const;  // nullptr sin almacen
     std::string getSaveDirectory() const;
     void setSaveDirectory(const std::string& newDir);
     int getMaxSavedFiles() const;
@@ -41,6 +98,9 @@ public:
     // METODOS ESTATICOS - No necesitan instancia de la clase
     static bool isValidFilename(const std::string& filename);
     static std::string getCurrentTimestamp();  // Para nombres de archivo unicos
+    // Directorio "saves" del proceso: lo usan saveGame/loadGame (y sus
+    // versiones asincronas) cuando no reciben 'storage'
+    static FileManager& shared();
 };
 
 #endif
\ No newline at end of file
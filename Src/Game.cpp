@@ -1,40 +1,49 @@
 #include "Game.h"
-#include <iostream>
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include "FileManager.h" 
+#include "Logger.h"
+#include "Metrics.h"
+#include "PerfectTable.h"
+#include "SaveExecutor.h"
+#include "SaveFormat.h"
+#include "Tablebase.h"
 
-// Constructor - aloca memoria en el heap
-Game::Game() {
-    boardSize = 9;  // 3x3 = 9 posiciones
-    board = new char[boardSize];  // Memoria dinámica en heap
-    
-    // Inicializar todas las posiciones del tablero
-    for (int i = 0; i < boardSize; i++) {
-        board[i] = ' ';
-    }
+// Constructor - el tablero vive dentro del objeto como dos bitboards
+template <int Rows, int Cols, int K>
+BasicGame<Rows, Cols, K>::BasicGame() {
+    boardSize = Rows * Cols;  // 3x3 = 9 posiciones
+    board.clear();            // Ninguna casilla ocupada
+    historyLength = 0;
+    std::memset(lineCounts, 0, sizeof(lineCounts));
+    completedLines[0] = completedLines[1] = 0;
+    hash = 0;  // Tablero vacio y turno de 'X'
     
     currentPlayer = 'X';
     gameEnded = false;
     winner = ' ';
     
-    std::cout << "[DEBUG] Memoria alocada para tablero: " << boardSize << " bytes\n";
+    TRIKI_DEBUG(LOG_MEMORY, "Tablero " << Rows << "x" << Cols << " (k=" << K << ") inicializado: "
+                << sizeof(board) << " bytes de bitboards");
 }
 
-// Destructor - libera memoria del heap
-Game::~Game() {
-    delete[] board;
-    std::cout << "[DEBUG] Memoria liberada del tablero\n";
+// Destructor - ya no hay memoria en heap que liberar
+template <int Rows, int Cols, int K>
+BasicGame<Rows, Cols, K>::~BasicGame() {
+    TRIKI_DEBUG(LOG_MEMORY, "Tablero destruido");
 }
 
 // Constructor copia (Regla de los 3)
-Game::Game(const Game& other) {
+template <int Rows, int Cols, int K>
+BasicGame<Rows, Cols, K>::BasicGame(const BasicGame& other) {
     boardSize = other.boardSize;
-    board = new char[boardSize];  // Nueva memoria
-    
-    // Copiar contenido
-    for (int i = 0; i < boardSize; i++) {
-        board[i] = other.board[i];
-    }
+    board = other.board;  // Copiar el tablero es copiar los bitboards
+    historyLength = other.historyLength;
+    std::copy(other.history, other.history + other.historyLength, history);
+    std::memcpy(lineCounts, other.lineCounts, sizeof(lineCounts));
+    completedLines[0] = other.completedLines[0];
+    completedLines[1] = other.completedLines[1];
+    hash = other.hash;
     
     currentPlayer = other.currentPlayer;
     gameEnded = other.gameEnded;
@@ -42,19 +51,17 @@ Game::Game(const Game& other) {
 }
 
 // Operador de asignación (Regla de los 3)
-Game& Game::operator=(const Game& other) {
+template <int Rows, int Cols, int K>
+BasicGame<Rows, Cols, K>& BasicGame<Rows, Cols, K>::operator=(const BasicGame& other) {
     if (this != &other) {  // Evitar auto-asignación
-        // Liberar memoria actual
-        delete[] board;
-        
-        // Alocar nueva memoria
         boardSize = other.boardSize;
-        board = new char[boardSize];
-        
-        // Copiar contenido
-        for (int i = 0; i < boardSize; i++) {
-            board[i] = other.board[i];
-        }
+        board = other.board;
+        historyLength = other.historyLength;
+        std::copy(other.history, other.history + other.historyLength, history);
+        std::memcpy(lineCounts, other.lineCounts, sizeof(lineCounts));
+        completedLines[0] = other.completedLines[0];
+        completedLines[1] = other.completedLines[1];
+        hash = other.hash;
         
         currentPlayer = other.currentPlayer;
         gameEnded = other.gameEnded;
@@ -64,316 +71,562 @@ Game& Game::operator=(const Game& other) {
 }
 
 // Función helper: convierte (fila, columna) a índice lineal
-int Game::getIndex(int row, int col) const {
-    return row * 3 + col;  // Fórmula: fila*ancho + columna
-}
-
-void Game::displayBoard() const {
-    std::cout << "\n  0   1   2\n";
-    for (int row = 0; row < 3; row++) {
-        std::cout << row << " ";
-        for (int col = 0; col < 3; col++) {
-            int index = getIndex(row, col);
-            std::cout << board[index];
-            if (col < 2) std::cout << " | ";
-        }
-        std::cout << "\n";
-        if (row < 2) std::cout << "  ---------\n";
+template <int Rows, int Cols, int K>
+int BasicGame<Rows, Cols, K>::getIndex(int row, int col) const {
+    return row * Cols + col;  // Fórmula: fila*ancho + columna
+}
+
+// Contadores por linea: una jugada solo toca las lineas que pasan por su
+// casilla (a lo sumo 4*K, 4 en las esquinas del 3x3)
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::updateLines(int cell, int player, int delta) {
+    const auto& tables = BoardType::TABLES;
+    for (int i = 0; i < tables.cellLineCount[cell]; i++) {
+        unsigned char& count = lineCounts[player][tables.cellLines[cell][i]];
+        if (delta < 0 && count == K) completedLines[player]--;
+        count = static_cast<unsigned char>(count + delta);
+        if (delta > 0 && count == K) completedLines[player]++;
     }
-    std::cout << "\n";
 }
 
-bool Game::makeMove(int row, int col) {
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::makeMove(int row, int col) {
+    TRIKI_COUNT(METRIC_MAKE_MOVES, 1);
+    
     // Validar posición
-    if (row < 0 || row > 2 || col < 0 || col > 2) {
+    if (!BoardType::isInside(row, col)) {
         return false;
     }
     
     int index = getIndex(row, col);
     
     // Verificar si la posición está ocupada
-    if (board[index] != ' ') {
+    if (!board.isEmpty(index)) {
         return false;
     }
     
-    // Hacer el movimiento
-    board[index] = currentPlayer;
+    // Hacer el movimiento y anotarlo en el historial. Si es la jugada que
+    // seguia (deshecha antes) se conserva el resto para rehacerlo.
+    const int count = board.moveCount();
+    if (historyLength <= count || history[count] != index) {
+        history[count] = static_cast<unsigned char>(index);
+        historyLength = count + 1;
+    }
+    int player = playerIndex(currentPlayer);
+    board.play(index, player);
+    updateLines(index, player, +1);
+    hash ^= ZOBRIST<Rows * Cols>.cells[player][index];
     return true;
 }
 
-bool Game::checkWinner() {
-    // Verificar filas
-    for (int row = 0; row < 3; row++) {
-        if (board[getIndex(row, 0)] != ' ' && 
-            board[getIndex(row, 0)] == board[getIndex(row, 1)] && 
-            board[getIndex(row, 1)] == board[getIndex(row, 2)]) {
-            winner = board[getIndex(row, 0)];
-            gameEnded = true;
-            return true;
-        }
-    }
-    
-    // Verificar columnas
-    for (int col = 0; col < 3; col++) {
-        if (board[getIndex(0, col)] != ' ' && 
-            board[getIndex(0, col)] == board[getIndex(1, col)] && 
-            board[getIndex(1, col)] == board[getIndex(2, col)]) {
-            winner = board[getIndex(0, col)];
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::checkWinner() {
+    TRIKI_COUNT(METRIC_WINNER_CHECKS, 1);
+    
+    // Los contadores ya dicen si algun jugador completo una linea: no hace
+    // falta recorrer el tablero
+    for (int player = 0; player < 2; player++) {
+        if (completedLines[player] > 0) {
+            winner = playerSymbol(player);
             gameEnded = true;
             return true;
         }
     }
     
-    // Verificar diagonal principal (0,0 -> 1,1 -> 2,2)
-    if (board[getIndex(0, 0)] != ' ' && 
-        board[getIndex(0, 0)] == board[getIndex(1, 1)] && 
-        board[getIndex(1, 1)] == board[getIndex(2, 2)]) {
-        winner = board[getIndex(0, 0)];
-        gameEnded = true;
-        return true;
-    }
-    
-    // Verificar diagonal secundaria (0,2 -> 1,1 -> 2,0)
-    if (board[getIndex(0, 2)] != ' ' && 
-        board[getIndex(0, 2)] == board[getIndex(1, 1)] && 
-        board[getIndex(1, 1)] == board[getIndex(2, 0)]) {
-        winner = board[getIndex(0, 2)];
-        gameEnded = true;
-        return true;
-    }
-    
     return false;
 }
 
-bool Game::isBoardFull() const {
-    for (int i = 0; i < boardSize; i++) {
-        if (board[i] == ' ') {
-            return false;
-        }
-    }
-    return true;
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::isBoardFull() const {
+    // Una sola comparacion contra la mascara del tablero lleno
+    return board.isFull();
 }
 
-void Game::switchPlayer() {
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::switchPlayer() {
     currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
+    hash ^= ZOBRIST<Rows * Cols>.sideToMove;
 }
 
-void Game::resetGame() {
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::resetGame() {
     // Reinicializar tablero
-    for (int i = 0; i < boardSize; i++) {
-        board[i] = ' ';
-    }
+    board.clear();
+    historyLength = 0;
+    std::memset(lineCounts, 0, sizeof(lineCounts));
+    completedLines[0] = completedLines[1] = 0;
+    hash = 0;
     
     currentPlayer = 'X';
     gameEnded = false;
     winner = ' ';
 }
 
-char Game::getCurrentPlayer() const {
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::playTurn(int row, int col) {
+    if (gameEnded || !makeMove(row, col)) {
+        return false;
+    }
+    
+    finishTurn();
+    if (moveListener) {
+        moveListener(*this, getIndex(row, col));
+    }
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::finishTurn() {
+    if (!checkWinner()) {
+        if (isBoardFull()) {
+            gameEnded = true;  // Empate: winner sigue en ' '
+        } else {
+            switchPlayer();
+        }
+    }
+}
+
+// DESHACER - quita la ultima ficha y le devuelve el turno a su dueño; la
+// jugada queda en el historial para rehacerla
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::undoMove() {
+    const int count = board.moveCount();
+    if (count == 0) {
+        return false;
+    }
+    int cell = history[count - 1];
+    int player = board.owner(cell);
+    updateLines(cell, player, -1);
+    board.unplay(cell, player);
+    hash ^= ZOBRIST<Rows * Cols>.cells[player][cell];
+    
+    if (currentPlayer != playerSymbol(player)) {
+        switchPlayer();
+    }
+    gameEnded = false;
+    winner = ' ';
+    checkWinner();  // Solo si ya habia una linea antes de esa jugada
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::redoMove() {
+    const int count = board.moveCount();
+    if (gameEnded || count >= historyLength) {
+        return false;
+    }
+    makeMove(history[count] / Cols, history[count] % Cols);
+    finishTurn();
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+int BasicGame<Rows, Cols, K>::getRedoCount() const {
+    return historyLength - board.moveCount();
+}
+
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::setMoveListener(const MoveListener& listener) {
+    moveListener = listener;
+}
+
+template <int Rows, int Cols, int K>
+char BasicGame<Rows, Cols, K>::getCurrentPlayer() const {
     return currentPlayer;
 }
 
-char Game::getWinner() const {
+template <int Rows, int Cols, int K>
+char BasicGame<Rows, Cols, K>::getWinner() const {
     return winner;
 }
 
-bool Game::isGameEnded() const {
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::isGameEnded() const {
     return gameEnded;
 }
 
-char Game::getCellValue(int row, int col) const {
-    if (row >= 0 && row < 3 && col >= 0 && col < 3) {
-        return board[getIndex(row, col)];
+template <int Rows, int Cols, int K>
+char BasicGame<Rows, Cols, K>::getCellValue(int row, int col) const {
+    if (BoardType::isInside(row, col)) {
+        int owner = board.owner(getIndex(row, col));
+        if (owner >= 0) return playerSymbol(owner);
     }
     return ' ';
 }
 
-void Game::playGame() {
-    int row, col;
-    
-    std::cout << "=== JUEGO DE TRIKI (con manejo de memoria) ===\n";
-    std::cout << "Coordenadas: fila columna (0-2)\n";
-    showMemoryInfo();  // Mostrar info de memoria
-    
-    while (!gameEnded) {
-        displayBoard();
-        
-        std::cout << "Turno del jugador " << currentPlayer << "\n";
-        std::cout << "Ingresa fila y columna: ";
-        
-        std::cin >> row >> col;
+template <int Rows, int Cols, int K>
+const typename BasicGame<Rows, Cols, K>::BoardType& BasicGame<Rows, Cols, K>::getBoard() const {
+    return board;
+}
+
+template <int Rows, int Cols, int K>
+int BasicGame<Rows, Cols, K>::getMoveCount() const {
+    return board.moveCount();
+}
+
+template <int Rows, int Cols, int K>
+int BasicGame<Rows, Cols, K>::getMove(int index) const {
+    return (index >= 0 && index < board.moveCount()) ? history[index] : -1;
+}
+
+template <int Rows, int Cols, int K>
+std::uint64_t BasicGame<Rows, Cols, K>::getHash() const {
+    return hash;
+}
+
+template <int Rows, int Cols, int K>
+int BasicGame<Rows, Cols, K>::getBestMove() const {
+    if constexpr (Rows == 3 && Cols == 3 && K == 3) {
+        return PerfectTable::bestMove(board);
+    } else if constexpr (Rows * Cols <= 32) {
+        const auto* table = Tablebase<Rows, Cols, K>::shared();
+        return table ? table->bestMove(board) : -1;
+    } else {
+        return -1;
+    }
+}
+
+template <int Rows, int Cols, int K>
+char BasicGame<Rows, Cols, K>::getPerfectPlayWinner() const {
+    if constexpr (Rows == 3 && Cols == 3 && K == 3) {
+        return PerfectTable::perfectPlayWinner(board);
+    } else if constexpr (Rows * Cols <= 32) {
+        using Table = Tablebase<Rows, Cols, K>;
+        const Table* table = Table::shared();
+        typename Table::Value value = table ? table->value(board) : Table::INVALID;
+        if (value == Table::INVALID) return '?';
+        if (value == Table::DRAW) return ' ';
+        char mover = playerSymbol(board.moveCount() & 1);
+        return value == Table::WIN ? mover : (mover == 'X' ? 'O' : 'X');
+    } else {
+        return '?';
+    }
+}
+
+template <int Rows, int Cols, int K>
+std::vector<char> BasicGame<Rows, Cols, K>::serialize() const {
+    const int count = board.moveCount();
+    std::vector<char> data(SAVE_HEADER_BYTES + count + SAVE_CHECKSUM_BYTES);
+    
+    // Cabecera, jugadas y CRC se escriben avanzando un puntero sobre el buffer
+    unsigned char* begin = reinterpret_cast<unsigned char*>(data.data());
+    unsigned char* out = begin;
+    std::memcpy(out, SAVE_MAGIC, sizeof(SAVE_MAGIC));
+    out += sizeof(SAVE_MAGIC);
+    *out++ = SAVE_VERSION;
+    *out++ = Rows;
+    *out++ = Cols;
+    *out++ = K;
+    *out++ = static_cast<unsigned char>(currentPlayer);
+    *out++ = gameEnded ? 1 : 0;
+    *out++ = static_cast<unsigned char>(winner);
+    *out++ = 0;
+    writeLittleEndian(out, static_cast<std::uint32_t>(count), 2);
+    out += 2;
+    
+    std::memcpy(out, history, count);
+    out += count;
+    
+    writeLittleEndian(out, crc32(begin, out - begin), SAVE_CHECKSUM_BYTES);
+    return data;
+}
+
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::deserialize(const std::vector<char>& data) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t size = data.size();
+    
+    unsigned char moves[Rows * Cols];
+    int count = 0;
+    char savedPlayer, savedWinner;
+    bool savedEnded;
+    
+    if (size >= SAVE_HEADER_BYTES + SAVE_CHECKSUM_BYTES &&
+        std::memcmp(in, SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0) {
+        // VERSION 2: cabecera, tamaño exacto y CRC antes de mirar las jugadas
+        count = static_cast<int>(readLittleEndian(in + 12, 2));
+        if (in[4] != SAVE_VERSION || in[5] != Rows || in[6] != Cols || in[7] != K ||
+            count > Rows * Cols || size != static_cast<std::size_t>(SAVE_HEADER_BYTES + count + SAVE_CHECKSUM_BYTES)) {
+            return false;
+        }
+        const std::size_t crcOffset = SAVE_HEADER_BYTES + count;
+        if (crc32(in, crcOffset) != readLittleEndian(in + crcOffset, SAVE_CHECKSUM_BYTES)) {
+            return false;
+        }
+        std::memcpy(moves, in + SAVE_HEADER_BYTES, count);
+        savedPlayer = static_cast<char>(in[8]);
+        savedEnded = in[9] != 0;
+        savedWinner = static_cast<char>(in[10]);
+    } else if (size == static_cast<std::size_t>(boardSize + 3)) {
+        // VERSION 1: casillas sueltas, sin orden de jugadas
+        BoardType cells;
+        for (int i = 0; i < boardSize; i++) {
+            char cell = static_cast<char>(in[i]);
+            if (cell == 'X' || cell == 'O') {
+                cells.play(i, playerIndex(cell));
+            } else if (cell != ' ') {
+                return false;
+            }
+        }
+        savedPlayer = static_cast<char>(in[boardSize]);
+        savedEnded = in[boardSize + 1] != 0;
+        savedWinner = static_cast<char>(in[boardSize + 2]);
         
-        if (makeMove(row, col)) {
-            if (checkWinner()) {
-                displayBoard();
-                std::cout << "¡Jugador " << winner << " gana!\n";
-                break;
-            } else if (isBoardFull()) {
-                displayBoard();
-                std::cout << "¡Empate!\n";
-                gameEnded = true;
-                break;
+        // Se reconstruye un orden alternando X y O. Si hubo ganador, su
+        // ultima ficha debe ser una que complete todas sus lineas.
+        int lastCell = -1;
+        if (savedWinner == 'X' || savedWinner == 'O') {
+            int p = playerIndex(savedWinner);
+            for (int cell = 0; cell < boardSize && lastCell < 0; cell++) {
+                if (cells.owner(cell) != p) continue;
+                cells.unplay(cell, p);
+                if (!cells.hasLine(p)) lastCell = cell;
+                cells.play(cell, p);
             }
-            switchPlayer();
-        } else {
-            std::cout << "Movimiento inválido. Intenta de nuevo.\n";
+            if (lastCell < 0) return false;
+        }
+        unsigned char ordered[2][Rows * Cols];
+        int counts[2] = {0, 0};
+        for (int cell = 0; cell < boardSize; cell++) {
+            int p = cells.owner(cell);
+            if (p >= 0 && cell != lastCell) ordered[p][counts[p]++] = static_cast<unsigned char>(cell);
+        }
+        if (lastCell >= 0) {
+            int p = cells.owner(lastCell);
+            ordered[p][counts[p]++] = static_cast<unsigned char>(lastCell);
+        }
+        if (counts[0] != counts[1] && counts[0] != counts[1] + 1) {
+            return false;  // X siempre empieza
+        }
+        count = counts[0] + counts[1];
+        for (int turn = 0; turn < count; turn++) {
+            moves[turn] = ordered[turn & 1][turn >> 1];
+        }
+    } else {
+        return false;
+    }
+    
+    // Reproducir las jugadas: el estado guardado debe coincidir
+    BasicGame loaded(*this);
+    loaded.resetGame();
+    for (int i = 0; i < count; i++) {
+        if (moves[i] >= boardSize || !loaded.playTurn(moves[i] / Cols, moves[i] % Cols)) {
+            return false;
         }
     }
+    if (loaded.currentPlayer != savedPlayer || loaded.gameEnded != savedEnded || loaded.winner != savedWinner) {
+        return false;
+    }
+    
+    *this = loaded;
+    return true;
+}
+
+namespace {
+
+// Almacenamiento de saveGame/loadGame sin argumento: el directorio "saves"
+FileManager& defaultStorage() {
+    return FileManager::shared();
+}
+
+}
+
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::saveGame(const std::string& filename) const {
+    return saveGame(filename, defaultStorage());
 }
 
-bool Game::saveGame(const std::string& filename) const {
-    // Crear instancia de FileManager
-    FileManager fileManager;
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::saveGame(const std::string& filename, SaveStorage& storage) const {
+    MetricTimer timer(METRIC_SAVE_LATENCY);
     
     // Validar nombre del archivo
     if (!FileManager::isValidFilename(filename)) {
-        std::cout << "[ERROR] Nombre de archivo inválido: " << filename << std::endl;
+        TRIKI_ERROR(LOG_IO, "Nombre de archivo inválido: " << filename);
+        TRIKI_COUNT(METRIC_SAVE_ERRORS, 1);
         return false;
     }
     
     // Agregar extension si no la tiene
-    std::string fullFilename = filename;
-    if (fullFilename.find(".triki") == std::string::npos) {
-        fullFilename += ".triki";
-    }
+    std::string fullFilename = withExtension(filename);
     
-    // Crear ruta completa
-    std::string fullPath = fileManager.getSaveDirectory() + "/" + fullFilename;
+    TRIKI_DEBUG(LOG_IO, "=== GUARDANDO PARTIDA (formato v" << SAVE_VERSION << ") ===");
     
-    // Abrir archivo binario para escritura
-    std::ofstream file(fullPath, std::ios::binary);
+    // Toda la partida se arma en memoria y sale en una sola escritura
+    std::vector<char> data = serialize();
+    TRIKI_DEBUG(LOG_MEMORY, "Buffer de " << data.size() << " bytes en " << (void*)data.data()
+                << " (" << board.moveCount() << " jugadas)");
     
-    if (!file.is_open()) {
-        std::cout << "[ERROR] No se pudo crear el archivo: " << fullPath << std::endl;
+    if (!storage.writeSaveFile(fullFilename, data, hash)) {
+        TRIKI_ERROR(LOG_IO, "No se pudo crear el archivo: " << fullFilename);
+        TRIKI_COUNT(METRIC_SAVE_ERRORS, 1);
         return false;
     }
     
-    std::cout << "\n=== GUARDANDO PARTIDA CON PUNTEROS ===" << std::endl;
-    
-    // USO DE PUNTEROS EXPLICITO:
-    // 1. Puntero al tablero (ya lo tenemos)
-    char* boardPtr = board;
-    std::cout << "Direccion del tablero: " << (void*)boardPtr << std::endl;
-    
-    // 2. Punteros a las variables de estado
-    const char* playerPtr = &currentPlayer;
-    const bool* gameEndedPtr = &gameEnded;
-    const char* winnerPtr = &winner;
-    
-    std::cout << "Direccion currentPlayer: " << (void*)playerPtr << std::endl;
-    std::cout << "Direccion gameEnded: " << (void*)gameEndedPtr << std::endl;
-    std::cout << "Direccion winner: " << (void*)winnerPtr << std::endl;
-    
-    // ESCRITURA USANDO ARITMETICA DE PUNTEROS:
-    // Escribir tablero byte por byte
-    for (int i = 0; i < boardSize; i++) {
-        char* currentPos = boardPtr + i;  // Aritmética de punteros
-        file.write(currentPos, sizeof(char));
-        std::cout << "Escribiendo posicion [" << i << "]: '" 
-                  << *currentPos << "' desde " << (void*)currentPos << std::endl;
-    }
-    
-    // Escribir estado usando punteros
-    file.write(playerPtr, sizeof(char));
-    file.write(reinterpret_cast<const char*>(gameEndedPtr), sizeof(bool));
-    file.write(winnerPtr, sizeof(char));
-    
-    file.close();
-    
-    std::cout << "Partida guardada exitosamente: " << fullFilename << std::endl;
-    std::cout << "====================================\n" << std::endl;
-    
-    // Mostrar información del directorio
-    fileManager.showDirectoryInfo();
-    
+    TRIKI_COUNT(METRIC_SAVES, 1);
+    TRIKI_COUNT(METRIC_SAVE_BYTES, data.size());
+    TRIKI_INFO(LOG_IO, "Partida guardada exitosamente: " << fullFilename);
     return true;
 }
 
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::loadGame(const std::string& filename) {
+    return loadGame(filename, defaultStorage());
+}
 
-// Implementar loadGame() en Game.cpp
-bool Game::loadGame(const std::string& filename) {
-    // Crear instancia de FileManager
-    FileManager fileManager;
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::loadGame(const std::string& filename, const SaveStorage& storage) {
+    MetricTimer timer(METRIC_LOAD_LATENCY);
     
     // Validar nombre del archivo
     if (!FileManager::isValidFilename(filename)) {
-        std::cout << "[ERROR] Nombre de archivo invalido: " << filename << std::endl;
+        TRIKI_ERROR(LOG_IO, "Nombre de archivo invalido: " << filename);
+        TRIKI_COUNT(METRIC_LOAD_ERRORS, 1);
         return false;
     }
     
     // Agregar extension si no la tiene
-    std::string fullFilename = filename;
-    if (fullFilename.find(".triki") == std::string::npos) {
-        fullFilename += ".triki";
-    }
+    std::string fullFilename = withExtension(filename);
     
-    // Verificar que el archivo existe
-    if (!fileManager.fileExists(fullFilename)) {
-        std::cout << "[ERROR] Archivo no encontrado: " << fullFilename << std::endl;
+    // Leer el archivo completo de una vez
+    std::vector<char> data;
+    if (!storage.readSaveFile(fullFilename, data)) {
+        TRIKI_ERROR(LOG_IO, "Archivo no encontrado: " << fullFilename);
+        TRIKI_COUNT(METRIC_LOAD_ERRORS, 1);
         return false;
     }
     
-    // Crear ruta completa
-    std::string fullPath = fileManager.getSaveDirectory() + "/" + fullFilename;
-    
-    // Abrir archivo binario para lectura
-    std::ifstream file(fullPath, std::ios::binary);
+    TRIKI_DEBUG(LOG_IO, "=== CARGANDO PARTIDA ===");
+    TRIKI_DEBUG(LOG_MEMORY, "Leidos " << data.size() << " bytes en " << (void*)data.data());
     
-    if (!file.is_open()) {
-        std::cout << "[ERROR] No se pudo abrir el archivo: " << fullPath << std::endl;
+    if (!applyLoadedData(fullFilename, data)) {
+        TRIKI_ERROR(LOG_IO, "Archivo danado o de otro tablero (se esperaba " << Rows << "x" << Cols
+                    << "): " << fullFilename);
+        TRIKI_COUNT(METRIC_LOAD_ERRORS, 1);
         return false;
     }
     
-    std::cout << "\n=== CARGANDO PARTIDA CON PUNTEROS ===" << std::endl;
-    
-    // USO DE PUNTEROS EXPLICITO PARA LECTURA:
-    // 1. Puntero al tablero para lectura byte por byte
-    char* boardPtr = board;
-    std::cout << "Direccion del tablero para lectura: " << (void*)boardPtr << std::endl;
-    
-    // 2. Punteros a variables de estado
-    char* playerPtr = &currentPlayer;
-    bool* gameEndedPtr = &gameEnded;
-    char* winnerPtr = &winner;
-    
-    std::cout << "Direccion currentPlayer: " << (void*)playerPtr << std::endl;
-    std::cout << "Direccion gameEnded: " << (void*)gameEndedPtr << std::endl;
-    std::cout << "Direccion winner: " << (void*)winnerPtr << std::endl;
-    
-    // LECTURA USANDO ARITMETICA DE PUNTEROS:
-    // Leer tablero byte por byte
-    for (int i = 0; i < boardSize; i++) {
-        char* currentPos = boardPtr + i;  // Aritmetica de punteros
-        file.read(currentPos, sizeof(char));
-        std::cout << "Leyendo posicion [" << i << "]: '" 
-                  << *currentPos << "' en direccion " << (void*)currentPos << std::endl;
+    TRIKI_COUNT(METRIC_LOADS, 1);
+    TRIKI_COUNT(METRIC_LOAD_BYTES, data.size());
+    return true;
+}
+
+// Datos ya leidos -> partida, con los mensajes de carga
+template <int Rows, int Cols, int K>
+bool BasicGame<Rows, Cols, K>::applyLoadedData(const std::string& fullFilename, const std::vector<char>& data) {
+    if (!deserialize(data)) {
+        return false;
     }
-    
-    // Leer estado usando punteros
-    file.read(playerPtr, sizeof(char));
-    file.read(reinterpret_cast<char*>(gameEndedPtr), sizeof(bool));
-    file.read(winnerPtr, sizeof(char));
-    
-    file.close();
-    
-    std::cout << "Partida cargada exitosamente: " << fullFilename << std::endl;
-    std::cout << "Estado actual:" << std::endl;
-    std::cout << "  - Jugador actual: " << *playerPtr << std::endl;
-    std::cout << "  - Juego terminado: " << (*gameEndedPtr ? "Si" : "No") << std::endl;
-    std::cout << "  - Ganador: " << (*winnerPtr != ' ' ? std::string(1, *winnerPtr) : "Ninguno") << std::endl;
-    std::cout << "===================================\n" << std::endl;
-    
-    // Mostrar tablero cargado
-    displayBoard();
-    
+    TRIKI_INFO(LOG_IO, "Partida cargada exitosamente: " << fullFilename
+               << (data.size() == static_cast<std::size_t>(boardSize + 3) ? " (formato v1)" : ""));
+    TRIKI_INFO(LOG_GAME, "Estado actual: jugador " << currentPlayer
+               << ", terminado: " << (gameEnded ? "Si" : "No")
+               << ", ganador: " << (winner != ' ' ? std::string(1, winner) : "Ninguno")
+               << ", jugadas: " << board.moveCount());
     return true;
 }
 
-void Game::showMemoryInfo() const {
-    std::cout << "\n=== INFORMACIÓN DE MEMORIA ===\n";
-    std::cout << "Tablero en heap: " << (void*)board << "\n";
-    std::cout << "Tamaño del tablero: " << boardSize << " bytes\n";
-    std::cout << "Dirección de currentPlayer (stack): " << (void*)&currentPlayer << "\n";
-    std::cout << "Valor actual: " << currentPlayer << "\n";
-    std::cout << "===============================\n\n";
-}
\ No newline at end of file
+template <int Rows, int Cols, int K>
+std::string BasicGame<Rows, Cols, K>::withExtension(const std::string& filename) {
+    if (filename.find(".triki") == std::string::npos) {
+        return filename + ".triki";
+    }
+    return filename;
+}
+
+// GUARDADO ASINCRONO - la partida se serializa aqui (se puede seguir
+// jugando enseguida) y el disco queda a cargo del ejecutor de E/S
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::saveGameAsync(const std::string& filename, const std::function<void(bool)>& done) const {
+    saveGameAsync(filename, defaultStorage(), done);
+}
+
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::saveGameAsync(const std::string& filename, SaveStorage& storage,
+                                             const std::function<void(bool)>& done) const {
+    if (!FileManager::isValidFilename(filename)) {
+        TRIKI_ERROR(LOG_IO, "Nombre de archivo invalido: " << filename);
+        if (done) done(false);
+        return;
+    }
+    std::string fullFilename = withExtension(filename);
+    std::vector<char> data = serialize();
+    const std::size_t bytes = data.size();
+    const std::uint64_t start = Metrics::now();
+    SaveExecutor::shared().write(storage, fullFilename, std::move(data), hash, [fullFilename, done, bytes, start](bool ok) {
+        if constexpr (TRIKI_METRICS) {
+            Metrics::record(METRIC_SAVE_LATENCY, Metrics::now() - start);
+            Metrics::add(ok ? METRIC_SAVES : METRIC_SAVE_ERRORS);
+            if (ok) Metrics::add(METRIC_SAVE_BYTES, bytes);
+        }
+        if (ok) {
+            TRIKI_INFO(LOG_IO, "Partida guardada exitosamente: " << fullFilename);
+        }
+        if (done) done(ok);
+    });
+}
+
+template <int Rows, int Cols, int K>
+std::future<bool> BasicGame<Rows, Cols, K>::saveGameAsync(const std::string& filename) const {
+    return saveGameAsync(filename, defaultStorage());
+}
+
+template <int Rows, int Cols, int K>
+std::future<bool> BasicGame<Rows, Cols, K>::saveGameAsync(const std::string& filename, SaveStorage& storage) const {
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+    saveGameAsync(filename, storage, [promise](bool ok) { promise->set_value(ok); });
+    return result;
+}
+
+// CARGA ASINCRONA - la partida se modifica desde el hilo de E/S
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::loadGameAsync(const std::string& filename, const std::function<void(bool)>& done) {
+    loadGameAsync(filename, defaultStorage(), done);
+}
+
+template <int Rows, int Cols, int K>
+void BasicGame<Rows, Cols, K>::loadGameAsync(const std::string& filename, const SaveStorage& storage,
+                                             const std::function<void(bool)>& done) {
+    if (!FileManager::isValidFilename(filename)) {
+        TRIKI_ERROR(LOG_IO, "Nombre de archivo invalido: " << filename);
+        if (done) done(false);
+        return;
+    }
+    std::string fullFilename = withExtension(filename);
+    const std::uint64_t start = Metrics::now();
+    SaveExecutor::shared().read(storage, fullFilename, [this, fullFilename, done, start](bool ok, std::vector<char>& data) {
+        if (!ok) {
+            TRIKI_ERROR(LOG_IO, "Archivo no encontrado: " << fullFilename);
+        } else if (!applyLoadedData(fullFilename, data)) {
+            TRIKI_ERROR(LOG_IO, "Archivo danado o de otro tablero (se esperaba " << Rows << "x" << Cols
+                        << "): " << fullFilename);
+            ok = false;
+        }
+        if constexpr (TRIKI_METRICS) {
+            Metrics::record(METRIC_LOAD_LATENCY, Metrics::now() - start);
+            Metrics::add(ok ? METRIC_LOADS : METRIC_LOAD_ERRORS);
+            if (ok) Metrics::add(METRIC_LOAD_BYTES, data.size());
+        }
+        if (done) done(ok);
+    });
+}
+
+template <int Rows, int Cols, int K>
+std::future<bool> BasicGame<Rows, Cols, K>::loadGameAsync(const std::string& filename) {
+    return loadGameAsync(filename, defaultStorage());
+}
+
+template <int Rows, int Cols, int K>
+std::future<bool> BasicGame<Rows, Cols, K>::loadGameAsync(const std::string& filename, const SaveStorage& storage) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+    loadGameAsync(filename, storage, [promise](bool ok) { promise->set_value(ok); });
+    return result;
+}
+
+// INSTANCIACION EXPLICITA - las variantes disponibles del juego
+template class BasicGame<3, 3, 3>;
+template class BasicGame<4, 4, 4>;
+template class BasicGame<5, 5, 4>;
+template class BasicGame<15, 15, 5>;
\ No newline at end of file
@@ -1,51 +1,141 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <functional>
+#include <future>
 #include <string>
+#include <vector>
+#include "Board.h"
+#include "Zobrist.h"
 
-class Game {
+class SaveStorage;
+template <typename GameType>
+class Console;
+
+// Juego m,n,k: tablero de Rows x Cols donde gana quien alinea K fichas.
+// Las instancias disponibles se crean explicitamente en Game.cpp.
+//
+// Solo reglas y estado: nada lee de std::cin ni escribe en std::cout (los
+// avisos van al registro de Logger.h). Las jugadas, deshacer/rehacer y la
+// revision de ganador o empate no reservan memoria. La terminal vive en Console.h y el disco
+// detras de SaveStorage.
+template <int Rows, int Cols, int K>
+class BasicGame {
+    static_assert(Rows * Cols <= 256, "Las jugadas se guardan en un byte");
+    friend class Console<BasicGame>;  // Informe de memoria del programa de consola
+    
 private:
-    char* board;        // Puntero al tablero dinámico en heap
+    Board<Rows, Cols, K> board;  // Bitboards por jugador (sin heap)
     int boardSize;      // Tamaño del tablero (9 para 3x3)
     char currentPlayer; // Jugador actual ('X' o 'O')
     bool gameEnded;     // Estado del juego
     char winner;        // Ganador del juego
+    unsigned char history[Rows * Cols];  // Jugadas en orden (board.moveCount() validas)
+    int historyLength;  // Jugadas anotadas; las que pasan de moveCount() se pueden rehacer
+    
+    // Fichas de cada jugador en cada linea ganadora, al dia con cada jugada.
+    // completedLines cuenta las lineas que ya llegaron a K.
+    unsigned char lineCounts[2][Board<Rows, Cols, K>::NUM_LINES];
+    int completedLines[2];
+    std::uint64_t hash;  // Zobrist de las fichas y del turno, al dia con cada jugada
+    std::function<void(const BasicGame&, int)> moveListener;  // No se copia: cada copia es otra partida
     
     // Función helper para convertir (fila,columna) a índice
     int getIndex(int row, int col) const;
+    void updateLines(int cell, int player, int delta);  // Solo las lineas que pasan por 'cell'
+    void finishTurn();  // Ganador, empate o cambio de turno tras una jugada
+    bool applyLoadedData(const std::string& fullFilename, const std::vector<char>& data);
+    static std::string withExtension(const std::string& filename);  // Agrega ".triki" si falta
     
 public:
+    using BoardType = Board<Rows, Cols, K>;
+    
+    // Decide la jugada de la CPU: devuelve la casilla (fila*Cols + columna)
+    using MoveProvider = std::function<int(const BasicGame&)>;
+    
+    // Aviso despues de cada jugada valida de playTurn() (p. ej. para el diario)
+    using MoveListener = std::function<void(const BasicGame&, int cell)>;
+    
     // Constructor y destructor
-    Game();
-    ~Game();
+    BasicGame();
+    ~BasicGame();
     
     // Constructor copia y operador asignación (Regla de los 3)
-    Game(const Game& other);
-    Game& operator=(const Game& other);
+    BasicGame(const BasicGame& other);
+    BasicGame& operator=(const BasicGame& other);
     
     // Métodos principales del juego
-    void displayBoard() const;
     bool makeMove(int row, int col);
     bool checkWinner();
     bool isBoardFull() const;
     void switchPlayer();
     void resetGame();
     
+    // Turno completo sin consola: jugada, ganador, empate y cambio de turno.
+    // Devuelve false si la jugada no es valida o el juego ya termino.
+    bool playTurn(int row, int col);
+    void setMoveListener(const MoveListener& listener);
+    
+    // Deshacer y rehacer jugadas en O(1), sin copiar la partida. Una jugada
+    // nueva descarta lo que se podia rehacer (salvo que sea la misma que
+    // sigue en el historial). No avisan al MoveListener. Devuelven false si
+    // no hay nada que deshacer o rehacer.
+    bool undoMove();
+    bool redoMove();
+    int getRedoCount() const;
+    
     // Métodos de acceso (getters)
     char getCurrentPlayer() const;
     char getWinner() const;
     bool isGameEnded() const;
     char getCellValue(int row, int col) const;
+    const BoardType& getBoard() const;
+    int getMoveCount() const;
+    int getMove(int index) const;       // Casilla de la jugada numero 'index'
+    // Clave de la posicion (fichas y turno): iguales en posiciones iguales,
+    // sin importar el orden de las jugadas ni la ejecucion del programa
+    std::uint64_t getHash() const;
     
-    // Método principal de juego
-    void playGame();
+    // Juego perfecto: consulta la tabla precalculada del 3x3 o, en 4x4 y
+    // 5x5, la tabla de finales de Tablebase.h si ya se construyo (se abre
+    // con mmap al primer uso). Sin tabla devuelven -1 y '?'
+    int getBestMove() const;            // Casilla fila*Cols + columna
+    char getPerfectPlayWinner() const;  // 'X', 'O' o ' ' si es empate
     
-    // Métodos para manejo de archivos (para implementar después)
+    // Métodos para manejo de archivos (formato v2, ver SaveFormat.h). Sin
+    // 'storage' usan un FileManager del directorio "saves"
     bool saveGame(const std::string& filename) const;
     bool loadGame(const std::string& filename);
+    bool saveGame(const std::string& filename, SaveStorage& storage) const;
+    bool loadGame(const std::string& filename, const SaveStorage& storage);
     
-    // Método para mostrar información de memoria (educativo)
-    void showMemoryInfo() const;
+    // Versiones asincronas (ver SaveExecutor.h): vuelven enseguida y avisan
+    // al terminar con un callback (desde el hilo de E/S) o con un future.
+    // saveGameAsync guarda una foto de la partida tomada al llamarla; con
+    // loadGameAsync la partida no se debe usar hasta recibir el aviso.
+    // Van por SaveExecutor::shared(); 'storage' debe seguir vivo hasta el
+    // aviso y sin el usan el mismo FileManager que saveGame/loadGame
+    void saveGameAsync(const std::string& filename, const std::function<void(bool)>& done) const;
+    std::future<bool> saveGameAsync(const std::string& filename) const;
+    void loadGameAsync(const std::string& filename, const std::function<void(bool)>& done);
+    std::future<bool> loadGameAsync(const std::string& filename);
+    void saveGameAsync(const std::string& filename, SaveStorage& storage,
+                       const std::function<void(bool)>& done) const;
+    std::future<bool> saveGameAsync(const std::string& filename, SaveStorage& storage) const;
+    void loadGameAsync(const std::string& filename, const SaveStorage& storage,
+                       const std::function<void(bool)>& done);
+    std::future<bool> loadGameAsync(const std::string& filename, const SaveStorage& storage);
+    
+    // Partida completa en memoria con el formato v2. deserialize() tambien
+    // acepta el formato v1 y no modifica el juego si los datos no son validos.
+    std::vector<char> serialize() const;
+    bool deserialize(const std::vector<char>& data);
 };
 
+// Variantes instanciadas en Game.cpp
+using Game = BasicGame<3, 3, 3>;     // Triki clasico
+using Game4x4 = BasicGame<4, 4, 4>;
+using Game5x5 = BasicGame<5, 5, 4>;
+using Gomoku = BasicGame<15, 15, 5>;
+
 #endif
\ No newline at end of file
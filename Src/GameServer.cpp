@@ -0,0 +1,720 @@
+#include "GameServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "FileManager.h"
+
+namespace {
+
+bool isUnixAddress(const std::string& address) {
+    return address.find('/') != std::string::npos;
+}
+
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Tablero, turno y resultado en una sola linea
+std::string describe(const Game& game) {
+    std::string state;
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            char cell = game.getCellValue(row, col);
+            state += (cell == ' ') ? '.' : cell;
+        }
+    }
+    state += ' ';
+    state += game.getCurrentPlayer();
+    if (!game.isGameEnded()) {
+        state += " PLAYING";
+    } else if (game.getWinner() == ' ') {
+        state += " DRAW";
+    } else {
+        state += ' ';
+        state += game.getWinner();
+    }
+    return state;
+}
+
+}
+
+// ===================== SessionTable =====================
+
+SessionTable::SessionTable(int maxSessions) : maxSessions(std::max(1, maxSessions)) {}
+
+SessionTable::Session* SessionTable::slot(int index) {
+    return &blocks[index / SLOTS_PER_BLOCK][index % SLOTS_PER_BLOCK];
+}
+
+std::uint64_t SessionTable::open(int owner) {
+    if (freeSlots.empty()) {
+        if (allocated >= maxSessions) {
+            return 0;
+        }
+        // Un bloque nuevo: sus partidas se construyen aqui una sola vez
+        blocks.emplace_back(new Session[SLOTS_PER_BLOCK]);
+        for (int i = SLOTS_PER_BLOCK - 1; i >= 0; i--) {
+            if (allocated + i < maxSessions) freeSlots.push_back(allocated + i);
+        }
+        allocated = std::min(allocated + SLOTS_PER_BLOCK, maxSessions);
+    }
+
+    int index = freeSlots.back();
+    freeSlots.pop_back();
+    Session* session = slot(index);
+    session->owner = owner;
+    session->game.resetGame();
+
+    active++;
+    peak = std::max(peak, active);
+    return (static_cast<std::uint64_t>(session->generation) << 32) | static_cast<std::uint32_t>(index);
+}
+
+Game* SessionTable::find(std::uint64_t id, int owner) {
+    std::uint32_t index = static_cast<std::uint32_t>(id);
+    if (index >= static_cast<std::uint32_t>(allocated)) {
+        return nullptr;
+    }
+    Session* session = slot(static_cast<int>(index));
+    if (session->owner < 0 || session->owner != owner || session->generation != (id >> 32)) {
+        return nullptr;
+    }
+    return &session->game;
+}
+
+bool SessionTable::close(std::uint64_t id, int owner) {
+    if (!find(id, owner)) {
+        return false;
+    }
+    int index = static_cast<int>(static_cast<std::uint32_t>(id));
+    Session* session = slot(index);
+    session->owner = -1;
+    session->generation++;  // Invalida el id anterior
+    freeSlots.push_back(index);
+    active--;
+    return true;
+}
+
+int SessionTable::getActive() const {
+    return active;
+}
+
+int SessionTable::getPeak() const {
+    return peak;
+}
+
+int SessionTable::getCapacity() const {
+    return maxSessions;
+}
+
+// ===================== GameServer =====================
+
+struct GameServer::Connection {
+    int fd;
+    std::string input;
+    std::string output;
+    std::size_t outputSent = 0;
+    bool wantsWrite = false;  // EPOLLOUT activo mientras quede salida pendiente
+    bool closing = false;     // Cerrar cuando se vacie la salida
+    bool awaiting = false;    // Esta en awaitingDurable
+    bool ioPending = false;   // SAVE/LOAD en curso: las demas ordenes esperan
+    bool inputEnded = false;  // El cliente cerro su lado
+    std::uint64_t serial = 0;
+    std::uint64_t waitSequence = 0;  // Registro del diario que debe ser durable antes de responder
+    std::vector<std::uint64_t> sessionIds;
+
+    // Respuestas en 'output' cuya orden escribio en el diario: donde estan y
+    // la secuencia de su ultimo registro. Si el diario falla, solo esas se
+    // cambian por un error
+    struct HeldReply {
+        std::size_t begin;
+        std::size_t end;
+        std::uint64_t sequence;
+    };
+    std::vector<HeldReply> held;
+
+    explicit Connection(int fd) : fd(fd) {}
+
+    // 'sequence': registro del diario que escribio la orden, 0 si ninguno
+    void addReply(const std::string& reply, std::uint64_t sequence) {
+        std::size_t begin = output.size();
+        output += reply;
+        output += '\n';
+        if (sequence) held.push_back(HeldReply{begin, output.size(), sequence});
+    }
+};
+
+GameServer::GameServer(const Config& config) : config(config), sessions(config.maxSessions) {
+    if (!this->config.storage) this->config.storage = &FileManager::shared();
+}
+
+GameServer::~GameServer() {
+    // Los callbacks de E/S pendientes usan este objeto
+    if (config.asyncSaves) SaveExecutor::shared().waitIdle();
+    // Primero el diario (escribe lo pendiente): las partidas de las
+    // conexiones abiertas quedan en curso y se recuperan al volver a arrancar
+    journal.reset();
+    for (std::size_t fd = 0; fd < connections.size(); fd++) {
+        if (connections[fd]) closeConnection(static_cast<int>(fd));
+    }
+    if (listenFd >= 0) close(listenFd);
+    if (epollFd >= 0) close(epollFd);
+    if (durableFd >= 0) close(durableFd);
+    if (ioFd >= 0) close(ioFd);
+    if (isUnixAddress(config.address)) unlink(config.address.c_str());
+}
+
+const GameServer::Stats& GameServer::getStats() const {
+    return stats;
+}
+
+void GameServer::stop() {
+    stopRequested.store(true);
+}
+
+bool GameServer::openListener() {
+    if (isUnixAddress(config.address)) {
+        sockaddr_un addr{};
+        if (config.address.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "[ERROR] Ruta de socket demasiado larga: " << config.address << std::endl;
+            return false;
+        }
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, config.address.c_str());
+        unlink(config.address.c_str());  // Socket viejo de una ejecucion anterior
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "[ERROR] No se pudo abrir " << config.address << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    } else {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<uint16_t>(std::stoi(config.address)));
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        if (listenFd >= 0) setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "[ERROR] No se pudo abrir el puerto " << config.address << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    if (listen(listenFd, SOMAXCONN) < 0) {
+        std::cerr << "[ERROR] listen: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    setNonBlocking(listenFd);
+    return true;
+}
+
+bool GameServer::run() {
+    if (!openListener()) {
+        return false;
+    }
+    epollFd = epoll_create1(0);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    
+    if (!config.journalPath.empty()) {
+        // Partidas que quedaron a medias en una ejecucion anterior
+        auto recovered = MoveJournal::recoverToSnapshots(config.journalPath);
+        if (!recovered.empty()) {
+            std::cout << "Diario: " << recovered.size() << " partidas recuperadas (LOAD recuperada-<id>)\n";
+        }
+        MoveJournal::Config journalConfig;
+        journalConfig.path = config.journalPath;
+        journalConfig.commitWindowMicros = config.commitWindowMicros;
+        journal.reset(new MoveJournal(journalConfig));
+        if (!journal->isOpen()) {
+            return false;
+        }
+        durableFd = eventfd(0, EFD_NONBLOCK);
+        epoll_event durableEvent{};
+        durableEvent.events = EPOLLIN;
+        durableEvent.data.fd = durableFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, durableFd, &durableEvent);
+        const int notifyFd = durableFd;
+        journal->setDurableCallback([notifyFd]() {
+            std::uint64_t one = 1;
+            ssize_t written = write(notifyFd, &one, sizeof(one));
+            (void)written;
+        });
+    }
+
+    if (!config.spectatorPath.empty()) {
+        SpectatorFeed::Config feedConfig;
+        feedConfig.path = config.spectatorPath;
+        spectators.reset(new SpectatorFeed(feedConfig));
+        if (!spectators->isOpen()) {
+            return false;
+        }
+    }
+
+    if (config.asyncSaves) {
+        ioFd = eventfd(0, EFD_NONBLOCK);
+        epoll_event ioEvent{};
+        ioEvent.events = EPOLLIN;
+        ioEvent.data.fd = ioFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, ioFd, &ioEvent);
+    }
+
+    std::cout << "Servidor escuchando en " << config.address << " (hasta "
+              << sessions.getCapacity() << " sesiones)\n";
+
+    epoll_event events[256];
+    while (!stopRequested.load()) {
+        // Espera acotada para revisar stop() de vez en cuando
+        int ready = epoll_wait(epollFd, events, 256, 200);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[ERROR] epoll_wait: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptAll();
+                continue;
+            }
+            if (fd == durableFd) {
+                releaseDurable();
+                continue;
+            }
+            if (fd == ioFd) {
+                finishIo();
+                continue;
+            }
+            if (fd >= static_cast<int>(connections.size()) || !connections[fd]) continue;
+            Connection& conn = *connections[fd];
+
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                closeConnection(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                readFrom(conn);
+            }
+            if (connections[fd] && (events[i].events & EPOLLOUT)) {
+                flush(conn);
+            }
+        }
+    }
+
+    stats.peakSessions = sessions.getPeak();
+    if (journal) {
+        stats.journal = journal->getStats();
+    }
+    if (config.asyncSaves) {
+        stats.io = SaveExecutor::shared().getStats();
+    }
+    if (spectators) {
+        stats.spectators = spectators->getStats();
+    }
+    return true;
+}
+
+void GameServer::acceptAll() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;  // EAGAIN: no quedan conexiones pendientes
+        }
+        setNonBlocking(fd);
+        if (!isUnixAddress(config.address)) {
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+        if (fd >= static_cast<int>(connections.size())) {
+            connections.resize(fd + 1);
+        }
+        connections[fd].reset(new Connection(fd));
+        connections[fd]->serial = ++nextSerial;
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        stats.connections++;
+    }
+}
+
+void GameServer::readFrom(Connection& conn) {
+    char buffer[4096];
+    const int fd = conn.fd;
+    while (true) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            conn.input.append(buffer, static_cast<std::size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        conn.inputEnded = true;  // Fin de archivo o error
+        break;
+    }
+    processInput(conn);
+}
+
+void GameServer::processInput(Connection& conn) {
+    const int fd = conn.fd;
+    // Ejecutar todas las lineas completas; la ultima puede quedar a medias.
+    // Un SAVE/LOAD en curso detiene la conexion hasta que termine.
+    std::size_t start = 0;
+    std::size_t newline;
+    while (!conn.closing && !conn.ioPending && (newline = conn.input.find('\n', start)) != std::string::npos) {
+        std::string line = conn.input.substr(start, newline - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        start = newline + 1;
+        execute(conn, line);
+    }
+    conn.input.erase(0, start);
+    if (conn.ioPending) {
+        return;  // finishIo() retoma esta conexion
+    }
+    if (conn.inputEnded) {
+        conn.closing = true;  // Se responde lo ya recibido y luego se cierra
+    }
+    if (static_cast<int>(conn.input.size()) > config.maxLineLength) {
+        conn.output += "ERR linea demasiado larga\n";
+        conn.closing = true;
+    }
+
+    // Las respuestas esperan a que sus registros del diario esten en disco
+    if (journal && conn.waitSequence > journal->getDurableSequence()) {
+        if (journal->hasFailed()) {
+            rejectUndurable(conn);
+            return;
+        }
+        if (!conn.awaiting) {
+            conn.awaiting = true;
+            awaitingDurable.push_back(fd);
+        }
+        return;
+    }
+    flush(conn);
+}
+
+void GameServer::releaseDurable() {
+    std::uint64_t count;
+    ssize_t n = read(durableFd, &count, sizeof(count));
+    (void)n;
+    std::uint64_t durable = journal->getDurableSequence();
+
+    std::vector<int> waiting;
+    waiting.swap(awaitingDurable);
+    for (int fd : waiting) {
+        if (fd >= static_cast<int>(connections.size()) || !connections[fd]) continue;
+        Connection& conn = *connections[fd];
+        if (conn.waitSequence <= durable) {
+            conn.awaiting = false;
+            flush(conn);
+        } else if (journal->hasFailed()) {
+            conn.awaiting = false;
+            rejectUndurable(conn);
+        } else {
+            awaitingDurable.push_back(fd);
+        }
+    }
+}
+
+// El diario fallo: cada respuesta retenida cuya orden escribio registros que
+// no llegaron al disco se cambia por un error (la partida en memoria si
+// avanzo). Las demas (STATE, ordenes ya durables) salen como estaban, asi
+// el cliente recibe una linea por orden.
+void GameServer::rejectUndurable(Connection& conn) {
+    const std::uint64_t durable = journal->getDurableSequence();
+    std::string output;
+    std::size_t copied = 0;
+    for (const auto& held : conn.held) {
+        if (held.sequence <= durable || held.begin < conn.outputSent) continue;
+        output.append(conn.output, copied, held.begin - copied);
+        output += "ERR el diario no pudo escribir en disco\n";
+        stats.errors++;
+        copied = held.end;
+    }
+    output.append(conn.output, copied, std::string::npos);
+    conn.output.swap(output);
+    conn.held.clear();
+    conn.waitSequence = 0;
+    flush(conn);
+}
+
+void GameServer::completeIo(IoCompletion completion) {
+    {
+        std::lock_guard<std::mutex> guard(ioLock);
+        ioCompleted.push_back(std::move(completion));
+    }
+    std::uint64_t one = 1;
+    ssize_t written = write(ioFd, &one, sizeof(one));
+    (void)written;
+}
+
+void GameServer::finishIo() {
+    std::uint64_t count;
+    ssize_t n = read(ioFd, &count, sizeof(count));
+    (void)n;
+    std::vector<IoCompletion> completed;
+    {
+        std::lock_guard<std::mutex> guard(ioLock);
+        completed.swap(ioCompleted);
+    }
+
+    for (auto& completion : completed) {
+        int fd = completion.fd;
+        if (fd >= static_cast<int>(connections.size()) || !connections[fd] ||
+            connections[fd]->serial != completion.serial) {
+            continue;  // La conexion se cerro mientras tanto
+        }
+        Connection& conn = *connections[fd];
+        const std::uint64_t before = conn.waitSequence;
+        std::string reply;
+        if (!completion.loaded) {
+            reply = completion.ok ? "OK" : "ERR no se pudo guardar";
+        } else if (!completion.ok) {
+            reply = "ERR no se pudo cargar";
+        } else {
+            std::uint64_t id = sessions.open(fd);
+            if (!id) {
+                reply = "ERR sin sesiones libres";
+            } else {
+                Game* game = sessions.find(id, fd);
+                *game = *completion.loaded;
+                conn.sessionIds.push_back(id);
+                reply = "OK " + std::to_string(id) + " " + describe(*game);
+                if (journal && !game->isGameEnded()) {
+                    conn.waitSequence = journal->beginGame(id);
+                    for (int i = 0; i < game->getMoveCount(); i++) {
+                        conn.waitSequence = journal->recordMove(id, game->getMove(i));
+                    }
+                }
+                publishGame(id, *game);
+            }
+        }
+        if (reply[0] == 'E') stats.errors++;
+        conn.addReply(reply, conn.waitSequence != before ? conn.waitSequence : 0);
+        conn.ioPending = false;
+        processInput(conn);  // Ordenes que llegaron mientras tanto
+    }
+}
+
+void GameServer::publishGame(std::uint64_t id, const Game& game) {
+    if (!spectators) {
+        return;
+    }
+    spectators->beginGame(id, 3, 3, 3);
+    for (int i = 0; i < game.getMoveCount(); i++) {
+        spectators->recordMove(id, game.getMove(i));
+    }
+    if (game.isGameEnded()) {
+        spectators->endGame(id, game.getWinner());
+    }
+}
+
+void GameServer::flush(Connection& conn) {
+    const int fd = conn.fd;
+    while (conn.outputSent < conn.output.size()) {
+        ssize_t n = send(fd, conn.output.data() + conn.outputSent, conn.output.size() - conn.outputSent,
+                         MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            closeConnection(fd);
+            return;
+        }
+        conn.outputSent += static_cast<std::size_t>(n);
+    }
+
+    bool pending = conn.outputSent < conn.output.size();
+    if (!pending) {
+        conn.output.clear();
+        conn.outputSent = 0;
+        conn.held.clear();
+        if (conn.closing) {
+            closeConnection(fd);
+            return;
+        }
+    }
+    // Solo se pide EPOLLOUT mientras el cliente no reciba todo
+    if (pending != conn.wantsWrite) {
+        conn.wantsWrite = pending;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0u);
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+}
+
+void GameServer::closeConnection(int fd) {
+    Connection& conn = *connections[fd];
+    for (std::uint64_t id : conn.sessionIds) {
+        if (journal && sessions.find(id, fd)) journal->endGame(id);
+        if (spectators) spectators->closeGame(id);
+        sessions.close(id, fd);
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections[fd].reset();
+}
+
+void GameServer::execute(Connection& conn, const std::string& line) {
+    std::istringstream in(line);
+    std::string command;
+    in >> command;
+    if (command.empty()) return;
+    stats.commands++;
+
+    std::string reply;
+    std::uint64_t id = 0;
+    const std::uint64_t before = conn.waitSequence;
+
+    if (command == "NEW") {
+        id = sessions.open(conn.fd);
+        if (id) {
+            conn.sessionIds.push_back(id);
+            if (journal) conn.waitSequence = journal->beginGame(id);
+            if (spectators) spectators->beginGame(id, 3, 3, 3);
+            reply = "OK " + std::to_string(id);
+        } else {
+            reply = "ERR sin sesiones libres";
+        }
+    } else if (command == "MOVE") {
+        int row, col;
+        Game* game = (in >> id >> row >> col) ? sessions.find(id, conn.fd) : nullptr;
+        if (!game) {
+            reply = "ERR sesion invalida";
+        } else if (!game->playTurn(row, col)) {
+            reply = "ERR jugada invalida";
+        } else {
+            stats.moves++;
+            reply = "OK " + describe(*game);
+            if (journal) {
+                conn.waitSequence = journal->recordMove(id, row * 3 + col);
+                if (game->isGameEnded()) conn.waitSequence = journal->endGame(id);
+            }
+            if (spectators) {
+                spectators->recordMove(id, row * 3 + col);
+                if (game->isGameEnded()) spectators->endGame(id, game->getWinner());
+            }
+        }
+    } else if (command == "STATE") {
+        Game* game = (in >> id) ? sessions.find(id, conn.fd) : nullptr;
+        reply = game ? "OK " + describe(*game) : "ERR sesion invalida";
+    } else if (command == "SAVE") {
+        std::string name;
+        Game* game = (in >> id >> name) ? sessions.find(id, conn.fd) : nullptr;
+        if (!game) {
+            reply = "ERR sesion invalida";
+        } else if (config.asyncSaves) {
+            // Se guarda una foto de la partida; la respuesta sale en finishIo()
+            conn.ioPending = true;
+            const int fd = conn.fd;
+            const std::uint64_t serial = conn.serial;
+            game->saveGameAsync(name, *config.storage, [this, fd, serial](bool ok) {
+                completeIo(IoCompletion{fd, serial, ok, nullptr});
+            });
+            return;
+        } else {
+            reply = game->saveGame(name, *config.storage) ? "OK" : "ERR no se pudo guardar";
+        }
+    } else if (command == "LOAD" && config.asyncSaves) {
+        std::string name;
+        in >> name;
+        if (name.empty()) {
+            reply = "ERR falta el nombre";
+        } else {
+            // Se carga en una partida aparte; la sesion se abre en finishIo()
+            conn.ioPending = true;
+            const int fd = conn.fd;
+            const std::uint64_t serial = conn.serial;
+            auto loaded = std::make_shared<Game>();
+            loaded->loadGameAsync(name, *config.storage, [this, fd, serial, loaded](bool ok) {
+                completeIo(IoCompletion{fd, serial, ok, loaded});
+            });
+            return;
+        }
+    } else if (command == "LOAD") {
+        std::string name;
+        in >> name;
+        id = name.empty() ? 0 : sessions.open(conn.fd);
+        if (!id) {
+            reply = name.empty() ? "ERR falta el nombre" : "ERR sin sesiones libres";
+        } else if (!sessions.find(id, conn.fd)->loadGame(name, *config.storage)) {
+            sessions.close(id, conn.fd);
+            reply = "ERR no se pudo cargar";
+        } else {
+            Game* game = sessions.find(id, conn.fd);
+            conn.sessionIds.push_back(id);
+            reply = "OK " + std::to_string(id) + " " + describe(*game);
+            if (journal && !game->isGameEnded()) {
+                conn.waitSequence = journal->beginGame(id);
+                for (int i = 0; i < game->getMoveCount(); i++) {
+                    conn.waitSequence = journal->recordMove(id, game->getMove(i));
+                }
+            }
+            publishGame(id, *game);
+        }
+    } else if (command == "END") {
+        if ((in >> id) && sessions.find(id, conn.fd)) {
+            if (journal) conn.waitSequence = journal->endGame(id);
+            if (spectators) spectators->closeGame(id);
+            sessions.close(id, conn.fd);
+            auto& ids = conn.sessionIds;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            reply = "OK";
+        } else {
+            reply = "ERR sesion invalida";
+        }
+    } else if (command == "QUIT") {
+        conn.closing = true;
+        reply = "OK";
+    } else {
+        reply = "ERR orden desconocida";
+    }
+
+    if (reply[0] == 'E') stats.errors++;
+    conn.addReply(reply, conn.waitSequence != before ? conn.waitSequence : 0);
+}
+
+// ===================== Cliente =====================
+
+int connectToServer(const std::string& address) {
+    int fd;
+    if (isUnixAddress(address)) {
+        sockaddr_un addr{};
+        if (address.size() >= sizeof(addr.sun_path)) return -1;
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, address.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<uint16_t>(std::stoi(address)));
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        int noDelay = 1;
+        if (fd >= 0) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return fd;
+}
@@ -0,0 +1,151 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "Journal.h"
+#include "SaveExecutor.h"
+#include "SpectatorFeed.h"
+
+// TABLA DE SESIONES CON ASIGNACION POR BLOQUES (slab)
+// Las partidas viven en bloques de SLOTS_PER_BLOCK sesiones que se crean
+// una sola vez; al cerrar una sesion su casilla vuelve a una lista libre y
+// se reutiliza con resetGame(), sin pasar otra vez por new/delete.
+// El id de una sesion combina la casilla y una generacion, asi que un id
+// viejo no puede tocar la partida que ahora ocupa la misma casilla.
+class SessionTable {
+public:
+    static const int SLOTS_PER_BLOCK = 256;
+
+    explicit SessionTable(int maxSessions);
+
+    // Devuelve el id de la nueva sesion o 0 si la tabla esta llena
+    std::uint64_t open(int owner);
+    Game* find(std::uint64_t id, int owner);  // nullptr si no existe o es de otro
+    bool close(std::uint64_t id, int owner);
+
+    int getActive() const;
+    int getPeak() const;
+    int getCapacity() const;
+
+private:
+    struct Session {
+        Game game;
+        std::uint32_t generation = 1;
+        int owner = -1;  // Descriptor de la conexion duena, -1 si esta libre
+    };
+
+    std::vector<std::unique_ptr<Session[]>> blocks;
+    std::vector<int> freeSlots;
+    int maxSessions;
+    int allocated = 0;
+    int active = 0;
+    int peak = 0;
+
+    Session* slot(int index);
+};
+
+// SERVIDOR DE PARTIDAS CON epoll
+// Un solo hilo atiende todas las conexiones (TCP en 127.0.0.1 o socket
+// Unix) con un ciclo de eventos. Protocolo de texto, una orden por linea:
+//   NEW                    -> OK <id>
+//   MOVE <id> <fila> <col> -> OK <estado>
+//   STATE <id>             -> OK <estado>
+//   SAVE <id> <nombre>     -> OK
+//   LOAD <nombre>          -> OK <id> <estado>
+//   END <id>               -> OK
+//   QUIT                   -> cierra la conexion
+// Los errores se responden con "ERR <motivo>". El estado es el tablero
+// (9 caracteres, '.' libre), el turno y PLAYING, X, O o DRAW.
+// Las sesiones pertenecen a la conexion que las creo y se liberan al cerrarla.
+// Con diario activo, la respuesta a cada orden que cambia una partida sale
+// solo cuando su registro ya esta en disco (commit agrupado, sin bloquear
+// el ciclo de eventos: el hilo del diario avisa por un eventfd).
+// SAVE y LOAD van al ejecutor de E/S (SaveExecutor); mientras tanto la
+// conexion no ejecuta mas ordenes, asi las respuestas salen en orden, y las
+// demas conexiones siguen atendidas aunque el disco este lento.
+// Con espectadores activos, cada partida se transmite jugada a jugada en
+// memoria compartida (SpectatorFeed.h) desde el mismo ciclo de eventos.
+class GameServer {
+public:
+    struct Config {
+        std::string address = "7777";  // Puerto TCP o ruta de un socket Unix (con '/')
+        int maxSessions = 65536;
+        int maxLineLength = 256;
+        std::string journalPath;        // Vacio = sin diario
+        int commitWindowMicros = 1000;
+        bool asyncSaves = true;         // false: SAVE/LOAD en el mismo ciclo de eventos
+        SaveStorage* storage = nullptr; // Destino de SAVE/LOAD; nullptr = FileManager::shared()
+        std::string spectatorPath;      // Vacio = sin espectadores
+    };
+
+    struct Stats {
+        long long connections = 0;
+        long long commands = 0;
+        long long moves = 0;
+        long long errors = 0;
+        int peakSessions = 0;
+        MoveJournal::Stats journal;
+        SaveExecutor::Stats io;
+        SpectatorFeed::Stats spectators;
+    };
+
+    explicit GameServer(const Config& config);
+    ~GameServer();
+
+    // Abre el socket y atiende eventos hasta stop(). false si no pudo escuchar.
+    bool run();
+    void stop();  // Seguro desde un manejador de senales
+
+    const Stats& getStats() const;
+
+private:
+    struct Connection;
+    
+    // Resultado de un SAVE/LOAD que termino en el hilo de E/S
+    struct IoCompletion {
+        int fd;
+        std::uint64_t serial;  // Distingue una conexion nueva que reuso el descriptor
+        bool ok;
+        std::shared_ptr<Game> loaded;  // Solo en LOAD
+    };
+
+    Config config;
+    SessionTable sessions;
+    Stats stats;
+    int listenFd = -1;
+    int epollFd = -1;
+    int durableFd = -1;  // eventfd: el diario avisa que avanzo lo durable
+    std::unique_ptr<MoveJournal> journal;
+    std::unique_ptr<SpectatorFeed> spectators;
+    std::vector<int> awaitingDurable;  // Conexiones con respuestas retenidas
+    std::vector<std::unique_ptr<Connection>> connections;  // Indexadas por descriptor
+    std::uint64_t nextSerial = 0;
+    int ioFd = -1;  // eventfd: el ejecutor de E/S termino algun pedido
+    std::mutex ioLock;
+    std::vector<IoCompletion> ioCompleted;
+    std::atomic<bool> stopRequested{false};
+
+    bool openListener();
+    void acceptAll();
+    void readFrom(Connection& conn);
+    void processInput(Connection& conn);
+    void flush(Connection& conn);
+    void closeConnection(int fd);
+    void execute(Connection& conn, const std::string& line);
+    void releaseDurable();
+    void rejectUndurable(Connection& conn);  // El diario fallo: ERR por cada respuesta no durable
+    void completeIo(IoCompletion completion);  // Desde el hilo de E/S
+    void finishIo();
+    void publishGame(std::uint64_t id, const Game& game);  // Partida cargada, de una vez
+};
+
+// Direccion "puerto" o ruta Unix -> descriptor conectado, -1 si falla
+int connectToServer(const std::string& address);
+
+#endif
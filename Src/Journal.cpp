@@ -0,0 +1,427 @@
+#include "Journal.h"
+#include "Game.h"
+#include "Logger.h"
+#include "SaveFormat.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const char JOURNAL_MAGIC[4] = {'T', 'K', 'W', 'L'};
+const int JOURNAL_HEADER_BYTES = 8;
+const int RECORD_BYTES = 14;
+
+enum RecordType { RECORD_BEGIN = 1, RECORD_MOVE = 2, RECORD_END = 3 };
+
+// Variantes que caben en el diario: filas, columnas y k. El indice va en el
+// registro de inicio; los diarios anteriores tienen 0 ahi, que es 3x3.
+const int VARIANTS[][3] = {{3, 3, 3}, {4, 4, 4}, {5, 5, 4}, {15, 15, 5}};
+const int NUM_VARIANTS = 4;
+
+int variantCode(int rows, int cols, int k) {
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        if (VARIANTS[v][0] == rows && VARIANTS[v][1] == cols && VARIANTS[v][2] == k) return v;
+    }
+    return -1;
+}
+
+// Partida vacia de la variante 'code' (rows = 0 si no existe)
+MoveJournal::OpenGame emptyGame(std::uint64_t id, int code) {
+    MoveJournal::OpenGame game;
+    game.id = id;
+    game.rows = game.cols = game.k = 0;
+    if (code >= 0 && code < NUM_VARIANTS) {
+        game.rows = VARIANTS[code][0];
+        game.cols = VARIANTS[code][1];
+        game.k = VARIANTS[code][2];
+    }
+    return game;
+}
+
+std::string header() {
+    std::string bytes(JOURNAL_HEADER_BYTES, '\0');
+    std::memcpy(&bytes[0], JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    bytes[4] = 1;
+    return bytes;
+}
+
+void encodeRecord(unsigned char* out, int type, std::uint64_t id, int cell) {
+    out[0] = static_cast<unsigned char>(type);
+    writeLittleEndian(out + 1, static_cast<std::uint32_t>(id), 4);
+    writeLittleEndian(out + 5, static_cast<std::uint32_t>(id >> 32), 4);
+    out[9] = static_cast<unsigned char>(cell);
+    writeLittleEndian(out + 10, crc32(out, 10), 4);
+}
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// Reproduce las jugadas con el tipo de partida de la variante y la guarda;
+// una jugada invalida corta la partida ahi
+template <typename GameType>
+bool saveRecovered(const MoveJournal::OpenGame& open, const std::string& name) {
+    constexpr int Cols = GameType::BoardType::COLS;
+    GameType game;
+    for (unsigned char cell : open.moves) {
+        if (!game.playTurn(cell / Cols, cell % Cols)) break;
+    }
+    return game.saveGame(name);
+}
+
+}
+
+MoveJournal::MoveJournal(const Config& config) : config(config) {
+    // Las partidas que ya estaban en el diario se conservan al compactar
+    for (auto& game : readOpenGames(config.path)) {
+        maxGameId = std::max(maxGameId, game.id);
+        openGames[game.id] = std::move(game);
+    }
+
+    fd = ::open(config.path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo abrir el diario " << config.path << ": " << std::strerror(errno));
+        return;
+    }
+    off_t size = lseek(fd, 0, SEEK_END);
+    if (size >= JOURNAL_HEADER_BYTES) {
+        // Solo se agrega a un diario de este formato, nunca a otro archivo
+        char existing[JOURNAL_HEADER_BYTES];
+        if (pread(fd, existing, sizeof(existing), 0) != JOURNAL_HEADER_BYTES ||
+            std::memcmp(existing, header().data(), JOURNAL_HEADER_BYTES) != 0) {
+            TRIKI_ERROR(LOG_IO, "El diario " << config.path << " tiene otra cabecera (no es un diario de triki "
+                        "version 1); no se abre");
+            ::close(fd);
+            fd = -1;
+            return;
+        }
+    }
+    if (size < JOURNAL_HEADER_BYTES) {
+        // Diario nuevo (o cabecera rota): se empieza de cero con las partidas leidas
+        ::close(fd);
+        fd = -1;
+        std::unique_lock<std::mutex> guard(lock);
+        if (!compact(guard)) return;
+        stats.compactions = 0;
+    } else {
+        // Un registro final a medias se recorta para no mezclarlo con los nuevos
+        std::size_t valid = size - (size - JOURNAL_HEADER_BYTES) % RECORD_BYTES;
+        if (valid != static_cast<std::size_t>(size) && ftruncate(fd, valid) != 0) {
+            TRIKI_WARNING(LOG_IO, "No se pudo recortar el final del diario");
+        }
+        fileBytes = valid;
+    }
+    flusher = std::thread(&MoveJournal::flushLoop, this);
+    TRIKI_INFO(LOG_IO, "Diario abierto: " << config.path << " (" << openGames.size() << " partidas en curso)");
+}
+
+MoveJournal::~MoveJournal() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    pendingReady.notify_all();
+    if (flusher.joinable()) flusher.join();
+    if (fd >= 0) ::close(fd);
+}
+
+bool MoveJournal::isOpen() const {
+    return fd >= 0;
+}
+
+bool MoveJournal::hasFailed() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return failed;
+}
+
+std::uint64_t MoveJournal::beginGame(std::uint64_t id, int rows, int cols, int k) {
+    int code = variantCode(rows, cols, k);
+    if (code < 0) {
+        TRIKI_ERROR(LOG_IO, "El diario no admite partidas " << rows << "x" << cols << " (k=" << k
+                    << "); la partida " << id << " no se registra");
+        return 0;
+    }
+    return append(RECORD_BEGIN, id, code);
+}
+
+std::uint64_t MoveJournal::recordMove(std::uint64_t id, int cell) {
+    return append(RECORD_MOVE, id, cell);
+}
+
+std::uint64_t MoveJournal::endGame(std::uint64_t id) {
+    return append(RECORD_END, id, 0);
+}
+
+std::uint64_t MoveJournal::newGameId() {
+    std::lock_guard<std::mutex> guard(lock);
+    return ++maxGameId;
+}
+
+MoveJournal::Stats MoveJournal::getStats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+std::uint64_t MoveJournal::append(int type, std::uint64_t id, int cell) {
+    unsigned char record[RECORD_BYTES];
+    encodeRecord(record, type, id, cell);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (failed) return ++lastSequence;  // Nunca sera durable
+    if (fd < 0) return 0;
+
+    // Estado en memoria de las partidas abiertas (lo que se conserva al compactar)
+    if (type == RECORD_BEGIN) {
+        openGames[id] = emptyGame(id, cell);
+        maxGameId = std::max(maxGameId, id);
+    } else if (type == RECORD_MOVE) {
+        auto it = openGames.find(id);
+        if (it != openGames.end()) {
+            if (cell < 0 || cell >= it->second.rows * it->second.cols) {
+                TRIKI_ERROR(LOG_IO, "Diario: casilla " << cell << " fuera del tablero en la partida " << id);
+                return 0;
+            }
+            it->second.moves.push_back(static_cast<unsigned char>(cell));
+        }
+    } else {
+        openGames.erase(id);
+    }
+
+    if (pending.empty()) {
+        firstPendingTime = std::chrono::steady_clock::now();
+        pendingReady.notify_one();
+    }
+    pending.append(reinterpret_cast<const char*>(record), RECORD_BYTES);
+    stats.records++;
+    return ++lastSequence;
+}
+
+bool MoveJournal::waitDurable(std::uint64_t sequence) {
+    std::unique_lock<std::mutex> guard(lock);
+    durableReady.wait(guard, [&]() { return durableSequence >= sequence || fd < 0 || failed; });
+    return durableSequence >= sequence;
+}
+
+std::uint64_t MoveJournal::getDurableSequence() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return durableSequence;
+}
+
+void MoveJournal::setDurableCallback(const std::function<void()>& callback) {
+    std::lock_guard<std::mutex> guard(lock);
+    durableCallback = callback;
+}
+
+void MoveJournal::flushLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        pendingReady.wait(guard, [&]() { return stopping || !pending.empty(); });
+        if (pending.empty()) break;  // Solo se sale con todo escrito
+
+        // Ventana de agrupacion: mas registros entran mientras se espera
+        auto deadline = firstPendingTime + std::chrono::microseconds(config.commitWindowMicros);
+        pendingReady.wait_until(guard, deadline, [&]() {
+            return stopping || pending.size() >= config.maxBatchBytes;
+        });
+
+        std::string batch;
+        batch.swap(pending);
+        std::uint64_t sequence = lastSequence;
+
+        // Escritura y fsync sin el candado: los productores siguen agregando
+        guard.unlock();
+        bool ok = writeAll(fd, batch.data(), batch.size()) && fdatasync(fd) == 0;
+        int error = errno;
+        guard.lock();
+
+        if (ok) {
+            fileBytes += batch.size();
+            stats.commits++;
+            stats.bytesWritten += static_cast<long long>(batch.size());
+            durableSequence = sequence;
+            if (fileBytes >= config.compactBytes) {
+                compact(guard);
+            }
+        } else {
+            // No se sabe que parte llego al disco: esta tanda y las
+            // siguientes no se dan por durables
+            TRIKI_ERROR(LOG_IO, "Fallo la escritura del diario " << config.path << ": " << std::strerror(error)
+                        << "; las jugadas siguientes no quedan en disco");
+            failed = true;
+            pending.clear();
+        }
+        durableReady.notify_all();
+        if (durableCallback) {
+            auto callback = durableCallback;
+            guard.unlock();
+            callback();
+            guard.lock();
+        }
+    }
+}
+
+// Reescribe el diario solo con las partidas abiertas. Se llama con el
+// candado tomado y se suelta mientras se escribe el archivo nuevo, igual que
+// una tanda: los productores siguen agregando a 'pending'. Lo pendiente al
+// armar la foto ya esta en 'openGames', asi que al volver se descarta esa
+// parte y recien entonces (archivo y directorio en disco) pasa a durable.
+bool MoveJournal::compact(std::unique_lock<std::mutex>& guard) {
+    std::vector<std::uint64_t> ids;
+    for (const auto& entry : openGames) ids.push_back(entry.first);
+    std::sort(ids.begin(), ids.end());
+
+    std::string records;
+    unsigned char record[RECORD_BYTES];
+    for (std::uint64_t id : ids) {
+        const OpenGame& game = openGames[id];
+        encodeRecord(record, RECORD_BEGIN, id, variantCode(game.rows, game.cols, game.k));
+        records.append(reinterpret_cast<const char*>(record), RECORD_BYTES);
+        for (unsigned char cell : game.moves) {
+            encodeRecord(record, RECORD_MOVE, id, cell);
+            records.append(reinterpret_cast<const char*>(record), RECORD_BYTES);
+        }
+    }
+    std::uint64_t sequence = lastSequence;
+    std::size_t covered = pending.size();
+
+    guard.unlock();
+    bool replaced = false;
+    bool written = writeFresh(config.path, records, replaced);
+    int newFd = written ? ::open(config.path.c_str(), O_WRONLY | O_APPEND) : -1;
+    int error = errno;
+    guard.lock();
+
+    if (!replaced) {
+        // El diario anterior sigue en su lugar: se sigue agregando ahi
+        TRIKI_ERROR(LOG_IO, "No se pudo compactar el diario " << config.path);
+        return false;
+    }
+    if (fd >= 0) ::close(fd);
+    fd = newFd;
+    if (fd < 0) {
+        // El archivo nuevo no se sabe en disco o no hay donde seguir escribiendo
+        TRIKI_ERROR(LOG_IO, "No se pudo reemplazar el diario " << config.path << ": " << std::strerror(error));
+        if (flusher.joinable()) {
+            failed = true;
+            pending.clear();
+        }
+        return false;
+    }
+    fileBytes = JOURNAL_HEADER_BYTES + records.size();
+    pending.erase(0, covered);
+    durableSequence = std::max(durableSequence, sequence);
+    stats.compactions++;
+    TRIKI_DEBUG(LOG_IO, "Diario compactado: " << ids.size() << " partidas, " << fileBytes << " bytes");
+    return true;
+}
+
+// Archivo nuevo con cabecera + registros: temporal, fsync, renombrado y fsync
+// del directorio (sin este, tras un corte de luz puede volver el archivo
+// viejo). 'replaced' dice si el renombrado se hizo, aunque despues falle.
+bool MoveJournal::writeFresh(const std::string& path, const std::string& records, bool& replaced) {
+    replaced = false;
+    std::string tempPath = path + ".tmp";
+    int out = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) return false;
+    std::string content = header() + records;
+    bool ok = writeAll(out, content.data(), content.size()) && fsync(out) == 0;
+    ::close(out);
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    replaced = true;
+
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int dir = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir < 0) return false;
+    ok = fsync(dir) == 0;
+    ::close(dir);
+    return ok;
+}
+
+std::vector<MoveJournal::OpenGame> MoveJournal::readOpenGames(const std::string& path) {
+    std::vector<OpenGame> result;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return result;
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() < static_cast<std::size_t>(JOURNAL_HEADER_BYTES) ||
+        content.compare(0, JOURNAL_HEADER_BYTES, header()) != 0) {
+        return result;
+    }
+
+    std::unordered_map<std::uint64_t, OpenGame> games;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(content.data());
+    for (std::size_t offset = JOURNAL_HEADER_BYTES; offset + RECORD_BYTES <= content.size(); offset += RECORD_BYTES) {
+        const unsigned char* record = data + offset;
+        if (crc32(record, 10) != readLittleEndian(record + 10, 4)) {
+            TRIKI_WARNING(LOG_IO, "Diario: registro danado en el byte " << offset << ", se ignora el resto");
+            break;
+        }
+        std::uint64_t id = readLittleEndian(record + 1, 4) |
+                           (static_cast<std::uint64_t>(readLittleEndian(record + 5, 4)) << 32);
+        if (record[0] == RECORD_BEGIN) {
+            OpenGame game = emptyGame(id, record[9]);
+            if (game.rows == 0) {
+                TRIKI_WARNING(LOG_IO, "Diario: partida " << id << " de variante desconocida " << int(record[9])
+                              << ", se ignora");
+                games.erase(id);
+                continue;
+            }
+            games[id] = std::move(game);
+        } else if (record[0] == RECORD_MOVE) {
+            auto it = games.find(id);
+            if (it != games.end()) it->second.moves.push_back(record[9]);
+        } else if (record[0] == RECORD_END) {
+            games.erase(id);
+        }
+    }
+
+    for (auto& entry : games) {
+        result.push_back(std::move(entry.second));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const OpenGame& a, const OpenGame& b) { return a.id < b.id; });
+    return result;
+}
+
+std::vector<std::string> MoveJournal::recoverToSnapshots(const std::string& path) {
+    std::vector<std::string> names;
+    bool allSaved = true;
+    for (const auto& open : readOpenGames(path)) {
+        std::string name = "recuperada-" + std::to_string(open.id);
+        bool saved = false;
+        switch (variantCode(open.rows, open.cols, open.k)) {
+            case 0: saved = saveRecovered<Game>(open, name); break;
+            case 1: saved = saveRecovered<Game4x4>(open, name); break;
+            case 2: saved = saveRecovered<Game5x5>(open, name); break;
+            case 3: saved = saveRecovered<Gomoku>(open, name); break;
+        }
+        if (saved) {
+            names.push_back(name);
+        } else {
+            allSaved = false;
+        }
+    }
+    // Todo quedo en partidas normales: el diario vuelve a empezar vacio
+    if (allSaved && std::ifstream(path).good()) {
+        bool replaced;
+        writeFresh(path, "", replaced);
+    }
+    return names;
+}
@@ -0,0 +1,112 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// DIARIO DE JUGADAS (write-ahead log) CON COMMIT AGRUPADO
+// Cada jugada se agrega como un registro de 14 bytes a un archivo que solo
+// crece. Los registros se acumulan en memoria y un hilo de fondo los
+// escribe y hace fdatasync una vez por tanda: espera hasta
+// 'commitWindowMicros' desde el primer registro pendiente para juntar
+// varios en el mismo fsync. waitDurable() bloquea hasta que un registro
+// este en disco.
+//
+// FORMATO: cabecera de 8 bytes ("TKWL", version 1, 3 bytes en 0) y luego
+// registros de tamaño fijo:
+//   tipo (1: inicio, 2: jugada, 3: fin), id de partida (uint64 LE),
+//   casilla en las jugadas o variante en el inicio (0: 3x3, 1: 4x4,
+//   2: 5x5 k=4, 3: Gomoku 15x15), CRC-32 de los 10 bytes anteriores.
+// Un registro final incompleto o con CRC malo (corte a mitad de escritura)
+// se descarta al leer. Un archivo con otra cabecera no se abre.
+//
+// Si una escritura o un fdatasync falla, el diario queda fallido: nada de
+// lo que sigue se da por durable y waitDurable() devuelve false.
+class MoveJournal {
+public:
+    struct Config {
+        std::string path;
+        int commitWindowMicros = 1000;               // Espera maxima para agrupar
+        std::size_t maxBatchBytes = 1 << 16;         // Una tanda mas grande se escribe ya
+        std::size_t compactBytes = std::size_t(64) << 20;  // Compactar al superar este tamaño
+    };
+
+    struct Stats {
+        long long records = 0;
+        long long commits = 0;        // Llamadas a fdatasync
+        long long bytesWritten = 0;
+        long long compactions = 0;
+        double recordsPerCommit() const { return commits > 0 ? static_cast<double>(records) / commits : 0.0; }
+    };
+
+    // Partida empezada y no terminada segun el diario
+    struct OpenGame {
+        std::uint64_t id = 0;
+        int rows = 3;
+        int cols = 3;
+        int k = 3;
+        std::vector<unsigned char> moves;
+    };
+
+    explicit MoveJournal(const Config& config);
+    ~MoveJournal();  // Escribe lo pendiente antes de cerrar
+
+    bool isOpen() const;
+    bool hasFailed() const;  // Fallo una escritura: ya nada sera durable
+
+    // Cada registro devuelve su numero de secuencia para waitDurable(). 0 si
+    // no se registra: variante que el diario no conoce o casilla fuera del
+    // tablero.
+    std::uint64_t beginGame(std::uint64_t id, int rows = 3, int cols = 3, int k = 3);
+    std::uint64_t recordMove(std::uint64_t id, int cell);
+    std::uint64_t endGame(std::uint64_t id);
+    bool waitDurable(std::uint64_t sequence);  // false si el diario fallo
+    std::uint64_t getDurableSequence() const;
+
+    // Se llama desde el hilo de fondo despues de cada fsync (sin candado)
+    void setDurableCallback(const std::function<void()>& callback);
+
+    std::uint64_t newGameId();  // Mayor id visto + 1
+    Stats getStats() const;
+
+    // Lee un diario existente y devuelve sus partidas en curso (ordenadas por id)
+    static std::vector<OpenGame> readOpenGames(const std::string& path);
+
+    // Al arrancar: guarda cada partida en curso como una partida normal
+    // ("recuperada-<id>.triki") y deja el diario vacio. Devuelve los nombres.
+    static std::vector<std::string> recoverToSnapshots(const std::string& path);
+
+private:
+    Config config;
+    int fd = -1;
+    std::size_t fileBytes = 0;
+
+    mutable std::mutex lock;
+    std::condition_variable pendingReady;
+    std::condition_variable durableReady;
+    std::string pending;                                        // Registros aun no escritos
+    std::chrono::steady_clock::time_point firstPendingTime;
+    std::uint64_t lastSequence = 0;
+    std::uint64_t durableSequence = 0;
+    std::uint64_t maxGameId = 0;
+    std::function<void()> durableCallback;
+    std::unordered_map<std::uint64_t, OpenGame> openGames;  // Para compactar
+    Stats stats;
+    bool stopping = false;
+    bool failed = false;
+    std::thread flusher;
+
+    std::uint64_t append(int type, std::uint64_t id, int cell);
+    void flushLoop();
+    bool compact(std::unique_lock<std::mutex>& guard);
+    static bool writeFresh(const std::string& path, const std::string& records, bool& replaced);
+};
+
+#endif
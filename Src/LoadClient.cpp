@@ -0,0 +1,156 @@
+#include "LoadClient.h"
+#include "GameServer.h"
+#include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+struct ClientTotals {
+    long long games = 0;
+    long long errors = 0;
+    std::vector<float> latencies;  // Microsegundos por MOVE
+};
+
+// Conexion bloqueante con lectura por lineas
+class LineChannel {
+private:
+    int fd;
+    std::string buffer;
+
+public:
+    explicit LineChannel(int fd) : fd(fd) {}
+    ~LineChannel() { if (fd >= 0) close(fd); }
+
+    bool send(const std::string& line) {
+        std::size_t sent = 0;
+        while (sent < line.size()) {
+            ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    bool receive(std::string& line) {
+        std::size_t newline;
+        while ((newline = buffer.find('\n')) == std::string::npos) {
+            char chunk[1024];
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n <= 0) return false;
+            buffer.append(chunk, static_cast<std::size_t>(n));
+        }
+        line = buffer.substr(0, newline);
+        buffer.erase(0, newline + 1);
+        return true;
+    }
+};
+
+void playConnection(const LoadClientConfig& config, int id, std::atomic<bool>& failed, ClientTotals& totals) {
+    int fd = connectToServer(config.address);
+    if (fd < 0) {
+        failed.store(true);
+        return;
+    }
+    LineChannel channel(fd);
+    std::uint64_t rng = mixSeed(config.seed, id);
+    totals.latencies.reserve(static_cast<std::size_t>(config.gamesPerConnection) * 9);
+
+    std::string reply;
+    for (int g = 0; g < config.gamesPerConnection; g++) {
+        if (!channel.send("NEW\n") || !channel.receive(reply) || reply.compare(0, 3, "OK ") != 0) {
+            totals.errors++;
+            return;
+        }
+        std::string session = reply.substr(3);
+        std::string board = ".........";
+
+        while (true) {
+            // Casilla libre al azar segun el ultimo estado recibido
+            int empties[9];
+            int count = 0;
+            for (int cell = 0; cell < 9; cell++) {
+                if (board[cell] == '.') empties[count++] = cell;
+            }
+            int cell = empties[nextRandom(rng) % count];
+
+            auto start = std::chrono::steady_clock::now();
+            if (!channel.send("MOVE " + session + " " + std::to_string(cell / 3) + " " +
+                              std::to_string(cell % 3) + "\n") ||
+                !channel.receive(reply)) {
+                totals.errors++;
+                return;
+            }
+            auto micros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start);
+            totals.latencies.push_back(micros.count());
+
+            // Respuesta: "OK <tablero> <turno> <resultado>"
+            if (reply.size() < 16 || reply.compare(0, 3, "OK ") != 0) {
+                totals.errors++;
+                break;
+            }
+            board = reply.substr(3, 9);
+            if (reply.compare(15, std::string::npos, "PLAYING") != 0) break;
+        }
+
+        if (!channel.send("END " + session + "\n") || !channel.receive(reply)) {
+            totals.errors++;
+            return;
+        }
+        totals.games++;
+    }
+    channel.send("QUIT\n");
+    channel.receive(reply);
+}
+
+}
+
+bool runLoadClient(const LoadClientConfig& config, LoadClientStats& stats) {
+    const int connections = std::max(1, config.connections);
+    std::vector<ClientTotals> totals(connections);
+    std::atomic<bool> failed{false};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < connections; i++) {
+        threads.emplace_back(playConnection, std::cref(config), i, std::ref(failed), std::ref(totals[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    stats = LoadClientStats();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<float> latencies;
+    for (const auto& t : totals) {
+        stats.games += t.games;
+        stats.errors += t.errors;
+        latencies.insert(latencies.end(), t.latencies.begin(), t.latencies.end());
+    }
+    stats.moves = static_cast<long long>(latencies.size());
+
+    // Percentiles con nth_element: no hace falta ordenar todo
+    if (!latencies.empty()) {
+        auto percentile = [&latencies](double p) {
+            std::size_t k = static_cast<std::size_t>(p * (latencies.size() - 1));
+            std::nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+            return static_cast<double>(latencies[k]);
+        };
+        stats.p50Micros = percentile(0.50);
+        stats.p99Micros = percentile(0.99);
+        stats.maxMicros = *std::max_element(latencies.begin(), latencies.end());
+    }
+
+    if (failed.load()) {
+        std::cerr << "[ERROR] No se pudo conectar a " << config.address << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef LOADCLIENT_H
+#define LOADCLIENT_H
+
+#include <cstdint>
+#include <string>
+
+// GENERADOR DE CARGA PARA EL SERVIDOR DE PARTIDAS
+// Abre varias conexiones (un hilo por conexion) y en cada una juega
+// partidas completas con jugadas aleatorias validas, midiendo el tiempo
+// de ida y vuelta de cada MOVE.
+struct LoadClientConfig {
+    std::string address = "7777";   // Igual que GameServer::Config::address
+    int connections = 16;
+    int gamesPerConnection = 1000;
+    std::uint64_t seed = 12345;
+};
+
+struct LoadClientStats {
+    long long games = 0;
+    long long moves = 0;
+    long long errors = 0;
+    double seconds = 0.0;
+    double p50Micros = 0.0;   // Latencia de MOVE
+    double p99Micros = 0.0;
+    double maxMicros = 0.0;
+
+    double movesPerSecond() const { return seconds > 0.0 ? moves / seconds : 0.0; }
+};
+
+// Devuelve false si alguna conexion no pudo abrirse
+bool runLoadClient(const LoadClientConfig& config, LoadClientStats& stats);
+
+#endif
@@ -0,0 +1,210 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+std::atomic<int> Logger::minLevel{LOG_INFO};
+std::atomic<unsigned> Logger::categories{LOG_ALL};
+
+namespace {
+
+const char* levelName(int level) {
+    static const char* names[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+    return (level >= 0 && level < LOG_OFF) ? names[level] : "?";
+}
+
+const char* categoryName(unsigned category) {
+    switch (category) {
+        case LOG_MEMORY: return "memory";
+        case LOG_IO: return "io";
+        case LOG_GAME: return "game";
+        default: return "general";
+    }
+}
+
+class LogRing;
+
+// El anillo y su hilo se crean con el primer mensaje habilitado. El anillo no
+// se libera nunca: otros objetos estaticos (SaveExecutor::shared(),
+// FileManager::shared()) registran mientras se destruyen, a veces despues de
+// que termina el programa. Al salir solo se detiene el hilo (vaciando lo
+// pendiente) y lo que llegue despues se escribe directo en std::cerr.
+std::atomic<LogRing*> startedRing{nullptr};
+
+void writeLine(std::ostream& out, int level, unsigned category, const char* text, std::size_t length) {
+    out << '[' << levelName(level) << ' ' << categoryName(category) << "] ";
+    out.write(text, static_cast<std::streamsize>(length));
+    out << '\n';
+}
+
+// Anillo acotado con numeros de secuencia por casilla (Vyukov). Cada
+// productor reserva una casilla con un compare_exchange sobre 'head'; la
+// casilla se publica al escribir su secuencia. Solo el hilo de fondo lee.
+class LogRing {
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        unsigned char level;
+        unsigned char category;
+        unsigned short length;
+        char text[Logger::MAX_MESSAGE];
+    };
+
+    static const std::size_t MASK = Logger::RING_SLOTS - 1;
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<std::size_t> head{0};  // Proxima casilla a reservar
+    alignas(64) std::size_t tail = 0;              // Proxima casilla a leer (solo el consumidor)
+    alignas(64) std::atomic<long long> pushed{0};
+    std::atomic<long long> written{0};
+    std::atomic<long long> dropped{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> stopped{false};  // Ya no se aceptan mensajes
+    std::atomic<int> writers{0};       // Dentro de write() ahora mismo
+    std::thread drainer;
+
+    bool pop(std::ostream& out) {
+        Slot& slot = slots[tail & MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            return false;  // Vacio, o el productor aun no termina de copiar
+        }
+        writeLine(out, slot.level, slot.category, slot.text, slot.length);
+        slot.sequence.store(tail + Logger::RING_SLOTS, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    void drain() {
+        int idle = 0;
+        while (true) {
+            long long batch = 0;
+            while (pop(std::cout)) batch++;
+            if (batch > 0) {
+                std::cout.flush();  // Un solo flush por tanda
+                written.fetch_add(batch, std::memory_order_release);
+                idle = 0;
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire) &&
+                written.load(std::memory_order_relaxed) >= pushed.load(std::memory_order_acquire)) {
+                break;
+            }
+            // Espera breve: unas vueltas cediendo el procesador y luego dormir
+            if (++idle < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+public:
+    LogRing() : slots(new Slot[Logger::RING_SLOTS]) {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Logger::RING_SLOTS); i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        drainer = std::thread(&LogRing::drain, this);
+    }
+
+    // Al salir del programa. Quien ya entro a write() termina en el anillo
+    // y el hilo lo escribe antes de irse; quien llegue despues ve 'stopped'
+    void stop() {
+        stopped.store(true);
+        while (writers.load() > 0) {
+            std::this_thread::yield();
+        }
+        stopping.store(true, std::memory_order_release);
+        drainer.join();
+    }
+
+    void write(LogLevel level, LogCategory category, const std::string& message) {
+        writers.fetch_add(1);
+        if (!stopped.load()) {
+            push(level, category, message);
+            writers.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+        writers.fetch_sub(1, std::memory_order_release);
+        std::size_t length = std::min(message.size(), static_cast<std::size_t>(Logger::MAX_MESSAGE));
+        writeLine(std::cerr, level, category, message.data(), length);
+    }
+
+    void push(LogLevel level, LogCategory category, const std::string& message) {
+        std::size_t position = head.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[position & MASK];
+            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (sequence < position) {
+                dropped.fetch_add(1, std::memory_order_relaxed);  // Anillo lleno
+                return;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t length = std::min(message.size(), static_cast<std::size_t>(Logger::MAX_MESSAGE));
+        std::memcpy(slot->text, message.data(), length);
+        slot->length = static_cast<unsigned short>(length);
+        slot->level = static_cast<unsigned char>(level);
+        slot->category = static_cast<unsigned char>(category);
+        pushed.fetch_add(1, std::memory_order_release);
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void flush() {
+        if (stopped.load(std::memory_order_acquire)) return;  // std::cerr no guarda nada
+        long long target = pushed.load(std::memory_order_acquire);
+        while (written.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+    }
+
+    long long getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+};
+
+LogRing& ring() {
+    static LogRing* instance = [] {
+        LogRing* created = new LogRing();
+        startedRing.store(created, std::memory_order_release);
+        std::atexit([] { startedRing.load(std::memory_order_acquire)->stop(); });
+        return created;
+    }();
+    return *instance;
+}
+
+}
+
+void Logger::write(LogLevel level, LogCategory category, const std::string& message) {
+    ring().write(level, category, message);
+}
+
+void Logger::setLevel(LogLevel level) {
+    minLevel.store(level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() {
+    return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed));
+}
+
+void Logger::setCategories(unsigned mask) {
+    categories.store(mask, std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    LogRing* started = startedRing.load(std::memory_order_acquire);
+    if (started) started->flush();
+}
+
+long long Logger::getDropped() {
+    LogRing* started = startedRing.load(std::memory_order_acquire);
+    return started ? started->getDropped() : 0;
+}
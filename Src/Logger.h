@@ -0,0 +1,79 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+// REGISTRO ASINCRONO POR NIVELES Y CATEGORIAS
+// Los mensajes habilitados se copian a un anillo sin bloqueos (varios
+// productores, un consumidor) y un hilo de fondo los escribe en std::cout.
+// Quien registra nunca espera: si el anillo esta lleno el mensaje se
+// descarta y se cuenta en getDropped(). Despues de salir de main (al
+// destruir los objetos estaticos) los mensajes van directo a std::cerr.
+//
+// Interruptor en compilacion: -DTRIKI_LOG_LEVEL=N elimina todo mensaje de
+// nivel menor que N (4 = sin registro). Esos mensajes no generan codigo.
+enum LogLevel {
+    LOG_DEBUG = 0,
+    LOG_INFO,
+    LOG_WARNING,
+    LOG_ERROR,
+    LOG_OFF
+};
+
+// Categorias combinables como mascara de bits
+enum LogCategory : unsigned {
+    LOG_MEMORY = 1u << 0,  // Reserva y liberacion de objetos
+    LOG_IO = 1u << 1,      // Archivos y directorios
+    LOG_GAME = 1u << 2,    // Estado de las partidas
+    LOG_ALL = 0xFFu
+};
+
+#ifndef TRIKI_LOG_LEVEL
+#define TRIKI_LOG_LEVEL 0
+#endif
+
+class Logger {
+public:
+    static const int RING_SLOTS = 1024;     // Potencia de 2
+    static const int MAX_MESSAGE = 240;     // Bytes por mensaje (se recorta)
+
+    // Filtro en tiempo de ejecucion: una sola carga atomica por consulta
+    static bool isEnabled(LogLevel level, LogCategory category) {
+        return level >= minLevel.load(std::memory_order_relaxed) &&
+               (category & categories.load(std::memory_order_relaxed)) != 0;
+    }
+
+    static void write(LogLevel level, LogCategory category, const std::string& message);
+
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+    static void setCategories(unsigned mask);
+
+    // Espera a que el hilo de fondo escriba todo lo pendiente
+    static void flush();
+    static long long getDropped();
+
+private:
+    static std::atomic<int> minLevel;
+    static std::atomic<unsigned> categories;
+};
+
+#define TRIKI_LOG(level, category, message)                               \
+    do {                                                                  \
+        if constexpr ((level) >= TRIKI_LOG_LEVEL) {                       \
+            if (Logger::isEnabled((level), (category))) {                 \
+                std::ostringstream trikiLogStream;                        \
+                trikiLogStream << message;                                \
+                Logger::write((level), (category), trikiLogStream.str()); \
+            }                                                             \
+        }                                                                 \
+    } while (0)
+
+#define TRIKI_DEBUG(category, message) TRIKI_LOG(LOG_DEBUG, category, message)
+#define TRIKI_INFO(category, message) TRIKI_LOG(LOG_INFO, category, message)
+#define TRIKI_WARNING(category, message) TRIKI_LOG(LOG_WARNING, category, message)
+#define TRIKI_ERROR(category, message) TRIKI_LOG(LOG_ERROR, category, message)
+
+#endif
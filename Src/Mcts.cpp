@@ -0,0 +1,295 @@
+#include "Mcts.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// Nodo del arbol. Las recompensas se cuentan en medios puntos para el
+// jugador que hizo la jugada del nodo (victoria 2, empate 1, derrota 0).
+template <int Rows, int Cols, int K>
+struct MctsEngine<Rows, Cols, K>::Node {
+    enum State : int { LEAF = 0, EXPANDING, EXPANDED, FROZEN };
+
+    std::atomic<int> visits{0};
+    std::atomic<int> virtualLoss{0};
+    std::atomic<long long> reward{0};
+    std::atomic<int> state{LEAF};
+    Node* children = nullptr;
+    int childCount = 0;
+    short move = -1;
+    signed char mover = 0;      // Jugador que hizo 'move'
+    signed char terminal = -1;  // -1 sigue el juego; si no, recompensa fija del que movio
+
+    void init(int cell, int player, int terminalReward) {
+        visits.store(0, std::memory_order_relaxed);
+        virtualLoss.store(0, std::memory_order_relaxed);
+        reward.store(0, std::memory_order_relaxed);
+        state.store(LEAF, std::memory_order_relaxed);
+        children = nullptr;
+        childCount = 0;
+        move = static_cast<short>(cell);
+        mover = static_cast<signed char>(player);
+        terminal = static_cast<signed char>(terminalReward);
+    }
+};
+
+// Arena de nodos de un hilo: un solo bloque reservado al crear el motor
+template <int Rows, int Cols, int K>
+struct MctsEngine<Rows, Cols, K>::Arena {
+    std::unique_ptr<Node[]> nodes;
+    std::size_t capacity;
+    std::size_t used = 0;
+
+    explicit Arena(std::size_t capacity) : nodes(new Node[capacity]), capacity(capacity) {}
+
+    // nullptr si el arena se lleno: el nodo queda como hoja permanente
+    Node* allocate(std::size_t count) {
+        if (used + count > capacity) return nullptr;
+        Node* block = &nodes[used];
+        used += count;
+        return block;
+    }
+};
+
+template <int Rows, int Cols, int K>
+MctsEngine<Rows, Cols, K>::MctsEngine(const Config& config) : config(config) {
+    if (this->config.threads < 1) this->config.threads = 1;
+    if (this->config.maxPlayouts <= 0 && this->config.maxMillis <= 0) {
+        this->config.maxMillis = 1000;  // Siempre debe haber algun limite
+    }
+    for (int i = 0; i < this->config.threads; i++) {
+        arenas.emplace_back(new Arena(this->config.nodesPerThread));
+    }
+}
+
+template <int Rows, int Cols, int K>
+MctsEngine<Rows, Cols, K>::~MctsEngine() = default;
+
+template <int Rows, int Cols, int K>
+const typename MctsEngine<Rows, Cols, K>::Config& MctsEngine<Rows, Cols, K>::getConfig() const {
+    return config;
+}
+
+template <int Rows, int Cols, int K>
+void MctsEngine<Rows, Cols, K>::setSeed(std::uint64_t seed) {
+    config.seed = seed;
+}
+
+// Crea un hijo por casilla libre. Solo un hilo puede expandir cada nodo.
+template <int Rows, int Cols, int K>
+bool MctsEngine<Rows, Cols, K>::expand(Node* node, const BoardType& board, int player, Arena& arena) {
+    int expected = Node::LEAF;
+    if (!node->state.compare_exchange_strong(expected, Node::EXPANDING, std::memory_order_acq_rel)) {
+        return false;  // Otro hilo lo esta expandiendo
+    }
+
+    const int empties = CELLS - board.moveCount();
+    Node* block = arena.allocate(empties);
+    if (!block) {
+        node->state.store(Node::FROZEN, std::memory_order_release);
+        return false;
+    }
+
+    BoardType work = board;
+    int count = 0;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (!work.isEmpty(cell)) continue;
+        work.play(cell, player);
+        int terminal = work.completesLine(cell, player) ? 2 : work.isFull() ? 1 : -1;
+        work.unplay(cell, player);
+        block[count++].init(cell, player, terminal);
+    }
+
+    node->children = block;
+    node->childCount = count;
+    node->state.store(Node::EXPANDED, std::memory_order_release);
+    return true;
+}
+
+// UCT: media de recompensa + termino de exploracion. Las perdidas virtuales
+// cuentan como visitas sin recompensa.
+template <int Rows, int Cols, int K>
+typename MctsEngine<Rows, Cols, K>::Node* MctsEngine<Rows, Cols, K>::select(Node* node) const {
+    const double parentVisits = node->visits.load(std::memory_order_relaxed) +
+                                node->virtualLoss.load(std::memory_order_relaxed);
+    const double logParent = std::log(parentVisits + 1.0);
+
+    Node* best = nullptr;
+    double bestScore = -1.0;
+    for (int i = 0; i < node->childCount; i++) {
+        Node* child = &node->children[i];
+        double n = child->visits.load(std::memory_order_relaxed) +
+                   child->virtualLoss.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return child;  // Primero se prueba cada hijo una vez
+        }
+        double mean = child->reward.load(std::memory_order_relaxed) / (2.0 * n);
+        double score = mean + config.exploration * std::sqrt(logParent / n);
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+// Simulacion aleatoria hasta el final. Devuelve el ganador (0 / 1) o -1 si empate.
+template <int Rows, int Cols, int K>
+int MctsEngine<Rows, Cols, K>::rollout(BoardType& board, int player, std::uint64_t& rng) const {
+    short empties[CELLS];
+    int count = 0;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (board.isEmpty(cell)) empties[count++] = static_cast<short>(cell);
+    }
+
+    while (count > 0) {
+        int pick = static_cast<int>(nextRandom(rng) % count);
+        int cell = empties[pick];
+        empties[pick] = empties[--count];
+        board.play(cell, player);
+        if (board.completesLine(cell, player)) {
+            return player;
+        }
+        player ^= 1;
+    }
+    return -1;
+}
+
+template <int Rows, int Cols, int K>
+void MctsEngine<Rows, Cols, K>::worker(int id, Node* root, const BoardType& rootBoard, int rootPlayer,
+                                       std::chrono::steady_clock::time_point deadline) {
+    Arena& arena = *arenas[id];
+    std::uint64_t rng = mixSeed(config.seed, id);
+
+    Node* path[CELLS + 1];
+    const int vl = config.virtualLoss;
+    long long iteration = 0;
+
+    while (!stopFlag.load(std::memory_order_relaxed)) {
+        // Limites: simulaciones (contador global) y tiempo (cada 64 iteraciones)
+        if (config.maxPlayouts > 0 &&
+            playoutCount.fetch_add(1, std::memory_order_relaxed) >= config.maxPlayouts) {
+            break;
+        }
+        if (config.maxMillis > 0 && (++iteration & 63) == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+            stopFlag.store(true, std::memory_order_relaxed);
+            break;
+        }
+
+        // 1. Seleccion con perdida virtual
+        BoardType board = rootBoard;
+        int player = rootPlayer;
+        Node* node = root;
+        int depth = 0;
+        path[depth++] = node;
+        node->virtualLoss.fetch_add(vl, std::memory_order_relaxed);
+
+        while (node->terminal < 0) {
+            int state = node->state.load(std::memory_order_acquire);
+            if (state != Node::EXPANDED) {
+                // 2. Expansion (la raiz siempre; las demas tras 'expandVisits' visitas)
+                if (state != Node::LEAF ||
+                    (node != root && node->visits.load(std::memory_order_relaxed) < config.expandVisits) ||
+                    !expand(node, board, player, arena)) {
+                    break;
+                }
+            }
+            node = select(node);
+            board.play(node->move, player);
+            player ^= 1;
+            node->virtualLoss.fetch_add(vl, std::memory_order_relaxed);
+            path[depth++] = node;
+        }
+
+        // 3. Simulacion
+        int winner;
+        if (node->terminal >= 0) {
+            winner = (node->terminal == 2) ? node->mover : -1;
+        } else {
+            winner = rollout(board, player, rng);
+        }
+
+        // 4. Retropropagacion: cada nodo puntua para quien hizo su jugada
+        for (int i = 0; i < depth; i++) {
+            Node* n = path[i];
+            int reward = (winner < 0) ? 1 : (winner == n->mover ? 2 : 0);
+            n->reward.fetch_add(reward, std::memory_order_relaxed);
+            n->visits.fetch_add(1, std::memory_order_relaxed);
+            n->virtualLoss.fetch_sub(vl, std::memory_order_relaxed);
+        }
+
+        if (config.maxPlayouts <= 0) {
+            playoutCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+template <int Rows, int Cols, int K>
+typename MctsEngine<Rows, Cols, K>::Result MctsEngine<Rows, Cols, K>::search(const BoardType& board, int player) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(config.maxMillis);
+    
+    if (board.moveCount() == CELLS) {
+        return Result{};  // Tablero lleno: no hay jugadas
+    }
+
+    for (auto& arena : arenas) {
+        arena->used = 0;
+    }
+    playoutCount.store(0);
+    stopFlag.store(false);
+
+    // La raiz vive fuera de los arenas; quien mueve en ella es el rival
+    Node root;
+    root.init(-1, player ^ 1, -1);
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < config.threads; i++) {
+        threads.emplace_back(&MctsEngine::worker, this, i, &root, std::cref(board), player, deadline);
+    }
+    worker(0, &root, board, player, deadline);
+    stopFlag.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const auto& arena : arenas) {
+        result.nodesUsed += arena->used;
+    }
+
+    for (int i = 0; i < root.childCount; i++) {
+        const Node& child = root.children[i];
+        int visits = child.visits.load();
+        result.playouts += visits;
+        double winRate = visits > 0 ? child.reward.load() / (2.0 * visits) : 0.0;
+        result.moves.push_back(MoveStats{child.move, visits, winRate});
+    }
+    std::sort(result.moves.begin(), result.moves.end(),
+              [](const MoveStats& a, const MoveStats& b) { return a.visits > b.visits; });
+
+    // Una victoria inmediata siempre se juega, aunque tenga menos visitas
+    for (int i = 0; i < root.childCount; i++) {
+        if (root.children[i].terminal == 2) {
+            result.move = root.children[i].move;
+            return result;
+        }
+    }
+    if (!result.moves.empty()) {
+        result.move = result.moves.front().move;
+    }
+    return result;
+}
+
+template <int Rows, int Cols, int K>
+int MctsEngine<Rows, Cols, K>::bestMove(const BasicGame<Rows, Cols, K>& game) {
+    return search(game.getBoard(), playerIndex(game.getCurrentPlayer())).move;
+}
+
+// INSTANCIACION EXPLICITA - mismas variantes que Game
+template class MctsEngine<3, 3, 3>;
+template class MctsEngine<4, 4, 4>;
+template class MctsEngine<5, 5, 4>;
+template class MctsEngine<15, 15, 5>;
@@ -0,0 +1,76 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Game.h"
+
+// BUSQUEDA DE ARBOL MONTE CARLO (UCT) CON PARALELISMO DE ARBOL
+// Varios hilos comparten un mismo arbol; al bajar por un nodo cada hilo le
+// suma una "perdida virtual" para que los demas prefieran otras ramas.
+// Los nodos salen de un arena por hilo reservado de antemano, asi que las
+// simulaciones nunca llaman al asignador global. Pensado para tableros
+// demasiado grandes para resolver (15x15) con latencia acotada.
+template <int Rows, int Cols, int K>
+class MctsEngine {
+public:
+    using BoardType = Board<Rows, Cols, K>;
+    static constexpr int CELLS = BoardType::CELLS;
+
+    struct Config {
+        int threads = 1;
+        long long maxPlayouts = 0;      // 0 = sin limite de simulaciones
+        int maxMillis = 1000;           // 0 = sin limite de tiempo
+        double exploration = 1.4;       // Constante C de UCT
+        int virtualLoss = 3;
+        int expandVisits = 1;           // Visitas de una hoja antes de expandirla
+        std::size_t nodesPerThread = std::size_t(1) << 19;
+        std::uint64_t seed = 0x5DEECE66DULL;
+    };
+
+    // Estadisticas de cada jugada de la raiz
+    struct MoveStats {
+        int move;        // Casilla (fila*Cols + columna)
+        int visits;
+        double winRate;  // Puntos medios (victoria 1, empate 0.5) para quien mueve
+    };
+
+    struct Result {
+        int move = -1;                  // Jugada mas visitada
+        long long playouts = 0;
+        std::size_t nodesUsed = 0;
+        double seconds = 0.0;
+        std::vector<MoveStats> moves;   // Ordenadas de mas a menos visitas
+        double playoutsPerSecond() const { return seconds > 0.0 ? playouts / seconds : 0.0; }
+    };
+
+    explicit MctsEngine(const Config& config);
+    ~MctsEngine();
+
+    Result search(const BoardType& board, int player);
+    int bestMove(const BasicGame<Rows, Cols, K>& game);
+
+    const Config& getConfig() const;
+    void setSeed(std::uint64_t seed);  // Cambia la semilla de las proximas busquedas
+
+private:
+    struct Node;
+    struct Arena;
+
+    Config config;
+    std::vector<std::unique_ptr<Arena>> arenas;  // Uno por hilo
+    std::atomic<long long> playoutCount{0};
+    std::atomic<bool> stopFlag{false};
+
+    void worker(int id, Node* root, const BoardType& rootBoard, int rootPlayer,
+                std::chrono::steady_clock::time_point deadline);
+    bool expand(Node* node, const BoardType& board, int player, Arena& arena);
+    Node* select(Node* node) const;
+    int rollout(BoardType& board, int player, std::uint64_t& rng) const;
+};
+
+#endif
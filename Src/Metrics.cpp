@@ -0,0 +1,282 @@
+#include "Metrics.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+struct CounterInfo {
+    const char* name;
+    const char* help;
+};
+
+const CounterInfo COUNTERS[METRIC_COUNTER_COUNT] = {
+    {"triki_game_moves_total", "Llamadas a Game::makeMove"},
+    {"triki_game_winner_checks_total", "Llamadas a Game::checkWinner"},
+    {"triki_saves_total", "Partidas guardadas"},
+    {"triki_save_bytes_total", "Bytes de las partidas guardadas"},
+    {"triki_save_errors_total", "Guardados fallidos"},
+    {"triki_loads_total", "Partidas cargadas"},
+    {"triki_load_bytes_total", "Bytes de las partidas cargadas"},
+    {"triki_load_errors_total", "Cargas fallidas"},
+    {"triki_directory_scans_total", "Listados del directorio de partidas"},
+    {"triki_directory_scan_entries_total", "Partidas encontradas en los listados"},
+    {"triki_cleanups_total", "Llamadas a FileManager::cleanOldSaves"},
+    {"triki_cleanup_deletions_total", "Partidas borradas por cleanOldSaves"},
+};
+
+const CounterInfo HISTOGRAMS[METRIC_HISTOGRAM_COUNT] = {
+    {"triki_save_latency_seconds", "Latencia de saveGame"},
+    {"triki_load_latency_seconds", "Latencia de loadGame"},
+    {"triki_directory_scan_latency_seconds", "Latencia de listSavedGames"},
+    {"triki_cleanup_latency_seconds", "Latencia de cleanOldSaves"},
+};
+
+// Limites 'le' publicados (segundos); cada uno suma las cubetas HDR que
+// terminan antes, asi que el conteo es exacto hasta la resolucion de la cubeta
+const double EXPORTED_BOUNDS[] = {1e-6, 5e-6, 1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3,
+                                  1e-2, 5e-2, 0.1, 0.5, 1.0, 5.0, 10.0};
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}
+
+int Metrics::bucketIndex(std::uint64_t nanos) {
+    if (nanos < static_cast<std::uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(nanos);
+    }
+    int exponent = 63 - __builtin_clzll(nanos);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKETS - 1;
+    }
+    int sub = static_cast<int>((nanos >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+std::uint64_t Metrics::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<std::uint64_t>(index);
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BITS - 1;
+    std::uint64_t sub = static_cast<std::uint64_t>(index % SUB_BUCKETS);
+    std::uint64_t width = 1ULL << (exponent - SUB_BITS);
+    return ((SUB_BUCKETS + sub) << (exponent - SUB_BITS)) + width - 1;
+}
+
+std::uint64_t Metrics::Histogram::percentile(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+    std::uint64_t target = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            std::uint64_t bound = bucketUpperBound(i);
+            return bound < maxNanos ? bound : maxNanos;
+        }
+    }
+    return maxNanos;
+}
+
+struct Metrics::Registry {
+    std::mutex lock;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+Metrics::Registry& Metrics::registry() {
+    static Registry instance;
+    return instance;
+}
+
+Metrics::Shard* Metrics::registerShard() {
+    Registry& all = registry();
+    std::lock_guard<std::mutex> guard(all.lock);
+    all.shards.push_back(std::make_unique<Shard>());
+    return all.shards.back().get();
+}
+
+void Metrics::record(MetricHistogram histogram, std::uint64_t nanos) {
+    HistogramShard& shard = local().histograms[histogram];
+    relaxedAdd(shard.buckets[bucketIndex(nanos)], 1);
+    relaxedAdd(shard.sumNanos, nanos);
+    if (nanos > shard.maxNanos.load(std::memory_order_relaxed)) {
+        shard.maxNanos.store(nanos, std::memory_order_relaxed);
+    }
+}
+
+Metrics::Snapshot Metrics::snapshot() {
+    Snapshot result;
+    Registry& all = registry();
+    std::lock_guard<std::mutex> guard(all.lock);
+    for (const auto& shard : all.shards) {
+        result.threads++;
+        for (int c = 0; c < METRIC_COUNTER_COUNT; c++) {
+            result.counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+        }
+        for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+            const HistogramShard& from = shard->histograms[h];
+            Histogram& to = result.histograms[h];
+            for (int b = 0; b < BUCKETS; b++) {
+                std::uint64_t value = from.buckets[b].load(std::memory_order_relaxed);
+                to.buckets[b] += value;
+                to.count += value;
+            }
+            to.sumNanos += from.sumNanos.load(std::memory_order_relaxed);
+            std::uint64_t max = from.maxNanos.load(std::memory_order_relaxed);
+            if (max > to.maxNanos) to.maxNanos = max;
+        }
+    }
+    return result;
+}
+
+void Metrics::writePrometheus(std::ostream& out) {
+    writePrometheus(out, snapshot());
+}
+
+void Metrics::writePrometheus(std::ostream& out, const Snapshot& snapshot) {
+    for (int c = 0; c < METRIC_COUNTER_COUNT; c++) {
+        out << "# HELP " << COUNTERS[c].name << " " << COUNTERS[c].help << "\n";
+        out << "# TYPE " << COUNTERS[c].name << " counter\n";
+        out << COUNTERS[c].name << " " << snapshot.counters[c] << "\n";
+    }
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+        const Histogram& histogram = snapshot.histograms[h];
+        const char* name = HISTOGRAMS[h].name;
+        out << "# HELP " << name << " " << HISTOGRAMS[h].help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+        int bucket = 0;
+        std::uint64_t cumulative = 0;
+        for (double bound : EXPORTED_BOUNDS) {
+            std::uint64_t boundNanos = static_cast<std::uint64_t>(bound * 1e9);
+            while (bucket < BUCKETS && bucketUpperBound(bucket) <= boundNanos) {
+                cumulative += histogram.buckets[bucket++];
+            }
+            out << name << "_bucket{le=\"" << bound << "\"} " << cumulative << "\n";
+        }
+        out << name << "_bucket{le=\"+Inf\"} " << histogram.count << "\n";
+        out << name << "_sum " << static_cast<double>(histogram.sumNanos) / 1e9 << "\n";
+        out << name << "_count " << histogram.count << "\n";
+    }
+    out << "# HELP triki_metrics_threads Hilos con metricas registradas\n";
+    out << "# TYPE triki_metrics_threads gauge\n";
+    out << "triki_metrics_threads " << snapshot.threads << "\n";
+}
+
+MetricsExporter::MetricsExporter(const std::string& exportPath, int periodMillis)
+    : periodMillis(periodMillis > 0 ? periodMillis : 1000) {
+    if (pipe(wakeFd) != 0) {
+        TRIKI_ERROR(LOG_IO, "Metricas: no se pudo crear la tuberia: " << std::strerror(errno));
+        return;
+    }
+    socketMode = endsWith(exportPath, ".sock");
+    if (socketMode) {
+        sockaddr_un addr{};
+        if (exportPath.size() >= sizeof(addr.sun_path)) {
+            TRIKI_ERROR(LOG_IO, "Ruta de socket demasiado larga: " << exportPath);
+            return;
+        }
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, exportPath.c_str());
+        unlink(exportPath.c_str());  // Socket viejo de una ejecucion anterior
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            listen(listenFd, 16) < 0) {
+            TRIKI_ERROR(LOG_IO, "No se pudo abrir " << exportPath << ": " << std::strerror(errno));
+            if (listenFd >= 0) ::close(listenFd);
+            listenFd = -1;
+            return;
+        }
+    }
+    path = exportPath;
+    worker = std::thread([this] {
+        if (socketMode) {
+            serveSocket();
+        } else {
+            rewriteFile();
+        }
+    });
+    TRIKI_INFO(LOG_IO, "Metricas en " << path);
+}
+
+MetricsExporter::~MetricsExporter() {
+    if (worker.joinable()) {
+        char wake = 1;
+        ssize_t ignored = write(wakeFd[1], &wake, 1);
+        (void)ignored;
+        worker.join();
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        unlink(path.c_str());
+    }
+    for (int fd : wakeFd) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+// Cada conexion recibe una foto y se cierra; el cliente no envia nada
+void MetricsExporter::serveSocket() {
+    pollfd fds[2] = {{wakeFd[0], POLLIN, 0}, {listenFd, POLLIN, 0}};
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[0].revents) {
+            return;
+        }
+        if (!(fds[1].revents & POLLIN)) {
+            continue;
+        }
+        int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        std::ostringstream text;
+        Metrics::writePrometheus(text);
+        const std::string body = text.str();
+        std::size_t sent = 0;
+        while (sent < body.size()) {
+            ssize_t written = send(client, body.data() + sent, body.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) break;
+            sent += static_cast<std::size_t>(written);
+        }
+        ::close(client);
+    }
+}
+
+// Reescribe el archivo entero en cada periodo (y una ultima vez al cerrar)
+void MetricsExporter::rewriteFile() {
+    const std::string tempPath = path + ".tmp";
+    pollfd wake = {wakeFd[0], POLLIN, 0};
+    bool stopping = false;
+    for (;;) {
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            Metrics::writePrometheus(file);
+        }
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            TRIKI_WARNING(LOG_IO, "No se pudo escribir " << path << ": " << std::strerror(errno));
+        }
+        if (stopping) {
+            return;
+        }
+        int ready = poll(&wake, 1, periodMillis);
+        stopping = ready > 0 || (ready < 0 && errno != EINTR);
+    }
+}
@@ -0,0 +1,421 @@
+#include "ParallelSolver.h"
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+// ===== TABLA COMPARTIDA =====
+
+namespace {
+
+// Datos empaquetados: puntaje desplazado en los bits 0-7, cota en 8-9
+std::uint64_t packEntry(int score, SharedTable::Bound bound) {
+    return static_cast<std::uint64_t>(score + 128) | (static_cast<std::uint64_t>(bound) << 8);
+}
+
+std::uint64_t slotIndex(std::uint64_t key) {
+    return key ^ (key >> 29) ^ (key >> 47);
+}
+
+}
+
+SharedTable::SharedTable(int tableBits) {
+    std::size_t size = std::size_t(1) << tableBits;
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+bool SharedTable::probe(std::uint64_t key, int& score, Bound& bound) const {
+    const Slot& slot = slots[slotIndex(key) & mask];
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || data == 0) {
+        return false;  // Vacia, de otra posicion o escrita a medias
+    }
+    score = static_cast<int>(data & 0xFF) - 128;
+    bound = static_cast<Bound>((data >> 8) & 3);
+    return true;
+}
+
+void SharedTable::store(std::uint64_t key, int score, Bound bound) {
+    Slot& slot = slots[slotIndex(key) & mask];
+    std::uint64_t data = packEntry(score, bound);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void SharedTable::clear() {
+    for (std::uint64_t i = 0; i <= mask; i++) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ===== ESTRUCTURAS INTERNAS DEL SOLUCIONADOR =====
+
+// Nodo cuyos hermanos menores se estan buscando en paralelo
+template <int Rows, int Cols, int K>
+struct ParallelSolver<Rows, Cols, K>::SplitPoint {
+    SplitPoint* parent;
+    int beta;
+    std::atomic<int> alpha;
+    std::atomic<int> pending;     // Tareas que aun no terminan
+    std::atomic<bool> cutoff{false};
+
+    // Mejor puntaje y su jugada, juntos bajo el mismo candado
+    std::mutex bestLock;
+    int bestScore;
+    int bestMove;
+
+    SplitPoint(SplitPoint* parent, int alpha, int beta, int bestScore, int bestMove, int pending)
+        : parent(parent), beta(beta), alpha(alpha), pending(pending), bestScore(bestScore), bestMove(bestMove) {}
+
+    // Resultado de un hermano buscado con ventana (searchAlpha, beta). Un
+    // puntaje <= searchAlpha es solo una cota superior (fallo bajo): puede
+    // subir el puntaje, pero nunca cambia la jugada, ni siquiera en empate.
+    void offer(int score, int searchAlpha, int cell) {
+        std::lock_guard<std::mutex> guard(bestLock);
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > searchAlpha) bestMove = cell;
+        }
+    }
+
+    // Un nodo queda cancelado si el o cualquiera de sus ancestros tuvo un corte
+    bool aborted() const {
+        for (const SplitPoint* sp = this; sp; sp = sp->parent) {
+            if (sp->cutoff.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+};
+
+// Busqueda de un hermano menor: el tablero ya tiene la jugada aplicada
+template <int Rows, int Cols, int K>
+struct ParallelSolver<Rows, Cols, K>::Task {
+    SplitPoint* sp;
+    BoardType board;
+    Hash hash;
+    int cell;
+    int player;  // Jugador que hizo la jugada 'cell'
+};
+
+template <int Rows, int Cols, int K>
+struct ParallelSolver<Rows, Cols, K>::Worker {
+    int id;
+    std::mutex lock;          // Protege la cola; la tabla no usa bloqueos
+    std::deque<Task> tasks;   // El dueño usa el final, los ladrones el frente
+    ThreadStats stats;
+    std::uint32_t rng;
+    std::thread thread;
+};
+
+namespace {
+
+// Maximo atomico con compare-and-swap
+void atomicMax(std::atomic<int>& target, int value) {
+    int current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_acq_rel)) {
+    }
+}
+
+}
+
+// ===== SOLUCIONADOR =====
+
+template <int Rows, int Cols, int K>
+ParallelSolver<Rows, Cols, K>::ParallelSolver(int threads, int tableBits, int minSplitEmpties)
+    : threadCount(threads > 0 ? threads : 1),
+      minSplitEmpties(minSplitEmpties),
+      table(tableBits) {
+}
+
+template <int Rows, int Cols, int K>
+ParallelSolver<Rows, Cols, K>::~ParallelSolver() = default;
+
+// Toma una tarea propia (LIFO) o roba una ajena (FIFO) y la ejecuta
+template <int Rows, int Cols, int K>
+bool ParallelSolver<Rows, Cols, K>::helpOnce(Worker& self) {
+    Task task;
+    bool found = false;
+
+    {
+        std::lock_guard<std::mutex> guard(self.lock);
+        if (!self.tasks.empty()) {
+            task = self.tasks.back();
+            self.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    if (!found && threadCount > 1) {
+        // Victima inicial aleatoria (xorshift por hilo) para repartir los robos
+        self.rng ^= self.rng << 13;
+        self.rng ^= self.rng >> 17;
+        self.rng ^= self.rng << 5;
+        int start = static_cast<int>(self.rng % threadCount);
+        for (int i = 0; i < threadCount && !found; i++) {
+            Worker& victim = *workers[(start + i) % threadCount];
+            if (&victim == &self) continue;
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                found = true;
+                self.stats.steals++;
+            }
+        }
+    }
+
+    if (found) {
+        runTask(task, self);
+    }
+    return found;
+}
+
+template <int Rows, int Cols, int K>
+void ParallelSolver<Rows, Cols, K>::runTask(Task& task, Worker& self) {
+    SplitPoint* sp = task.sp;
+
+    if (sp->aborted()) {
+        self.stats.tasksCancelled++;
+    } else {
+        self.stats.tasksRun++;
+        int alpha = sp->alpha.load(std::memory_order_acquire);
+        int score = -search(task.board, task.hash, task.player ^ 1, -sp->beta, -alpha, sp, self);
+
+        if (!sp->aborted()) {
+            sp->offer(score, alpha, task.cell);
+            atomicMax(sp->alpha, score);
+            if (score >= sp->beta) {
+                sp->cutoff.store(true, std::memory_order_release);  // Cancela a los hermanos
+            }
+        }
+    }
+
+    sp->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+template <int Rows, int Cols, int K>
+int ParallelSolver<Rows, Cols, K>::search(BoardType& board, Hash& hash, int player, int alpha, int beta,
+                                          SplitPoint* parent, Worker& self) {
+    static constexpr MoveOrder<Rows, Cols, K> ORDER = MoveOrder<Rows, Cols, K>::build();
+
+    self.stats.nodes++;
+    if (parent && parent->aborted()) {
+        return 0;  // El resultado se descarta
+    }
+
+    const int empties = CELLS - board.moveCount();
+    if (empties == 0) {
+        return 0;
+    }
+
+    // Consultar la tabla compartida
+    const std::uint64_t key = hash.canonical(player);
+    int stored;
+    SharedTable::Bound bound;
+    if (table.probe(key, stored, bound)) {
+        if (bound == SharedTable::EXACT) return stored;
+        if (bound == SharedTable::LOWER && stored > alpha) alpha = stored;
+        if (bound == SharedTable::UPPER && stored < beta) beta = stored;
+        if (alpha >= beta) return stored;
+    }
+
+    // Jugadas disponibles; una victoria inmediata es el mejor resultado posible
+    int moves[CELLS];
+    int count = 0;
+    for (int cell : ORDER.cells) {
+        if (!board.isEmpty(cell)) continue;
+        board.play(cell, player);
+        bool wins = board.completesLine(cell, player);
+        board.unplay(cell, player);
+        if (wins) {
+            table.store(key, empties, SharedTable::EXACT);
+            return empties;
+        }
+        moves[count++] = cell;
+    }
+
+    const int alphaOrig = alpha;
+
+    // Hermano mayor: siempre en serie
+    board.play(moves[0], player);
+    hash.toggle(moves[0], player);
+    int best = -search(board, hash, player ^ 1, -beta, -alpha, parent, self);
+    hash.toggle(moves[0], player);
+    board.unplay(moves[0], player);
+    if (parent && parent->aborted()) return 0;
+    if (best > alpha) alpha = best;
+
+    if (alpha < beta && count > 1) {
+        if (empties >= minSplitEmpties) {
+            // Hermanos menores en paralelo: se publican en orden inverso para
+            // que el dueño tome primero los mejor ordenados
+            SplitPoint sp(parent, alpha, beta, best, moves[0], count - 1);
+            {
+                std::lock_guard<std::mutex> guard(self.lock);
+                for (int i = count - 1; i >= 1; i--) {
+                    Task task{&sp, board, hash, moves[i], player};
+                    task.board.play(moves[i], player);
+                    task.hash.toggle(moves[i], player);
+                    self.tasks.push_back(task);
+                }
+            }
+            while (sp.pending.load(std::memory_order_acquire) > 0) {
+                if (!helpOnce(self)) std::this_thread::yield();
+            }
+            if (parent && parent->aborted()) return 0;
+            std::lock_guard<std::mutex> guard(sp.bestLock);
+            best = sp.bestScore;
+        } else {
+            for (int i = 1; i < count; i++) {
+                board.play(moves[i], player);
+                hash.toggle(moves[i], player);
+                int score = -search(board, hash, player ^ 1, -beta, -alpha, parent, self);
+                hash.toggle(moves[i], player);
+                board.unplay(moves[i], player);
+                if (parent && parent->aborted()) return 0;
+                if (score > best) best = score;
+                if (score > alpha) alpha = score;
+                if (alpha >= beta) break;
+            }
+        }
+    }
+
+    table.store(key, best, (best <= alphaOrig) ? SharedTable::UPPER
+                         : (best >= beta) ? SharedTable::LOWER : SharedTable::EXACT);
+    return best;
+}
+
+template <int Rows, int Cols, int K>
+void ParallelSolver<Rows, Cols, K>::workerLoop(int id) {
+    Worker& self = *workers[id];
+    while (!finished.load(std::memory_order_acquire)) {
+        if (!helpOnce(self)) std::this_thread::yield();
+    }
+}
+
+template <int Rows, int Cols, int K>
+typename ParallelSolver<Rows, Cols, K>::Result
+ParallelSolver<Rows, Cols, K>::solve(const BoardType& board, int player) {
+    static constexpr MoveOrder<Rows, Cols, K> ORDER = MoveOrder<Rows, Cols, K>::build();
+
+    auto start = std::chrono::steady_clock::now();
+
+    workers.clear();
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(new Worker());
+        workers[i]->id = i;
+        workers[i]->rng = 0x9E3779B9u * (i + 1);
+    }
+    finished.store(false);
+    for (int i = 1; i < threadCount; i++) {
+        workers[i]->thread = std::thread(&ParallelSolver::workerLoop, this, i);
+    }
+
+    // La raiz la busca el hilo principal (trabajador 0): primera jugada en
+    // serie y el resto repartido siempre, sin importar minSplitEmpties
+    Worker& self = *workers[0];
+    BoardType work = board;
+    const int empties = CELLS - work.moveCount();
+    Result result{-1, 0};
+
+    int moves[CELLS];
+    int count = 0;
+    for (int cell : ORDER.cells) {
+        if (!work.isEmpty(cell)) continue;
+        work.play(cell, player);
+        bool wins = work.completesLine(cell, player);
+        work.unplay(cell, player);
+        if (wins) {
+            result = Result{cell, empties};
+            count = 0;
+            break;
+        }
+        moves[count++] = cell;
+    }
+
+    if (count > 0) {
+        Hash hash = Hash::of(work);
+        work.play(moves[0], player);
+        hash.toggle(moves[0], player);
+        int first = -search(work, hash, player ^ 1, -CELLS - 1, CELLS + 1, nullptr, self);
+        hash.toggle(moves[0], player);
+        work.unplay(moves[0], player);
+
+        SplitPoint root(nullptr, first, CELLS + 1, first, moves[0], count - 1);
+        {
+            std::lock_guard<std::mutex> guard(self.lock);
+            for (int i = count - 1; i >= 1; i--) {
+                Task task{&root, work, hash, moves[i], player};
+                task.board.play(moves[i], player);
+                task.hash.toggle(moves[i], player);
+                self.tasks.push_back(task);
+            }
+        }
+        while (root.pending.load(std::memory_order_acquire) > 0) {
+            if (!helpOnce(self)) std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> guard(root.bestLock);
+        result = Result{root.bestMove, root.bestScore};
+    }
+
+    finished.store(true, std::memory_order_release);
+    for (int i = 1; i < threadCount; i++) {
+        workers[i]->thread.join();
+    }
+
+    stats.clear();
+    for (const auto& worker : workers) {
+        stats.push_back(worker->stats);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+template <int Rows, int Cols, int K>
+int ParallelSolver<Rows, Cols, K>::getThreadCount() const {
+    return threadCount;
+}
+
+template <int Rows, int Cols, int K>
+double ParallelSolver<Rows, Cols, K>::getSeconds() const {
+    return seconds;
+}
+
+template <int Rows, int Cols, int K>
+long long ParallelSolver<Rows, Cols, K>::getTotalNodes() const {
+    long long total = 0;
+    for (const auto& s : stats) total += s.nodes;
+    return total;
+}
+
+template <int Rows, int Cols, int K>
+const std::vector<typename ParallelSolver<Rows, Cols, K>::ThreadStats>&
+ParallelSolver<Rows, Cols, K>::getThreadStats() const {
+    return stats;
+}
+
+template <int Rows, int Cols, int K>
+void ParallelSolver<Rows, Cols, K>::printSummary(std::ostream& out) const {
+    out << "\n=== RESUMEN POR HILO (" << Rows << "x" << Cols << ", k=" << K << ") ===\n";
+    out << std::setw(5) << "Hilo" << std::setw(14) << "Nodos" << std::setw(10) << "Robos"
+        << std::setw(10) << "Tareas" << std::setw(12) << "Canceladas" << "\n";
+    for (std::size_t i = 0; i < stats.size(); i++) {
+        out << std::setw(5) << i << std::setw(14) << stats[i].nodes << std::setw(10) << stats[i].steals
+            << std::setw(10) << stats[i].tasksRun << std::setw(12) << stats[i].tasksCancelled << "\n";
+    }
+    long long total = getTotalNodes();
+    out << "Total: " << total << " nodos en " << seconds << " s ("
+        << static_cast<long long>(seconds > 0 ? total / seconds : 0) << " nodos/s)\n";
+    out << "====================================\n";
+}
+
+// INSTANCIACION EXPLICITA - tableros con solucion exacta practica
+template class ParallelSolver<3, 3, 3>;
+template class ParallelSolver<4, 4, 4>;
+template class ParallelSolver<5, 5, 4>;
@@ -0,0 +1,95 @@
+#ifndef PARALLELSOLVER_H
+#define PARALLELSOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include "Board.h"
+#include "SearchTables.h"
+
+// TABLA DE TRANSPOSICION COMPARTIDA SIN BLOQUEOS
+// Cada entrada guarda (clave ^ datos) y datos en dos atomicos de 64 bits.
+// Si otro hilo escribe a medias, la verificacion clave ^ datos falla y la
+// entrada simplemente se ignora (esquema "lockless hashing").
+class SharedTable {
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> check{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+    std::unique_ptr<Slot[]> slots;
+    std::uint64_t mask;
+
+public:
+    enum Bound : std::uint8_t { EMPTY = 0, EXACT, LOWER, UPPER };
+
+    explicit SharedTable(int tableBits);
+
+    bool probe(std::uint64_t key, int& score, Bound& bound) const;
+    void store(std::uint64_t key, int score, Bound bound);
+    void clear();
+};
+
+// BUSQUEDA PARALELA CON ROBO DE TRABAJO (Young Brothers Wait)
+// En cada nodo el primer hijo se busca en serie; sus hermanos se publican
+// como tareas en la cola del hilo, de donde otros hilos ociosos las roban.
+// Mientras espera, el dueño del nodo ejecuta tareas propias o ajenas.
+// Cuando un hermano produce un corte beta, las tareas pendientes de ese
+// nodo (y de sus descendientes) se cancelan.
+template <int Rows, int Cols, int K>
+class ParallelSolver {
+public:
+    using BoardType = Board<Rows, Cols, K>;
+    static constexpr int CELLS = BoardType::CELLS;
+    static_assert(CELLS <= 32, "El solucionador exacto solo admite tableros de hasta 32 casillas");
+
+    struct Result {
+        int move;   // Casilla (fila*Cols + columna), -1 si no hay jugadas
+        int score;  // > 0 gana quien mueve, 0 empate, < 0 pierde
+    };
+
+    // Estadisticas por hilo
+    struct ThreadStats {
+        long long nodes = 0;
+        long long steals = 0;       // Tareas robadas de otros hilos
+        long long tasksRun = 0;     // Tareas ejecutadas (propias o robadas)
+        long long tasksCancelled = 0;
+    };
+
+    // minSplitEmpties: solo se reparte trabajo en nodos con al menos esas casillas libres
+    ParallelSolver(int threads, int tableBits = 22, int minSplitEmpties = 7);
+    ~ParallelSolver();
+
+    Result solve(const BoardType& board, int player);
+
+    int getThreadCount() const;
+    double getSeconds() const;
+    long long getTotalNodes() const;
+    const std::vector<ThreadStats>& getThreadStats() const;
+    void printSummary(std::ostream& out) const;
+
+private:
+    struct SplitPoint;
+    struct Task;
+    struct Worker;
+
+    int threadCount;
+    int minSplitEmpties;
+    SharedTable table;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<ThreadStats> stats;
+    std::atomic<bool> finished{false};
+    double seconds = 0.0;
+
+    using Hash = SymmetricHash<Rows, Cols>;  // Clave de la tabla, al dia con cada jugada
+
+    int search(BoardType& board, Hash& hash, int player, int alpha, int beta, SplitPoint* parent, Worker& self);
+    void runTask(Task& task, Worker& self);
+    bool helpOnce(Worker& self);
+    void workerLoop(int id);
+};
+
+#endif
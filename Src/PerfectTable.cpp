@@ -0,0 +1,167 @@
+#include "PerfectTable.h"
+#include <array>
+
+namespace {
+
+using Board3 = Board<3, 3, 3>;
+
+// Conversion de un bitboard de 9 bits a su valor en base 3 (cada bit
+// encendido aporta 3^casilla). 512 entradas de 2 bytes.
+constexpr std::array<unsigned short, 512> buildTernary() {
+    std::array<unsigned short, 512> table{};
+    for (int bits = 0; bits < 512; bits++) {
+        int value = 0, power = 1;
+        for (int cell = 0; cell < 9; cell++) {
+            if ((bits >> cell) & 1) value += power;
+            power *= 3;
+        }
+        table[bits] = static_cast<unsigned short>(value);
+    }
+    return table;
+}
+
+constexpr std::array<unsigned short, 512> TERNARY = buildTernary();
+
+constexpr int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+constexpr unsigned short MOVES_MASK = 0x1FF;
+constexpr int VALUE_SHIFT = 9;
+constexpr unsigned short REACHABLE_BIT = 1u << 11;
+
+constexpr bool hasLine(int bits) {
+    return Board3::TABLES.winTable[bits] != 0;
+}
+
+// RESOLUCION COMPLETA EN TIEMPO DE COMPILACION
+// Un hijo siempre tiene un indice mayor que su padre (se suma 3^casilla o
+// 2*3^casilla), asi que recorriendo los indices de mayor a menor cada
+// posicion se resuelve cuando sus hijos ya estan resueltos.
+constexpr std::array<unsigned short, PerfectTable::SIZE> buildTable() {
+    std::array<unsigned short, PerfectTable::SIZE> table{};
+
+    for (int index = PerfectTable::SIZE - 1; index >= 0; index--) {
+        // Decodificar las casillas de cada jugador
+        int x = 0, o = 0;
+        for (int cell = 0, rest = index; cell < 9; cell++, rest /= 3) {
+            if (rest % 3 == 1) x |= 1 << cell;
+            else if (rest % 3 == 2) o |= 1 << cell;
+        }
+        int xCount = __builtin_popcount(x);
+        int oCount = __builtin_popcount(o);
+        bool xLine = hasLine(x);
+        bool oLine = hasLine(o);
+
+        // Descartar conteos imposibles y partidas que siguieron tras ganar
+        if (xCount != oCount && xCount != oCount + 1) continue;
+        if (xLine && (oLine || xCount != oCount + 1)) continue;
+        if (oLine && xCount != oCount) continue;
+
+        int toMove = (xCount == oCount) ? 0 : 1;
+
+        // Posiciones terminales: el ultimo en mover gano, o empate
+        if (xLine || oLine) {
+            table[index] = PerfectTable::LOSS << VALUE_SHIFT;
+            continue;
+        }
+        if ((x | o) == MOVES_MASK) {
+            table[index] = PerfectTable::DRAW << VALUE_SHIFT;
+            continue;
+        }
+
+        // Negamax de un nivel sobre los hijos ya resueltos
+        int best = PerfectTable::LOSS;
+        unsigned short moves = 0;
+        for (int cell = 0; cell < 9; cell++) {
+            if (((x | o) >> cell) & 1) continue;
+            int child = index + POW3[cell] * (toMove + 1);
+            int childValue = table[child] >> VALUE_SHIFT;
+            // Lo que es derrota para el rival es victoria para quien mueve
+            int value = (childValue == PerfectTable::LOSS) ? PerfectTable::WIN
+                      : (childValue == PerfectTable::WIN) ? PerfectTable::LOSS
+                      : PerfectTable::DRAW;
+            // Orden de preferencia: WIN (1) < DRAW (2) < LOSS (3)
+            if (value < best) {
+                best = value;
+                moves = 0;
+            }
+            if (value == best) moves |= 1u << cell;
+        }
+        table[index] = static_cast<unsigned short>((best << VALUE_SHIFT) | moves);
+    }
+
+    // Marcar las posiciones alcanzables desde el tablero vacio (recorrido
+    // en orden creciente: los padres siempre se visitan antes que los hijos)
+    table[0] |= REACHABLE_BIT;
+    for (int index = 0; index < PerfectTable::SIZE; index++) {
+        if (!(table[index] & REACHABLE_BIT)) continue;
+        int value = (table[index] >> VALUE_SHIFT) & 3;
+        if (value == PerfectTable::INVALID) continue;
+
+        int occupied = 0, xCount = 0, oCount = 0;
+        for (int cell = 0, rest = index; cell < 9; cell++, rest /= 3) {
+            if (rest % 3 != 0) occupied |= 1 << cell;
+            if (rest % 3 == 1) xCount++;
+            if (rest % 3 == 2) oCount++;
+        }
+        // Las terminales no tienen hijos; en las demas todo hueco es jugable
+        bool terminal = (table[index] & MOVES_MASK) == 0;
+        if (terminal) continue;
+        int toMove = (xCount == oCount) ? 0 : 1;
+        for (int cell = 0; cell < 9; cell++) {
+            if ((occupied >> cell) & 1) continue;
+            table[index + POW3[cell] * (toMove + 1)] |= REACHABLE_BIT;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<unsigned short, PerfectTable::SIZE> TABLE = buildTable();
+
+constexpr int countReachable() {
+    int count = 0;
+    for (unsigned short entry : TABLE) {
+        if (entry & REACHABLE_BIT) count++;
+    }
+    return count;
+}
+
+static_assert(countReachable() == PerfectTable::REACHABLE, "El triki tiene 5478 posiciones alcanzables");
+static_assert(((TABLE[0] >> VALUE_SHIFT) & 3) == PerfectTable::DRAW, "El triki perfecto termina en empate");
+
+}
+
+unsigned short PerfectTable::lookup(const Board<3, 3, 3>& board) {
+    unsigned x = static_cast<unsigned>(board.bits(0).words[0]);
+    unsigned o = static_cast<unsigned>(board.bits(1).words[0]);
+    return TABLE[TERNARY[x] + 2 * TERNARY[o]];
+}
+
+PerfectTable::Value PerfectTable::value(const Board<3, 3, 3>& board) {
+    return static_cast<Value>((lookup(board) >> VALUE_SHIFT) & 3);
+}
+
+unsigned short PerfectTable::optimalMoves(const Board<3, 3, 3>& board) {
+    return lookup(board) & MOVES_MASK;
+}
+
+int PerfectTable::bestMove(const Board<3, 3, 3>& board) {
+    unsigned short moves = optimalMoves(board);
+    return moves ? __builtin_ctz(moves) : -1;
+}
+
+int PerfectTable::sideToMove(const Board<3, 3, 3>& board) {
+    return (board.bits(0).count() == board.bits(1).count()) ? 0 : 1;
+}
+
+char PerfectTable::perfectPlayWinner(const Board<3, 3, 3>& board) {
+    switch (value(board)) {
+        case WIN:  return playerSymbol(sideToMove(board));
+        case LOSS: return playerSymbol(sideToMove(board) ^ 1);
+        case DRAW: return ' ';
+        default:   return '?';  // Posicion imposible en una partida real
+    }
+}
+
+bool PerfectTable::isReachable(const Board<3, 3, 3>& board) {
+    return (lookup(board) & REACHABLE_BIT) != 0;
+}
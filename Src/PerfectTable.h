@@ -0,0 +1,32 @@
+#ifndef PERFECTTABLE_H
+#define PERFECTTABLE_H
+
+#include "Board.h"
+
+// TABLA DE JUEGO PERFECTO 3x3
+// Todas las posiciones del triki resueltas en tiempo de compilacion. El
+// indice es la codificacion en base 3 del tablero (hash perfecto: 3^9 =
+// 19683 entradas de 2 bytes, ~39 KB, cabe en cache L1/L2), asi que cada
+// consulta es un solo acceso a memoria.
+class PerfectTable {
+public:
+    // Valor de la posicion para el jugador al que le toca mover
+    enum Value { INVALID = 0, WIN = 1, DRAW = 2, LOSS = 3 };
+    
+    static const int SIZE = 19683;       // 3^9 posiciones
+    static const int REACHABLE = 5478;   // Posiciones alcanzables desde el tablero vacio
+    
+    // Entrada empaquetada: bits 0-8 jugadas optimas, 9-10 valor, 11 alcanzable
+    static unsigned short lookup(const Board<3, 3, 3>& board);
+    
+    static Value value(const Board<3, 3, 3>& board);
+    static unsigned short optimalMoves(const Board<3, 3, 3>& board);  // Mascara de casillas
+    static int bestMove(const Board<3, 3, 3>& board);  // -1 si la partida termino
+    static char perfectPlayWinner(const Board<3, 3, 3>& board);  // 'X', 'O' o ' ' (empate)
+    static bool isReachable(const Board<3, 3, 3>& board);
+    
+    // Jugador al que le toca mover segun el numero de fichas
+    static int sideToMove(const Board<3, 3, 3>& board);
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "Players.h"
+#include "Mcts.h"
+#include "PerfectTable.h"
+
+namespace {
+
+// Elige la casilla numero 'index' (0..n-1) entre las encendidas de 'mask'
+int nthSetBit(unsigned mask, int index) {
+    while (index-- > 0) mask &= mask - 1;
+    return __builtin_ctz(mask);
+}
+
+// JUGADOR ALEATORIO - una casilla libre uniforme
+class RandomPolicy : public MovePolicy {
+public:
+    int chooseMove(const Board<3, 3, 3>& board, int, std::uint64_t& rng) override {
+        unsigned empty = ~static_cast<unsigned>(board.occupied().words[0]) & 0x1FF;
+        int count = __builtin_popcount(empty);
+        return nthSetBit(empty, static_cast<int>(nextRandom(rng) % count));
+    }
+    
+    std::string getName() const override { return "random"; }
+};
+
+// JUGADOR PERFECTO - una jugada optima al azar segun la tabla precalculada
+class PerfectPolicy : public MovePolicy {
+public:
+    int chooseMove(const Board<3, 3, 3>& board, int, std::uint64_t& rng) override {
+        unsigned moves = PerfectTable::optimalMoves(board);
+        int count = __builtin_popcount(moves);
+        return nthSetBit(moves, static_cast<int>(nextRandom(rng) % count));
+    }
+    
+    std::string getName() const override { return "solver"; }
+};
+
+// JUGADOR MONTE CARLO - presupuesto fijo de simulaciones, un hilo
+class MctsPolicy : public MovePolicy {
+private:
+    MctsEngine<3, 3, 3> engine;
+    long long playouts;
+    
+    static MctsEngine<3, 3, 3>::Config makeConfig(long long playouts) {
+        MctsEngine<3, 3, 3>::Config config;
+        config.threads = 1;
+        config.maxPlayouts = playouts;
+        config.maxMillis = 0;
+        config.nodesPerThread = static_cast<std::size_t>(playouts) * 9 + 64;
+        return config;
+    }
+    
+public:
+    explicit MctsPolicy(long long playouts) : engine(makeConfig(playouts)), playouts(playouts) {}
+    
+    int chooseMove(const Board<3, 3, 3>& board, int player, std::uint64_t& rng) override {
+        engine.setSeed(nextRandom(rng));
+        return engine.search(board, player).move;
+    }
+    
+    std::string getName() const override { return "mcts:" + std::to_string(playouts); }
+};
+
+}
+
+std::unique_ptr<MovePolicy> createPolicy(const std::string& spec) {
+    if (spec == "random") {
+        return std::unique_ptr<MovePolicy>(new RandomPolicy());
+    }
+    if (spec == "solver") {
+        return std::unique_ptr<MovePolicy>(new PerfectPolicy());
+    }
+    if (spec.compare(0, 4, "mcts") == 0) {
+        long long playouts = 1000;
+        if (spec.size() > 5 && spec[4] == ':') {
+            try {
+                playouts = std::stoll(spec.substr(5));
+            } catch (const std::exception&) {
+                return nullptr;
+            }
+        } else if (spec.size() != 4) {
+            return nullptr;
+        }
+        if (playouts <= 0) return nullptr;
+        return std::unique_ptr<MovePolicy>(new MctsPolicy(playouts));
+    }
+    return nullptr;
+}
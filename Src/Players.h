@@ -0,0 +1,26 @@
+#ifndef PLAYERS_H
+#define PLAYERS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Board.h"
+#include "Random.h"
+
+// JUGADORES AUTOMATICOS PARA PARTIDAS SIN CONSOLA (triki 3x3)
+// Cada hilo crea sus propias instancias con createPolicy(), asi que una
+// politica no necesita ser segura entre hilos.
+class MovePolicy {
+public:
+    virtual ~MovePolicy() = default;
+    
+    // Devuelve la casilla a jugar; 'rng' es el generador del hilo
+    virtual int chooseMove(const Board<3, 3, 3>& board, int player, std::uint64_t& rng) = 0;
+    virtual std::string getName() const = 0;
+};
+
+// Especificaciones validas: "random", "solver", "mcts" o "mcts:<simulaciones>".
+// Devuelve nullptr si la especificacion no es valida.
+std::unique_ptr<MovePolicy> createPolicy(const std::string& spec);
+
+#endif
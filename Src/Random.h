@@ -0,0 +1,26 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// Generadores pequeños para las busquedas y herramientas por lotes: cada
+// hilo guarda su propio estado de 64 bits, sin sincronizacion.
+
+// xorshift64* - el estado nunca debe ser 0
+inline std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+// Semilla independiente por hilo o por partida (splitmix64)
+inline std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z ? z : 1;
+}
+
+#endif
@@ -0,0 +1,275 @@
+#include "SaveBlobs.h"
+#include "Logger.h"
+#include "SaveFormat.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char BLOB_MAGIC[4] = {'T', 'R', 'K', 'B'};
+const char REFERENCE_MAGIC[4] = {'T', 'R', 'K', 'R'};
+const std::size_t BLOB_HEADER_BYTES = 8;  // Magia + numero de referencias
+const std::uint32_t MAX_PROBES = 64;
+
+// flock del directorio de posiciones mientras dura un cambio
+class FileLock {
+public:
+    explicit FileLock(int fd) : fd(fd) { if (fd >= 0) flock(fd, LOCK_EX); }
+    ~FileLock() { if (fd >= 0) flock(fd, LOCK_UN); }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+private:
+    int fd;
+};
+
+// FNV-1a de 32 bits. No sirve el CRC-32: una partida v2 termina con su
+// propio CRC y el CRC del conjunto da siempre el mismo valor
+std::uint32_t hashContents(const std::vector<char>& data) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : data) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+bool writeWhole(int fd, const char* data, std::size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t written = pwrite(fd, data, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += written;
+    }
+    return true;
+}
+
+}
+
+std::shared_ptr<SaveBlobs> SaveBlobs::open(const std::string& directory) {
+    static std::mutex registryLock;
+    static std::map<std::string, std::shared_ptr<SaveBlobs>> registry;
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    auto& blobs = registry[directory];
+    if (!blobs) {
+        blobs.reset(new SaveBlobs(directory));
+    }
+    return blobs;
+}
+
+SaveBlobs::SaveBlobs(const std::string& saveDirectory) : directory(saveDirectory + "/posiciones") {
+    std::error_code error;
+    present = std::filesystem::is_directory(directory, error);
+}
+
+SaveBlobs::~SaveBlobs() {
+    if (lockFd >= 0) ::close(lockFd);
+}
+
+void SaveBlobs::setEnabled(bool value) {
+    std::lock_guard<std::mutex> guard(lock);
+    enabled = value;
+}
+
+bool SaveBlobs::isEnabled() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return enabled;
+}
+
+bool SaveBlobs::hasPositions() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return present;
+}
+
+// Con el candado tomado
+bool SaveBlobs::ensureDirectory() {
+    if (lockFd >= 0) {
+        return true;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    lockFd = ::open((directory + "/.lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFd < 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo abrir " << directory << "/.lock: " << std::strerror(errno));
+        return false;
+    }
+    present = true;
+    return true;
+}
+
+std::string SaveBlobs::pathFor(std::uint64_t key, std::uint32_t variant) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "/%016llx-%08x.pos", static_cast<unsigned long long>(key), variant);
+    return directory + name;
+}
+
+bool SaveBlobs::readFile(const std::string& path, std::vector<char>& contents) const {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    bool ok = fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= BLOB_HEADER_BYTES;
+    if (ok) {
+        contents.resize(static_cast<std::size_t>(info.st_size));
+        ok = pread(fd, contents.data(), contents.size(), 0) == static_cast<ssize_t>(contents.size()) &&
+             std::memcmp(contents.data(), BLOB_MAGIC, sizeof(BLOB_MAGIC)) == 0;
+    }
+    ::close(fd);
+    return ok;
+}
+
+// Solo la cuenta de la cabecera; el contenido no se vuelve a escribir
+bool SaveBlobs::setReferences(const std::string& path, std::uint32_t references) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    unsigned char count[4];
+    writeLittleEndian(count, references, 4);
+    bool ok = writeWhole(fd, reinterpret_cast<const char*>(count), sizeof(count), sizeof(BLOB_MAGIC));
+    ::close(fd);
+    return ok;
+}
+
+bool SaveBlobs::acquire(std::uint64_t key, const std::vector<char>& data, std::uint32_t& variant) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!ensureDirectory()) {
+        return false;
+    }
+    FileLock fileLock(lockFd);
+
+    // La variante sale de un hash del contenido: la misma partida siempre cae
+    // en el mismo archivo aunque se hayan borrado otras con la misma clave.
+    // Solo si dos contenidos distintos coinciden en clave y hash se prueba
+    // la siguiente.
+    const std::uint32_t first = hashContents(data);
+    std::vector<char> contents;
+    for (std::uint32_t probe = 0; probe < MAX_PROBES; probe++) {
+        variant = first + probe;
+        std::string path = pathFor(key, variant);
+        if (readFile(path, contents)) {
+            // Misma clave: sirve solo si el contenido es identico
+            if (contents.size() == BLOB_HEADER_BYTES + data.size() &&
+                std::memcmp(contents.data() + BLOB_HEADER_BYTES, data.data(), data.size()) == 0) {
+                std::uint32_t references = readLittleEndian(
+                    reinterpret_cast<const unsigned char*>(contents.data()) + sizeof(BLOB_MAGIC), 4);
+                return setReferences(path, references + 1);
+            }
+            continue;
+        }
+        if (access(path.c_str(), F_OK) == 0) {
+            continue;  // Existe pero no se pudo leer: no se pisa
+        }
+
+        // Posicion nueva: temporal completo y renombrado atomico
+        contents.assign(BLOB_HEADER_BYTES + data.size(), 0);
+        std::memcpy(contents.data(), BLOB_MAGIC, sizeof(BLOB_MAGIC));
+        writeLittleEndian(reinterpret_cast<unsigned char*>(contents.data()) + sizeof(BLOB_MAGIC), 1, 4);
+        std::memcpy(contents.data() + BLOB_HEADER_BYTES, data.data(), data.size());
+
+        std::string tempPath = path + ".tmp";
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = writeWhole(fd, contents.data(), contents.size(), 0);
+        ::close(fd);
+        if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+            unlink(tempPath.c_str());
+            return false;
+        }
+        TRIKI_DEBUG(LOG_IO, "Posicion nueva: " << path);
+        return true;
+    }
+    TRIKI_ERROR(LOG_IO, "Demasiadas variantes para la clave " << std::hex << key << std::dec);
+    return false;
+}
+
+bool SaveBlobs::release(std::uint64_t key, std::uint32_t variant) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!ensureDirectory()) {
+        return false;
+    }
+    FileLock fileLock(lockFd);
+
+    std::string path = pathFor(key, variant);
+    std::vector<char> contents;
+    if (!readFile(path, contents)) {
+        return false;
+    }
+    std::uint32_t references = readLittleEndian(
+        reinterpret_cast<const unsigned char*>(contents.data()) + sizeof(BLOB_MAGIC), 4);
+    if (references <= 1) {
+        TRIKI_DEBUG(LOG_IO, "Posicion sin referencias, eliminada: " << path);
+        return unlink(path.c_str()) == 0;
+    }
+    return setReferences(path, references - 1);
+}
+
+bool SaveBlobs::read(std::uint64_t key, std::uint32_t variant, std::vector<char>& data) const {
+    std::vector<char> contents;
+    if (!readFile(pathFor(key, variant), contents)) {
+        return false;
+    }
+    data.assign(contents.begin() + BLOB_HEADER_BYTES, contents.end());
+    return true;
+}
+
+SaveBlobs::Summary SaveBlobs::summarize() const {
+    Summary summary;
+    std::error_code error;
+    std::filesystem::directory_iterator it(directory, error), end;
+    for (; !error && it != end; it.increment(error)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() <= 4 || name.compare(name.size() - 4, 4, ".pos") != 0) {
+            continue;
+        }
+        std::vector<char> contents;
+        if (readFile(it->path().string(), contents)) {
+            summary.positions++;
+            summary.references += readLittleEndian(
+                reinterpret_cast<const unsigned char*>(contents.data()) + sizeof(BLOB_MAGIC), 4);
+            summary.bytes += static_cast<long long>(contents.size());
+        }
+    }
+    return summary;
+}
+
+// REFERENCIA (little endian)
+//   0  4 bytes  "TRKR"
+//   4  8 bytes  clave de la posicion
+//  12  4 bytes  variante
+//  16  4 bytes  CRC-32 de los bytes anteriores
+std::vector<char> SaveBlobs::makeReference(std::uint64_t key, std::uint32_t variant) {
+    std::vector<char> reference(REFERENCE_BYTES);
+    unsigned char* out = reinterpret_cast<unsigned char*>(reference.data());
+    std::memcpy(out, REFERENCE_MAGIC, sizeof(REFERENCE_MAGIC));
+    writeLittleEndian(out + 4, static_cast<std::uint32_t>(key), 4);
+    writeLittleEndian(out + 8, static_cast<std::uint32_t>(key >> 32), 4);
+    writeLittleEndian(out + 12, variant, 4);
+    writeLittleEndian(out + 16, crc32(out, 16), 4);
+    return reference;
+}
+
+bool SaveBlobs::parseReference(const void* data, std::size_t size, std::uint64_t& key, std::uint32_t& variant) {
+    const unsigned char* in = static_cast<const unsigned char*>(data);
+    if (size != static_cast<std::size_t>(REFERENCE_BYTES) ||
+        std::memcmp(in, REFERENCE_MAGIC, sizeof(REFERENCE_MAGIC)) != 0 ||
+        crc32(in, 16) != readLittleEndian(in + 16, 4)) {
+        return false;
+    }
+    key = readLittleEndian(in + 4, 4) | (static_cast<std::uint64_t>(readLittleEndian(in + 8, 4)) << 32);
+    variant = readLittleEndian(in + 12, 4);
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef SAVEBLOBS_H
+#define SAVEBLOBS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// POSICIONES COMPARTIDAS (GUARDADO POR CONTENIDO)
+// Con el modo activado, cada partida guardada es solo una referencia de
+// REFERENCE_BYTES bytes a un archivo de <directorio>/posiciones/ cuyo nombre
+// es la clave de la posicion (hash de Zobrist de Game) y una variante:
+//   <clave en hex>-<variante>.pos   "TRKB", referencias (4 bytes) y la
+//                                   partida completa en formato v2
+// Partidas iguales comparten un solo archivo. La variante (un hash del
+// contenido) separa partidas que llegan a la misma posicion con otro orden
+// de jugadas (o, muy rara vez, posiciones distintas con la misma clave):
+// nunca se pierde contenido.
+//
+// Cada archivo lleva la cuenta de las referencias que apuntan a el; se borra
+// cuando la ultima desaparece. Al guardar se suma la referencia antes de
+// escribir el nombre y al borrar se resta despues, asi que un corte a mitad
+// de camino a lo sumo deja un archivo de mas, nunca una referencia rota.
+// Los cambios se serializan con un candado del proceso y un flock sobre
+// posiciones/.lock entre procesos.
+class SaveBlobs {
+public:
+    static const int REFERENCE_BYTES = 20;
+
+    struct Summary {
+        long long positions = 0;   // Archivos en posiciones/
+        long long references = 0;  // Partidas que apuntan a ellos
+        long long bytes = 0;
+    };
+
+    // Uno por directorio y por proceso: el modo vale para todos los
+    // FileManager (y el ejecutor de E/S) de ese directorio
+    static std::shared_ptr<SaveBlobs> open(const std::string& directory);
+
+    ~SaveBlobs();
+    SaveBlobs(const SaveBlobs&) = delete;
+    SaveBlobs& operator=(const SaveBlobs&) = delete;
+
+    void setEnabled(bool enabled);  // Solo afecta a los guardados nuevos
+    bool isEnabled() const;
+    bool hasPositions() const;  // false si nunca se guardo ninguna: no hay referencias que revisar
+
+    // Busca la posicion con exactamente ese contenido (o la crea) y le suma
+    // una referencia. Devuelve en 'variant' la variante usada.
+    bool acquire(std::uint64_t key, const std::vector<char>& data, std::uint32_t& variant);
+    // Resta una referencia; al llegar a cero se borra el archivo
+    bool release(std::uint64_t key, std::uint32_t variant);
+    bool read(std::uint64_t key, std::uint32_t variant, std::vector<char>& data) const;
+
+    Summary summarize() const;  // Recorre posiciones/
+
+    // Referencia "TRKR" + clave + variante + CRC-32
+    static std::vector<char> makeReference(std::uint64_t key, std::uint32_t variant);
+    static bool parseReference(const void* data, std::size_t size, std::uint64_t& key, std::uint32_t& variant);
+
+private:
+    std::string directory;  // <directorio>/posiciones
+    mutable std::mutex lock;
+    bool enabled = false;
+    bool present = false;   // Ya existe el directorio de posiciones
+    int lockFd = -1;
+
+    explicit SaveBlobs(const std::string& saveDirectory);
+    bool ensureDirectory();
+    std::string pathFor(std::uint64_t key, std::uint32_t variant) const;
+    bool readFile(const std::string& path, std::vector<char>& contents) const;  // Cabecera incluida
+    bool setReferences(const std::string& path, std::uint32_t references);
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "SaveExecutor.h"
+#include "FileManager.h"
+#include "Logger.h"
+#include <algorithm>
+#include <functional>
+
+SaveExecutor::SaveExecutor(const Config& config) : config(config) {
+    int threads = std::max(1, config.threads);
+    for (int i = 0; i < threads; i++) {
+        queues.emplace_back(new BoundedQueue<Request>(config.queueCapacity));
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(&SaveExecutor::workerLoop, this, std::ref(*queues[i]));
+    }
+    TRIKI_DEBUG(LOG_IO, "Ejecutor de E/S: " << threads << " hilos, tandas de hasta " << config.maxBatch);
+}
+
+SaveExecutor::~SaveExecutor() {
+    for (auto& queue : queues) {
+        queue->close();  // Cada hilo vacia su cola antes de salir
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+SaveExecutor& SaveExecutor::shared() {
+    // Creado antes que el ejecutor, el almacen por defecto se destruye despues
+    // y los pedidos que queden al salir todavia lo encuentran
+    FileManager::shared();
+    static SaveExecutor instance{Config()};
+    return instance;
+}
+
+void SaveExecutor::write(SaveStorage& storage, const std::string& filename, std::vector<char> data,
+                         std::uint64_t positionKey, const WriteCallback& done) {
+    Request request;
+    request.isWrite = true;
+    request.storage = &storage;
+    request.filename = filename;
+    request.data = std::move(data);
+    request.positionKey = positionKey;
+    request.writeDone = done;
+    submit(std::move(request));
+}
+
+void SaveExecutor::read(const SaveStorage& storage, const std::string& filename, const ReadCallback& done) {
+    Request request;
+    request.source = &storage;
+    request.filename = filename;
+    request.readDone = done;
+    submit(std::move(request));
+}
+
+void SaveExecutor::submit(Request request) {
+    request.submitted = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> guard(statsLock);
+        stats.submitted++;
+    }
+    // Mismo archivo, mismo hilo: sus pedidos se atienden en orden
+    std::size_t index = std::hash<std::string>()(request.filename) % queues.size();
+    queues[index]->push(std::move(request));
+}
+
+void SaveExecutor::waitIdle() {
+    std::unique_lock<std::mutex> guard(statsLock);
+    idle.wait(guard, [this]() { return stats.completed >= stats.submitted; });
+}
+
+SaveExecutor::Stats SaveExecutor::getStats() const {
+    std::lock_guard<std::mutex> guard(statsLock);
+    Stats current = stats;
+    for (const auto& queue : queues) {
+        current.queueDepth += queue->size();
+        current.maxQueueDepth = std::max(current.maxQueueDepth, queue->getMaxDepth());
+    }
+    current.averageLatencyMicros = stats.completed > 0 ? totalLatencyMicros / stats.completed : 0.0;
+    return current;
+}
+
+void SaveExecutor::workerLoop(BoundedQueue<Request>& queue) {
+    std::vector<Request> batch;
+    std::vector<std::string> names;
+    std::vector<std::vector<char>> contents;
+    std::vector<std::uint64_t> keys;
+    std::vector<bool> results;
+
+    while (true) {
+        batch.clear();
+        if (!queue.popBatch(batch, config.maxBatch)) {
+            break;  // Cola cerrada y vacia
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(statsLock);
+            stats.batches++;
+            stats.maxBatchSize = std::max(stats.maxBatchSize, batch.size());
+        }
+
+        // En el orden de llegada: las escrituras seguidas al mismo almacen van
+        // en una sola pasada y cada lectura ve las escrituras anteriores
+        std::size_t start = 0;
+        while (start < batch.size()) {
+            if (!batch[start].isWrite) {
+                Request& request = batch[start++];
+                std::vector<char> data;
+                bool ok = request.source->readSaveFile(request.filename, data);
+                if (request.readDone) request.readDone(ok, data);
+                finish(request, ok);
+                continue;
+            }
+
+            SaveStorage& storage = *batch[start].storage;
+            std::size_t end = start;
+            names.clear();
+            contents.clear();
+            keys.clear();
+            while (end < batch.size() && batch[end].isWrite && batch[end].storage == &storage) {
+                names.push_back(batch[end].filename);
+                contents.push_back(std::move(batch[end].data));
+                keys.push_back(batch[end].positionKey);
+                end++;
+            }
+            storage.writeSaveFiles(names, contents, keys, results);
+
+            for (std::size_t i = start; i < end; i++) {
+                Request& request = batch[i];
+                bool ok = results[i - start];
+                if (!ok) {
+                    TRIKI_ERROR(LOG_IO, "No se pudo guardar (asincrono): " << request.filename);
+                }
+                if (request.writeDone) request.writeDone(ok);
+                finish(request, ok);
+            }
+            start = end;
+        }
+    }
+}
+
+void SaveExecutor::finish(const Request& request, bool ok) {
+    double micros = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - request.submitted).count();
+    std::lock_guard<std::mutex> guard(statsLock);
+    stats.completed++;
+    if (!ok) stats.failed++;
+    totalLatencyMicros += micros;
+    stats.maxLatencyMicros = std::max(stats.maxLatencyMicros, micros);
+    if (stats.completed >= stats.submitted) {
+        idle.notify_all();
+    }
+}
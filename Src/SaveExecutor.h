@@ -0,0 +1,96 @@
+#ifndef SAVEEXECUTOR_H
+#define SAVEEXECUTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BoundedQueue.h"
+#include "SaveStorage.h"
+
+// EJECUTOR DE E/S PARA GUARDAR Y CARGAR PARTIDAS
+// Hilos dedicados que atienden pedidos de escritura y lectura para que quien
+// los hace (el ciclo del servidor, la consola) no espere al disco. Cada hilo
+// saca de su cola todos los pedidos que haya (hasta 'maxBatch') y escribe las
+// escrituras seguidas al mismo almacen en una sola llamada a
+// SaveStorage::writeSaveFiles(). Cada pedido dice a que almacen va; el
+// almacen debe seguir vivo hasta su aviso. Las respuestas se entregan con un
+// callback desde el hilo de E/S.
+//
+// ORDEN: cada nombre de archivo va siempre a la cola del mismo hilo (por su
+// hash), y ese hilo atiende sus pedidos en el orden en que llegaron. Dos
+// guardados del mismo archivo quedan en ese orden y una carga ve el ultimo
+// guardado pedido antes que ella. Entre archivos distintos no hay orden.
+class SaveExecutor {
+public:
+    struct Config {
+        int threads = 2;
+        std::size_t queueCapacity = 4096;  // Por hilo; con la cola llena, quien pide espera
+        std::size_t maxBatch = 64;
+    };
+
+    struct Stats {
+        long long submitted = 0;
+        long long completed = 0;
+        long long failed = 0;
+        long long batches = 0;
+        std::size_t queueDepth = 0;       // Pedidos esperando ahora
+        std::size_t maxQueueDepth = 0;
+        std::size_t maxBatchSize = 0;
+        double averageLatencyMicros = 0;  // Desde el pedido hasta el callback
+        double maxLatencyMicros = 0;
+    };
+
+    using WriteCallback = std::function<void(bool ok)>;
+    using ReadCallback = std::function<void(bool ok, std::vector<char>& data)>;
+
+    explicit SaveExecutor(const Config& config);
+    ~SaveExecutor();  // Termina todos los pedidos pendientes
+    SaveExecutor(const SaveExecutor&) = delete;
+    SaveExecutor& operator=(const SaveExecutor&) = delete;
+
+    // Ejecutor del proceso, creado con la configuracion por defecto al primer uso
+    static SaveExecutor& shared();
+
+    // positionKey: clave de la posicion para el guardado por contenido
+    void write(SaveStorage& storage, const std::string& filename, std::vector<char> data,
+               std::uint64_t positionKey, const WriteCallback& done);
+    void read(const SaveStorage& storage, const std::string& filename, const ReadCallback& done);
+    void waitIdle();  // Bloquea hasta que no quede ningun pedido en curso
+
+    Stats getStats() const;
+
+private:
+    struct Request {
+        bool isWrite = false;
+        SaveStorage* storage = nullptr;      // Escrituras
+        const SaveStorage* source = nullptr;  // Lecturas
+        std::string filename;
+        std::vector<char> data;
+        std::uint64_t positionKey = 0;
+        WriteCallback writeDone;
+        ReadCallback readDone;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    Config config;
+    std::vector<std::unique_ptr<BoundedQueue<Request>>> queues;  // Una por hilo
+    std::vector<std::thread> workers;
+
+    mutable std::mutex statsLock;
+    std::condition_variable idle;
+    Stats stats;
+    double totalLatencyMicros = 0;
+
+    void submit(Request request);
+    void workerLoop(BoundedQueue<Request>& queue);
+    void finish(const Request& request, bool ok);  // Cuenta la latencia de un pedido
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SAVEFORMAT_H
+#define SAVEFORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// FORMATO DE PARTIDA .triki VERSION 2 (enteros en little endian)
+//   0  4 bytes  "TRK2"
+//   4  1 byte   version (2)
+//   5  3 bytes  filas, columnas, k
+//   8  1 byte   jugador actual ('X' u 'O')
+//   9  1 byte   1 si el juego termino
+//  10  1 byte   ganador (' ', 'X' u 'O')
+//  11  1 byte   reservado (0)
+//  12  2 bytes  numero de jugadas n
+//  14  n bytes  jugadas en orden (casilla fila*columnas + columna)
+//  14+n 4 bytes CRC-32 de todos los bytes anteriores
+//
+// Version 1 (sin cabecera): una casilla por byte (' ', 'X', 'O'), luego
+// jugador actual, juego terminado y ganador. Se sigue pudiendo cargar.
+const char SAVE_MAGIC[4] = {'T', 'R', 'K', '2'};
+const int SAVE_VERSION = 2;
+const int SAVE_HEADER_BYTES = 14;
+const int SAVE_CHECKSUM_BYTES = 4;
+
+// Tabla del CRC-32 (polinomio reflejado 0xEDB88320) generada en compilacion
+constexpr std::array<std::uint32_t, 256> makeCrc32Table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; i++) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<std::uint32_t, 256> CRC32_TABLE = makeCrc32Table();
+
+// 'previous' permite encadenar varios bloques: crc32(b, n2, crc32(a, n1))
+inline std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t previous = 0) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint32_t crc = ~previous;
+    for (std::size_t i = 0; i < size; i++) {
+        crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline void writeLittleEndian(unsigned char* out, std::uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline std::uint32_t readLittleEndian(const unsigned char* in, int bytes) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+static_assert(CRC32_TABLE[1] == 0x77073096u, "Tabla CRC-32 incorrecta");
+
+#endif
@@ -0,0 +1,143 @@
+#include "SaveIndex.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool isSaveName(const std::string& name) {
+    return name.length() > 6 && name.compare(name.length() - 6, 6, ".triki") == 0;
+}
+
+}
+
+std::shared_ptr<SaveIndex> SaveIndex::open(const std::string& directory) {
+    static std::mutex registryLock;
+    static std::map<std::string, std::shared_ptr<SaveIndex>> registry;
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    auto& index = registry[directory];
+    if (!index) {
+        index.reset(new SaveIndex(directory));
+    }
+    return index;
+}
+
+SaveIndex::SaveIndex(const std::string& directory) : directory(directory) {
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0 &&
+        inotify_add_watch(inotifyFd, directory.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF) < 0) {
+        ::close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (inotifyFd < 0) {
+        TRIKI_WARNING(LOG_IO, "inotify no disponible para " << directory << " (" << std::strerror(errno)
+                      << "); se recorrera el directorio en cada consulta");
+    }
+}
+
+SaveIndex::~SaveIndex() {
+    if (inotifyFd >= 0) ::close(inotifyFd);
+}
+
+bool SaveIndex::isWatching() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return inotifyFd >= 0;
+}
+
+std::vector<SaveStore::Entry> SaveIndex::list() {
+    std::lock_guard<std::mutex> guard(lock);
+    refresh();
+    std::vector<SaveStore::Entry> entries;
+    entries.reserve(files.size());
+    for (const auto& file : files) {
+        entries.push_back(file.second);
+    }
+    return entries;
+}
+
+bool SaveIndex::contains(const std::string& name) {
+    std::lock_guard<std::mutex> guard(lock);
+    refresh();
+    return files.count(name) > 0;
+}
+
+void SaveIndex::refreshFile(const std::string& name) {
+    std::lock_guard<std::mutex> guard(lock);
+    statFile(name);
+}
+
+void SaveIndex::forget(const std::string& name) {
+    std::lock_guard<std::mutex> guard(lock);
+    files.erase(name);
+}
+
+void SaveIndex::refresh() {
+    if (inotifyFd < 0) {
+        stale = true;
+    }
+    // Se leen los eventos aunque haya que recorrer todo: asi no quedan viejos en la cola
+    alignas(inotify_event) char buffer[4096];
+    while (inotifyFd >= 0) {
+        ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;  // EAGAIN: no hay mas eventos
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                stale = true;  // Se perdieron eventos
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                // El directorio desaparecio: sin vigilancia de aqui en adelante
+                ::close(inotifyFd);
+                inotifyFd = -1;
+                stale = true;
+                break;
+            }
+            if (event->len == 0 || stale) continue;
+            std::string name(event->name);
+            if (!isSaveName(name)) continue;
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                files.erase(name);
+            } else {
+                statFile(name);
+            }
+        }
+    }
+    if (stale) {
+        scan();
+    }
+}
+
+void SaveIndex::scan() {
+    files.clear();
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (isSaveName(name)) {
+            statFile(name);
+        }
+    }
+    stale = false;
+    TRIKI_DEBUG(LOG_IO, "Indice de " << directory << ": " << files.size() << " partidas");
+}
+
+void SaveIndex::statFile(const std::string& name) {
+    struct stat info;
+    std::string fullPath = directory + "/" + name;
+    if (::stat(fullPath.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        files.erase(name);
+        return;
+    }
+    std::int64_t modified = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    files[name] = SaveStore::Entry{name, static_cast<std::size_t>(info.st_size), modified};
+}
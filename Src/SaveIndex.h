@@ -0,0 +1,49 @@
+#ifndef SAVEINDEX_H
+#define SAVEINDEX_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SaveStore.h"
+
+// INDICE EN MEMORIA DE UN DIRECTORIO DE PARTIDAS (.triki sueltos)
+// Se usa cuando no hay almacen empaquetado (un archivo por partida). El
+// directorio se recorre una sola vez; despues inotify avisa de cada archivo
+// creado, reemplazado o borrado y solo ese archivo se vuelve a consultar.
+// Los eventos se leen sin bloquear al empezar cada consulta, asi que no hace
+// falta un hilo. Si inotify no esta disponible (o se desborda su cola) se
+// vuelve a recorrer el directorio completo.
+class SaveIndex {
+public:
+    // Un indice por directorio y por proceso, abierto hasta el final
+    static std::shared_ptr<SaveIndex> open(const std::string& directory);
+
+    ~SaveIndex();
+    SaveIndex(const SaveIndex&) = delete;
+    SaveIndex& operator=(const SaveIndex&) = delete;
+
+    std::vector<SaveStore::Entry> list();  // Ordenadas por nombre
+    bool contains(const std::string& name);
+
+    // Cambios hechos por este proceso: quedan visibles sin esperar el evento
+    void refreshFile(const std::string& name);
+    void forget(const std::string& name);
+
+    bool isWatching() const;
+
+private:
+    std::string directory;
+    int inotifyFd = -1;
+    bool stale = true;  // Hay que recorrer el directorio completo
+    std::map<std::string, SaveStore::Entry> files;
+    mutable std::mutex lock;
+
+    explicit SaveIndex(const std::string& directory);
+    void refresh();  // Aplica los eventos pendientes (con el candado tomado)
+    void scan();
+    void statFile(const std::string& name);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SAVESTORAGE_H
+#define SAVESTORAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ALMACENAMIENTO DE PARTIDAS (INTERFAZ)
+// Lo unico que Game necesita para guardar y cargar: bytes con nombre.
+// FileManager es la implementacion de disco; un servidor o una herramienta
+// por lotes puede pasar la suya (memoria, red...) a saveGame/loadGame y a
+// las versiones asincronas; el ejecutor de E/S la llama desde sus hilos, asi
+// que debe admitir llamadas concurrentes.
+class SaveStorage {
+public:
+    virtual ~SaveStorage() = default;
+
+    // 'positionKey' es la clave de la posicion (Game::getHash()); se puede ignorar
+    virtual bool writeSaveFile(const std::string& filename, const std::vector<char>& data,
+                               std::uint64_t positionKey) = 0;
+    virtual bool readSaveFile(const std::string& filename, std::vector<char>& data) const = 0;
+
+    // Tanda de partidas (ejecutor de E/S). Por defecto una por una;
+    // positionKeys puede ir vacio
+    virtual void writeSaveFiles(const std::vector<std::string>& filenames,
+                                const std::vector<std::vector<char>>& contents,
+                                const std::vector<std::uint64_t>& positionKeys, std::vector<bool>& results) {
+        results.assign(filenames.size(), false);
+        for (std::size_t i = 0; i < filenames.size(); i++) {
+            results[i] = writeSaveFile(filenames[i], contents[i], positionKeys.empty() ? 0 : positionKeys[i]);
+        }
+    }
+};
+
+#endif
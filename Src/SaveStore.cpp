@@ -0,0 +1,715 @@
+#include "SaveStore.h"
+#include "Logger.h"
+#include "SaveFormat.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char DATA_MAGIC[4] = {'T', 'K', 'S', 'T'};
+const char INDEX_MAGIC[4] = {'T', 'K', 'I', 'X'};
+const std::uint32_t STORE_VERSION = 1;
+const std::size_t DATA_HEADER_BYTES = 4096;  // Las casillas empiezan alineadas a pagina
+const std::uint32_t INITIAL_SLOTS = 256;
+const std::uint32_t INITIAL_INDEX_CAPACITY = 1024;  // Potencia de 2
+
+enum SlotState : std::uint32_t { SLOT_FREE = 0, SLOT_LIVE = 1 };
+
+// Entrada del indice: 0 vacia, TOMBSTONE borrada, otro valor casilla + 1
+const std::uint32_t TOMBSTONE = 0xFFFFFFFFu;
+
+// FNV-1a de 32 bits
+std::uint32_t hashName(const char* name, std::size_t length) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void* mapFile(int fd, std::size_t bytes) {
+    void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return map == MAP_FAILED ? nullptr : map;
+}
+
+std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// flock que reintenta si lo interrumpe una senal
+bool lockFile(int fd, int operation) {
+    while (flock(fd, operation) != 0) {
+        if (errno != EINTR) return false;
+    }
+    return true;
+}
+
+// Partidas sueltas (.triki) del directorio
+std::vector<std::filesystem::path> findLooseFiles(const std::string& directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file(error) && name.size() > 6 && name.compare(name.size() - 6, 6, ".triki") == 0) {
+            files.push_back(entry.path());
+        }
+    }
+    return files;
+}
+
+}
+
+struct SaveStore::DataHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t slotBytes;
+    std::uint32_t slotCount;
+    std::uint32_t freeHead;      // Casilla + 1 de la primera libre, 0 si no hay
+    std::uint32_t liveCount;
+    std::uint32_t dirty;         // 1 mientras algun proceso lo tiene abierto
+    std::uint32_t busy;          // 1 mientras un proceso lo esta cambiando
+    std::uint64_t nextSequence;
+};
+
+struct SaveStore::Slot {
+    std::uint32_t state;
+    std::uint32_t nextFree;      // Siguiente libre (casilla + 1) si esta libre
+    std::uint64_t sequence;      // Orden de escritura, desempata nombres repetidos
+    std::int64_t modified;
+    std::uint16_t nameLength;
+    std::uint16_t dataLength;
+    std::uint32_t crc;           // CRC-32 de nombre + contenido
+    char name[MAX_NAME];
+    char data[MAX_DATA];
+};
+
+struct SaveStore::IndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t capacity;
+    std::uint32_t used;          // Vivas + borradas: decide cuando crecer
+    std::uint32_t live;
+    std::uint32_t reserved;
+    std::uint64_t stamp;         // nextSequence del .dat al cerrar limpio
+};
+
+struct SaveStore::IndexEntry {
+    std::uint32_t hash;
+    std::uint32_t slot;
+};
+
+// Candado del proceso y flock de partidas.dat, con las proyecciones al dia.
+// Si el ultimo que cambio el almacen murio a mitad (marca 'busy') se repara
+// antes de seguir, aunque la operacion sea de lectura.
+class SaveStore::Access {
+public:
+    Access(const SaveStore& owner, bool writing)
+        : store(const_cast<SaveStore&>(owner)), guard(owner.lock), writing(writing) {
+        locked = lockFile(store.dataFd, writing ? LOCK_EX : LOCK_SH);
+        valid = locked && store.refreshMaps();
+        if (valid && store.dataHeader()->busy) {
+            // Pasar a exclusivo no es atomico: otro proceso pudo repararlo entre medio
+            TRIKI_WARNING(LOG_IO, "Un proceso se corto cambiando el almacen de " << store.directory
+                          << ": reconstruyendo indice y lista libre");
+            valid = lockFile(store.dataFd, LOCK_EX) && store.refreshMaps() &&
+                    (!store.dataHeader()->busy || store.repair());
+        }
+        if (valid && writing) {
+            store.dataHeader()->busy = 1;
+        }
+    }
+
+    ~Access() {
+        if (valid && writing) {
+            store.dataHeader()->busy = 0;
+        }
+        if (locked) {
+            flock(store.dataFd, LOCK_UN);
+        }
+    }
+
+    Access(const Access&) = delete;
+    Access& operator=(const Access&) = delete;
+
+    bool isValid() const { return valid; }
+
+private:
+    SaveStore& store;
+    std::lock_guard<std::mutex> guard;
+    bool writing;
+    bool locked = false;
+    bool valid = false;
+};
+
+SaveStore::ScanGuard::ScanGuard(const SaveStore& store) : access(new Access(store, false)) {
+    if (access->isValid()) {
+        slotCount = store.dataHeader()->slotCount;
+    }
+}
+
+SaveStore::ScanGuard::~ScanGuard() = default;
+
+bool SaveStore::ScanGuard::isValid() const {
+    return access->isValid();
+}
+
+std::uint32_t SaveStore::ScanGuard::getSlotCount() const {
+    return slotCount;
+}
+
+std::shared_ptr<SaveStore> SaveStore::open(const std::string& directory) {
+    static std::mutex registryLock;
+    static std::map<std::string, std::shared_ptr<SaveStore>> registry;
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    auto it = registry.find(directory);
+    if (it != registry.end()) {
+        return it->second;
+    }
+    std::shared_ptr<SaveStore> store(new SaveStore(directory));
+    if (store->openFiles()) {
+        // No se importan solas: borrar archivos del usuario es cosa de un comando explicito
+        std::size_t loose = findLooseFiles(directory).size();
+        if (loose > 0) {
+            TRIKI_INFO(LOG_IO, directory << " tiene " << loose << " partidas sueltas (.triki) fuera del almacen; "
+                       "'triki migrar " << directory << "' las pasa adentro");
+        }
+    } else {
+        store.reset();
+    }
+    registry[directory] = store;  // Tambien se recuerda el fallo: no se reintenta en cada llamada
+    return store;
+}
+
+SaveStore::SaveStore(const std::string& directory) : directory(directory) {
+    static_assert(sizeof(Slot) == SLOT_BYTES, "La casilla debe medir SLOT_BYTES");
+    static_assert(MAX_DATA >= SAVE_HEADER_BYTES + 256 + SAVE_CHECKSUM_BYTES,
+                  "Una partida v2 de 256 casillas debe caber en una casilla");
+}
+
+SaveStore::~SaveStore() {
+    if (dataMap && indexMap && lockFile(dataFd, LOCK_EX) && refreshMaps()) {
+        // Todo a disco. Solo el ultimo proceso en cerrar (el unico que puede
+        // pasar su candado de partidas.idx a exclusivo) sella el indice y
+        // baja la marca; con un cambio cortado a medias queda para el proximo
+        bool last = flock(indexFd, LOCK_EX | LOCK_NB) == 0 && !dataHeader()->busy;
+        if (last) {
+            indexHeader()->stamp = dataHeader()->nextSequence;
+        }
+        msync(indexMap, indexBytes, MS_SYNC);
+        msync(dataMap, dataBytes, MS_SYNC);
+        if (last) {
+            dataHeader()->dirty = 0;
+            msync(dataMap, DATA_HEADER_BYTES, MS_SYNC);
+        }
+    }
+    if (indexMap) munmap(indexMap, indexBytes);
+    if (dataMap) munmap(dataMap, dataBytes);
+    if (indexFd >= 0) ::close(indexFd);  // Suelta tambien los flock
+    if (dataFd >= 0) ::close(dataFd);
+}
+
+bool SaveStore::openFiles() {
+    std::string dataPath = directory + "/partidas.dat";
+    std::string indexPath = directory + "/partidas.idx";
+
+    dataFd = ::open(dataPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (dataFd < 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo abrir " << dataPath << ": " << std::strerror(errno));
+        return false;
+    }
+    indexFd = ::open(indexPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (indexFd < 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo abrir " << indexPath << ": " << std::strerror(errno));
+        return false;
+    }
+    // Mientras se abre nadie cambia el almacen ni lo abre o cierra
+    if (!lockFile(dataFd, LOCK_EX)) {
+        return false;
+    }
+    bool opened = openLocked();
+    flock(dataFd, LOCK_UN);
+    return opened;
+}
+
+bool SaveStore::openLocked() {
+    std::string dataPath = directory + "/partidas.dat";
+
+    // Si nadie mas lo tiene abierto este proceso es el primero y le toca
+    // revisar el cierre limpio; despues queda el compartido hasta cerrar
+    bool first = flock(indexFd, LOCK_EX | LOCK_NB) == 0;
+    if (!lockFile(indexFd, LOCK_SH)) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(dataFd, &info) != 0) return false;
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    bool fresh = size < DATA_HEADER_BYTES;
+    if (fresh) {
+        size = DATA_HEADER_BYTES + static_cast<std::size_t>(INITIAL_SLOTS) * SLOT_BYTES;
+        if (ftruncate(dataFd, static_cast<off_t>(size)) != 0) return false;
+    }
+    dataMap = static_cast<unsigned char*>(mapFile(dataFd, size));
+    if (!dataMap) return false;
+    dataBytes = size;
+
+    DataHeader* header = dataHeader();
+    if (fresh) {
+        std::memcpy(header->magic, DATA_MAGIC, sizeof(DATA_MAGIC));
+        header->version = STORE_VERSION;
+        header->slotBytes = SLOT_BYTES;
+        header->slotCount = INITIAL_SLOTS;
+        header->nextSequence = 1;
+        header->dirty = 1;  // Fuerza armar lista libre e indice abajo
+    } else if (std::memcmp(header->magic, DATA_MAGIC, sizeof(DATA_MAGIC)) != 0 ||
+               header->version != STORE_VERSION || header->slotBytes != SLOT_BYTES) {
+        TRIKI_ERROR(LOG_IO, dataPath << " no es un almacen de partidas valido");
+        return false;
+    } else {
+        // Un archivo recortado solo conserva las casillas completas
+        std::uint32_t fits = static_cast<std::uint32_t>((size - DATA_HEADER_BYTES) / SLOT_BYTES);
+        if (header->slotCount > fits) {
+            TRIKI_WARNING(LOG_IO, "Almacen recortado: " << header->slotCount << " -> " << fits << " casillas");
+            header->slotCount = fits;
+            header->dirty = 1;
+        }
+    }
+
+    bool indexValid = false;
+    if (fstat(indexFd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(IndexHeader)) {
+        indexBytes = static_cast<std::size_t>(info.st_size);
+        indexMap = static_cast<unsigned char*>(mapFile(indexFd, indexBytes));
+        if (!indexMap) return false;
+        const IndexHeader* index = indexHeader();
+        std::uint32_t capacity = index->capacity;
+        indexValid = std::memcmp(index->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+                     index->version == STORE_VERSION &&
+                     capacity != 0 && (capacity & (capacity - 1)) == 0 &&
+                     indexBytes == sizeof(IndexHeader) + static_cast<std::size_t>(capacity) * sizeof(IndexEntry);
+        // Con otros procesos abiertos el indice esta vivo y todavia sin
+        // sellar; el sello solo se le exige al primero
+        if (first && (header->dirty || index->stamp != header->nextSequence)) {
+            indexValid = false;
+        }
+    }
+
+    if (fresh || header->busy || !indexValid) {
+        if (header->busy) {
+            TRIKI_WARNING(LOG_IO, "Un proceso se corto cambiando el almacen de " << directory
+                          << ": reconstruyendo indice y lista libre");
+        } else if (!fresh) {
+            TRIKI_INFO(LOG_IO, "Almacen de partidas sin cierre limpio: reconstruyendo indice y lista libre");
+        }
+        if (!repair()) return false;
+    }
+    dataHeader()->dirty = 1;
+    TRIKI_DEBUG(LOG_IO, "Almacen abierto: " << dataHeader()->liveCount << " partidas en "
+                << dataHeader()->slotCount << " casillas");
+    return true;
+}
+
+// Otro proceso pudo agrandar partidas.dat o rehacer el indice desde la
+// ultima operacion de este: se vuelve a proyectar con el tamano actual
+bool SaveStore::refreshMaps() const {
+    if (!dataMap || !indexMap) {
+        return false;
+    }
+    std::size_t dataNeeded = DATA_HEADER_BYTES + static_cast<std::size_t>(dataHeader()->slotCount) * SLOT_BYTES;
+    if (dataNeeded > dataBytes) {
+        void* map = mremap(dataMap, dataBytes, dataNeeded, MREMAP_MAYMOVE);
+        if (map == MAP_FAILED) {
+            TRIKI_ERROR(LOG_IO, "No se pudo proyectar el almacen: " << std::strerror(errno));
+            return false;
+        }
+        dataMap = static_cast<unsigned char*>(map);
+        dataBytes = dataNeeded;
+    }
+    std::size_t indexNeeded = sizeof(IndexHeader) + static_cast<std::size_t>(indexHeader()->capacity) * sizeof(IndexEntry);
+    if (indexNeeded != indexBytes) {
+        munmap(indexMap, indexBytes);
+        indexMap = static_cast<unsigned char*>(mapFile(indexFd, indexNeeded));
+        if (!indexMap) {
+            TRIKI_ERROR(LOG_IO, "No se pudo proyectar el indice del almacen: " << std::strerror(errno));
+            indexBytes = 0;
+            return false;
+        }
+        indexBytes = indexNeeded;
+    }
+    return true;
+}
+
+// Indice y lista libre rehechos desde las casillas (con el exclusivo tomado)
+bool SaveStore::repair() {
+    if (!rebuildIndex()) return false;
+    rebuildFreeList();
+    dataHeader()->busy = 0;
+    return true;
+}
+
+int SaveStore::importLooseFiles(bool removeOriginals) {
+    std::vector<std::filesystem::path> imported;
+    int skipped = 0;
+    {
+        Access access(*this, true);
+        if (!access.isValid()) return -1;
+        for (const auto& path : findLooseFiles(directory)) {
+            std::string name = path.filename().string();
+            struct stat info;
+            std::ifstream file(path, std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if (!file.is_open() || file.bad() || ::stat(path.c_str(), &info) != 0) {
+                TRIKI_WARNING(LOG_IO, "No se pudo leer " << path.string() << ": queda suelta");
+                continue;
+            }
+            std::int64_t modified = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+            // Una partida guardada en el almacen despues que el archivo no se pisa
+            std::int64_t position = findEntry(name);
+            if (position >= 0 && slot(indexEntries()[position].slot - 1)->modified >= modified) {
+                skipped++;
+                continue;
+            }
+            if (writeLocked(name, content.data(), content.size(), modified)) {
+                imported.push_back(path);
+            }
+        }
+        // Adentro y en disco antes de borrar un solo archivo
+        if (!imported.empty() && msync(dataMap, dataBytes, MS_SYNC) != 0) {
+            TRIKI_ERROR(LOG_IO, "No se pudo llevar el almacen a disco: " << std::strerror(errno)
+                        << "; las partidas sueltas no se borran");
+            removeOriginals = false;
+        }
+    }
+
+    if (removeOriginals) {
+        for (const auto& path : imported) {
+            std::error_code error;
+            if (!std::filesystem::remove(path, error)) {
+                TRIKI_WARNING(LOG_IO, "No se pudo borrar " << path.string() << ": " << error.message());
+            }
+        }
+    }
+    if (skipped > 0) {
+        TRIKI_WARNING(LOG_IO, skipped << " partidas sueltas no se importaron: el almacen ya tiene una version "
+                      "igual o mas nueva (los archivos quedan)");
+    }
+    TRIKI_INFO(LOG_IO, "Almacen: " << imported.size() << " partidas sueltas importadas desde " << directory);
+    return static_cast<int>(imported.size());
+}
+
+SaveStore::DataHeader* SaveStore::dataHeader() const {
+    return reinterpret_cast<DataHeader*>(dataMap);
+}
+
+SaveStore::Slot* SaveStore::slot(std::uint32_t index) const {
+    return reinterpret_cast<Slot*>(dataMap + DATA_HEADER_BYTES + static_cast<std::size_t>(index) * SLOT_BYTES);
+}
+
+SaveStore::IndexHeader* SaveStore::indexHeader() const {
+    return reinterpret_cast<IndexHeader*>(indexMap);
+}
+
+SaveStore::IndexEntry* SaveStore::indexEntries() const {
+    return reinterpret_cast<IndexEntry*>(indexMap + sizeof(IndexHeader));
+}
+
+// Duplica el numero de casillas; las nuevas quedan en la lista libre
+bool SaveStore::growData() {
+    std::uint32_t oldCount = dataHeader()->slotCount;
+    std::uint32_t newCount = oldCount * 2;
+    std::size_t newBytes = DATA_HEADER_BYTES + static_cast<std::size_t>(newCount) * SLOT_BYTES;
+    if (ftruncate(dataFd, static_cast<off_t>(newBytes)) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo agrandar el almacen: " << std::strerror(errno));
+        return false;
+    }
+    void* map = mremap(dataMap, dataBytes, newBytes, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) {
+        TRIKI_ERROR(LOG_IO, "No se pudo proyectar el almacen: " << std::strerror(errno));
+        return false;
+    }
+    dataMap = static_cast<unsigned char*>(map);
+    dataBytes = newBytes;
+
+    DataHeader* header = dataHeader();
+    for (std::uint32_t i = newCount; i-- > oldCount;) {
+        slot(i)->nextFree = header->freeHead;
+        header->freeHead = i + 1;
+    }
+    header->slotCount = newCount;
+    TRIKI_DEBUG(LOG_IO, "Almacen agrandado a " << newCount << " casillas");
+    return true;
+}
+
+// Deja un indice vacio de 'capacity' entradas
+bool SaveStore::resizeIndex(std::uint32_t capacity) {
+    std::size_t newBytes = sizeof(IndexHeader) + static_cast<std::size_t>(capacity) * sizeof(IndexEntry);
+    if (indexMap) {
+        munmap(indexMap, indexBytes);
+        indexMap = nullptr;
+    }
+    // Truncar a 0 primero deja todas las entradas en cero sin recorrerlas
+    if (ftruncate(indexFd, 0) != 0 || ftruncate(indexFd, static_cast<off_t>(newBytes)) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo dimensionar el indice: " << std::strerror(errno));
+        return false;
+    }
+    indexMap = static_cast<unsigned char*>(mapFile(indexFd, newBytes));
+    if (!indexMap) return false;
+    indexBytes = newBytes;
+
+    IndexHeader* index = indexHeader();
+    std::memcpy(index->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    index->version = STORE_VERSION;
+    index->capacity = capacity;
+    index->used = 0;
+    index->live = 0;
+    return true;
+}
+
+// Indice nuevo a partir de las casillas vivas con CRC correcto. Si un nombre
+// aparece dos veces (corte entre escribir la casilla nueva y liberar la
+// vieja) se queda la de mayor secuencia; la otra se marca libre.
+bool SaveStore::rebuildIndex() {
+    DataHeader* header = dataHeader();
+    std::uint32_t live = 0;
+    for (std::uint32_t i = 0; i < header->slotCount; i++) {
+        Slot* s = slot(i);
+        if (s->state != SLOT_LIVE) continue;
+        bool valid = s->nameLength > 0 && s->nameLength <= MAX_NAME && s->dataLength <= MAX_DATA &&
+                     crc32(s->data, s->dataLength, crc32(s->name, s->nameLength)) == s->crc;
+        if (!valid) {
+            TRIKI_WARNING(LOG_IO, "Almacen: casilla " << i << " danada, se descarta");
+            s->state = SLOT_FREE;
+            continue;
+        }
+        live++;
+    }
+
+    std::uint32_t capacity = INITIAL_INDEX_CAPACITY;
+    while (capacity < live * 2) capacity *= 2;
+    if (!resizeIndex(capacity)) return false;
+
+    for (std::uint32_t i = 0; i < header->slotCount; i++) {
+        Slot* s = slot(i);
+        if (s->state != SLOT_LIVE) continue;
+        std::int64_t position = findEntry(std::string(s->name, s->nameLength));
+        if (position >= 0) {
+            IndexEntry& entry = indexEntries()[position];
+            Slot* other = slot(entry.slot - 1);
+            if (other->sequence > s->sequence) {
+                s->state = SLOT_FREE;
+                continue;
+            }
+            other->state = SLOT_FREE;
+            entry.slot = i + 1;
+            continue;
+        }
+        insertEntry(hashName(s->name, s->nameLength), i);
+    }
+    header->liveCount = indexHeader()->live;
+    return true;
+}
+
+// La lista libre enlaza todas las casillas no vivas, de menor a mayor
+void SaveStore::rebuildFreeList() {
+    DataHeader* header = dataHeader();
+    header->freeHead = 0;
+    for (std::uint32_t i = header->slotCount; i-- > 0;) {
+        Slot* s = slot(i);
+        if (s->state == SLOT_LIVE) continue;
+        s->state = SLOT_FREE;
+        s->nextFree = header->freeHead;
+        header->freeHead = i + 1;
+    }
+}
+
+std::int64_t SaveStore::findEntry(const std::string& name) const {
+    const IndexHeader* index = indexHeader();
+    const IndexEntry* entries = indexEntries();
+    std::uint32_t hash = hashName(name.data(), name.size());
+    std::uint32_t mask = index->capacity - 1;
+    for (std::uint32_t position = hash & mask;; position = (position + 1) & mask) {
+        const IndexEntry& entry = entries[position];
+        if (entry.slot == 0) return -1;
+        if (entry.slot != TOMBSTONE && entry.hash == hash) {
+            const Slot* s = slot(entry.slot - 1);
+            if (s->nameLength == name.size() && std::memcmp(s->name, name.data(), name.size()) == 0) {
+                return position;
+            }
+        }
+    }
+}
+
+void SaveStore::insertEntry(std::uint32_t hash, std::uint32_t slotIndex) {
+    IndexHeader* index = indexHeader();
+    // Carga maxima del 70% contando las borradas: se duplica o se limpia
+    if ((static_cast<std::uint64_t>(index->used) + 1) * 10 > static_cast<std::uint64_t>(index->capacity) * 7) {
+        std::vector<IndexEntry> kept;
+        kept.reserve(index->live);
+        for (std::uint32_t i = 0; i < index->capacity; i++) {
+            const IndexEntry& entry = indexEntries()[i];
+            if (entry.slot != 0 && entry.slot != TOMBSTONE) kept.push_back(entry);
+        }
+        std::uint32_t capacity = index->capacity;
+        if (kept.size() * 4 >= capacity) capacity *= 2;
+        if (!resizeIndex(capacity)) return;
+        for (const IndexEntry& entry : kept) insertEntry(entry.hash, entry.slot - 1);
+        index = indexHeader();
+    }
+
+    IndexEntry* entries = indexEntries();
+    std::uint32_t mask = index->capacity - 1;
+    std::uint32_t position = hash & mask;
+    while (entries[position].slot != 0 && entries[position].slot != TOMBSTONE) {
+        position = (position + 1) & mask;
+    }
+    if (entries[position].slot == 0) index->used++;
+    entries[position].hash = hash;
+    entries[position].slot = slotIndex + 1;
+    index->live++;
+}
+
+void SaveStore::freeSlot(std::uint32_t index) {
+    Slot* s = slot(index);
+    s->state = SLOT_FREE;
+    s->nextFree = dataHeader()->freeHead;
+    dataHeader()->freeHead = index + 1;
+}
+
+bool SaveStore::writeLocked(const std::string& name, const char* data, std::size_t size, std::int64_t modified) {
+    if (name.empty() || name.size() > MAX_NAME || size > MAX_DATA) {
+        TRIKI_ERROR(LOG_IO, "Partida demasiado grande para el almacen: " << name
+                    << " (" << size << " bytes, maximo " << MAX_DATA << ")");
+        return false;
+    }
+    if (dataHeader()->freeHead == 0 && !growData()) {
+        return false;
+    }
+
+    // Casilla nueva completa antes de publicarla; la vieja se libera despues
+    DataHeader* header = dataHeader();
+    std::uint32_t index = header->freeHead - 1;
+    Slot* s = slot(index);
+    header->freeHead = s->nextFree;
+    s->nextFree = 0;
+    s->sequence = header->nextSequence++;
+    s->modified = modified;
+    s->nameLength = static_cast<std::uint16_t>(name.size());
+    s->dataLength = static_cast<std::uint16_t>(size);
+    std::memcpy(s->name, name.data(), name.size());
+    std::memcpy(s->data, data, size);
+    s->crc = crc32(s->data, size, crc32(s->name, name.size()));
+    s->state = SLOT_LIVE;
+
+    std::int64_t position = findEntry(name);
+    if (position >= 0) {
+        IndexEntry& entry = indexEntries()[position];
+        std::uint32_t old = entry.slot - 1;
+        entry.slot = index + 1;
+        freeSlot(old);
+    } else {
+        insertEntry(hashName(name.data(), name.size()), index);
+        header->liveCount++;
+    }
+    return true;
+}
+
+bool SaveStore::write(const std::string& name, const std::vector<char>& data) {
+    Access access(*this, true);
+    return access.isValid() && writeLocked(name, data.data(), data.size(), nowNanos());
+}
+
+void SaveStore::writeBatch(const std::vector<std::string>& names, const std::vector<std::vector<char>>& contents,
+                           std::vector<bool>& results) {
+    results.assign(names.size(), false);
+    std::int64_t modified = nowNanos();
+    Access access(*this, true);
+    if (!access.isValid()) return;
+    for (std::size_t i = 0; i < names.size(); i++) {
+        results[i] = writeLocked(names[i], contents[i].data(), contents[i].size(), modified);
+    }
+}
+
+bool SaveStore::read(const std::string& name, std::vector<char>& data) const {
+    Access access(*this, false);
+    if (!access.isValid()) return false;
+    std::int64_t position = findEntry(name);
+    if (position < 0) return false;
+    const Slot* s = slot(indexEntries()[position].slot - 1);
+    if (crc32(s->data, s->dataLength, crc32(s->name, s->nameLength)) != s->crc) {
+        TRIKI_ERROR(LOG_IO, "Partida danada en el almacen: " << name);
+        return false;
+    }
+    data.assign(s->data, s->data + s->dataLength);
+    return true;
+}
+
+bool SaveStore::contains(const std::string& name) const {
+    Access access(*this, false);
+    return access.isValid() && findEntry(name) >= 0;
+}
+
+bool SaveStore::remove(const std::string& name) {
+    Access access(*this, true);
+    if (!access.isValid()) return false;
+    std::int64_t position = findEntry(name);
+    if (position < 0) return false;
+    IndexEntry& entry = indexEntries()[position];
+    std::uint32_t index = entry.slot - 1;
+    entry.slot = TOMBSTONE;
+    indexHeader()->live--;
+    dataHeader()->liveCount--;
+    freeSlot(index);
+    return true;
+}
+
+std::vector<SaveStore::Entry> SaveStore::list() const {
+    Access access(*this, false);
+    std::vector<Entry> entries;
+    if (!access.isValid()) return entries;
+    entries.reserve(dataHeader()->liveCount);
+    std::uint32_t count = dataHeader()->slotCount;
+    for (std::uint32_t i = 0; i < count; i++) {
+        const Slot* s = slot(i);
+        if (s->state == SLOT_LIVE) {
+            entries.push_back(Entry{std::string(s->name, s->nameLength), s->dataLength, s->modified});
+        }
+    }
+    return entries;
+}
+
+void SaveStore::visitSlots(std::uint32_t begin, std::uint32_t end, const SlotVisitor& visit) const {
+    end = std::min(end, dataHeader()->slotCount);
+    for (std::uint32_t i = begin; i < end; i++) {
+        const Slot* s = slot(i);
+        if (s->state == SLOT_LIVE) {
+            visit(s->name, s->nameLength, reinterpret_cast<const unsigned char*>(s->data), s->dataLength);
+        }
+    }
+}
+
+int SaveStore::getCount() const {
+    Access access(*this, false);
+    return access.isValid() ? static_cast<int>(dataHeader()->liveCount) : 0;
+}
+
+int SaveStore::getCapacity() const {
+    Access access(*this, false);
+    return access.isValid() ? static_cast<int>(dataHeader()->slotCount) : 0;
+}
+
+std::size_t SaveStore::getFileBytes() const {
+    Access access(*this, false);
+    return dataBytes + indexBytes;
+}
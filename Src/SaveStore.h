@@ -0,0 +1,143 @@
+#ifndef SAVESTORE_H
+#define SAVESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ALMACEN EMPAQUETADO DE PARTIDAS
+// Todas las partidas de un directorio viven en dos archivos proyectados en
+// memoria (mmap) en lugar de un archivo por partida:
+//   partidas.dat  cabecera de 4 KB + casillas de SLOT_BYTES bytes; cada
+//                 casilla guarda nombre, fecha, tamaño, CRC-32 y contenido.
+//                 Las casillas libres forman una lista enlazada que se
+//                 reutiliza antes de agrandar el archivo.
+//   partidas.idx  tabla hash (direccionamiento abierto) nombre -> casilla.
+// Listar, medir y ordenar por fecha se hace leyendo memoria, sin una
+// llamada al sistema por partida.
+//
+// El indice se puede reconstruir siempre desde partidas.dat: si el programa
+// no cerro limpio (marca 'dirty') o el indice no coincide, se rehace al abrir.
+// Reemplazar una partida escribe una casilla nueva y recien despues libera
+// la vieja; ante dos casillas con el mismo nombre gana la de mayor secuencia.
+// Los enteros se guardan en el orden de bytes de la maquina.
+//
+// Varios procesos pueden tener el mismo almacen abierto: cada operacion toma
+// flock sobre partidas.dat (compartido para leer, exclusivo para cambiar) y
+// antes vuelve a proyectar lo que otro proceso haya agrandado. Un proceso
+// que muere a mitad de un cambio deja la marca 'busy'; el siguiente que
+// toma el candado rehace el indice y la lista libre. Cada proceso abierto
+// tiene ademas un candado compartido sobre partidas.idx: solo el primero en
+// abrir revisa el cierre limpio y solo el ultimo en cerrar sella el indice.
+class SaveStore {
+    class Access;  // Candado del proceso + flock del archivo
+
+public:
+    static const int SLOT_BYTES = 512;
+    static const int MAX_NAME = 112;
+    static const int MAX_DATA = 368;
+
+    struct Entry {
+        std::string name;
+        std::size_t size;
+        std::int64_t modified;  // Nanosegundos desde 1970
+    };
+
+    // Un almacen por directorio y por proceso; se mantiene abierto hasta el
+    // final del programa. nullptr si no se pudo abrir (sin permisos o un
+    // partidas.dat que no es un almacen): en ese caso se sigue con un archivo
+    // por partida.
+    static std::shared_ptr<SaveStore> open(const std::string& directory);
+
+    ~SaveStore();
+    SaveStore(const SaveStore&) = delete;
+    SaveStore& operator=(const SaveStore&) = delete;
+
+    bool write(const std::string& name, const std::vector<char>& data);
+    // Varias partidas tomando el candado una sola vez; results[i] por cada una
+    void writeBatch(const std::vector<std::string>& names, const std::vector<std::vector<char>>& contents,
+                    std::vector<bool>& results);
+    bool read(const std::string& name, std::vector<char>& data) const;
+    bool contains(const std::string& name) const;
+    bool remove(const std::string& name);
+    std::vector<Entry> list() const;  // Sin orden definido
+
+    // Pasa al almacen las partidas sueltas (.triki) del directorio, de
+    // versiones anteriores o escritas cuando el almacen no se pudo abrir. Un
+    // nombre que el almacen ya tiene con fecha igual o mas nueva se salta y su
+    // archivo queda. Con 'removeOriginals' se borran los archivos importados,
+    // recien cuando el almacen esta en disco. Devuelve cuantas importo, -1 si
+    // fallo antes de empezar.
+    int importLooseFiles(bool removeOriginals);
+
+    // Mientras exista nadie escribe en el almacen: ni este proceso (candado
+    // del almacen) ni los demas (flock compartido). Los metodos de arriba se
+    // bloquean hasta que se destruye; visitSlots no.
+    class ScanGuard {
+    public:
+        explicit ScanGuard(const SaveStore& store);
+        ~ScanGuard();
+        ScanGuard(const ScanGuard&) = delete;
+        ScanGuard& operator=(const ScanGuard&) = delete;
+        bool isValid() const;
+        std::uint32_t getSlotCount() const;  // Casillas a recorrer con visitSlots
+    private:
+        std::unique_ptr<Access> access;
+        std::uint32_t slotCount = 0;
+    };
+
+    // Recorre sin copiar las partidas de las casillas [begin, end). No toma
+    // el candado: varios hilos pueden recorrer rangos distintos a la vez con
+    // un ScanGuard vivo.
+    using SlotVisitor = std::function<void(const char* name, std::size_t nameLength,
+                                           const unsigned char* data, std::size_t size)>;
+    void visitSlots(std::uint32_t begin, std::uint32_t end, const SlotVisitor& visit) const;
+
+    int getCount() const;
+    int getCapacity() const;
+    std::size_t getFileBytes() const;
+
+private:
+    struct DataHeader;
+    struct Slot;
+    struct IndexHeader;
+    struct IndexEntry;
+
+    std::string directory;
+    int dataFd = -1;    // flock de cada operacion
+    int indexFd = -1;   // flock compartido mientras el proceso lo tiene abierto
+    // Otro proceso puede agrandar los archivos: se vuelven a proyectar al
+    // tomar el candado, tambien desde los metodos const
+    mutable unsigned char* dataMap = nullptr;
+    mutable std::size_t dataBytes = 0;
+    mutable unsigned char* indexMap = nullptr;
+    mutable std::size_t indexBytes = 0;
+    mutable std::mutex lock;
+
+    explicit SaveStore(const std::string& directory);
+    bool openFiles();
+    bool openLocked();
+    bool refreshMaps() const;
+    bool repair();
+
+    DataHeader* dataHeader() const;
+    Slot* slot(std::uint32_t index) const;
+    IndexHeader* indexHeader() const;
+    IndexEntry* indexEntries() const;
+
+    bool growData();
+    bool resizeIndex(std::uint32_t capacity);
+    bool rebuildIndex();
+    void rebuildFreeList();
+
+    std::int64_t findEntry(const std::string& name) const;  // Posicion en el indice o -1
+    void insertEntry(std::uint32_t hash, std::uint32_t slotIndex);
+    bool writeLocked(const std::string& name, const char* data, std::size_t size, std::int64_t modified);
+    void freeSlot(std::uint32_t index);
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SEARCHTABLES_H
+#define SEARCHTABLES_H
+
+#include <array>
+#include <cstdint>
+#include "Board.h"
+#include "Zobrist.h"
+
+// Tablas compartidas por los motores de busqueda exacta (Solver y
+// ParallelSolver). Todo se genera en tiempo de compilacion.
+
+// SIMETRIAS DEL TABLERO - 8 si es cuadrado (rotaciones y espejos), 4 si no
+template <int Rows, int Cols>
+struct SymmetryTables {
+    static constexpr int NUM = (Rows == Cols) ? 8 : 4;
+
+    // Casilla destino de (row, col) bajo la simetria 's'
+    static constexpr int transform(int s, int row, int col) {
+        int r = row, c = col;
+        switch (s) {
+            case 1: r = row;            c = Cols - 1 - col; break;  // Espejo horizontal
+            case 2: r = Rows - 1 - row; c = col;            break;  // Espejo vertical
+            case 3: r = Rows - 1 - row; c = Cols - 1 - col; break;  // Rotacion 180
+            case 4: r = col;            c = row;            break;  // Transpuesta
+            case 5: r = col;            c = Rows - 1 - row; break;  // Rotacion 90
+            case 6: r = Cols - 1 - col; c = row;            break;  // Rotacion 270
+            case 7: r = Cols - 1 - col; c = Rows - 1 - row; break;  // Antitranspuesta
+            default: break;
+        }
+        return r * Cols + c;
+    }
+};
+
+// ORDEN DE JUGADAS - primero las casillas que pertenecen a mas lineas
+// (el centro en 3x3), lo que adelanta los cortes alfa-beta
+template <int Rows, int Cols, int K>
+struct MoveOrder {
+    std::array<int, Rows * Cols> cells{};
+
+    static constexpr MoveOrder build() {
+        MoveOrder order{};
+        constexpr auto& tables = Board<Rows, Cols, K>::TABLES;
+        for (int i = 0; i < Rows * Cols; i++) order.cells[i] = i;
+        // Ordenamiento por insercion estable (evaluado en compilacion)
+        for (int i = 1; i < Rows * Cols; i++) {
+            int cell = order.cells[i];
+            int j = i - 1;
+            while (j >= 0 && tables.cellLineCount[order.cells[j]] < tables.cellLineCount[cell]) {
+                order.cells[j + 1] = order.cells[j];
+                j--;
+            }
+            order.cells[j + 1] = cell;
+        }
+        return order;
+    }
+};
+
+// HASH DE ZOBRIST BAJO LAS SIMETRIAS - un hash por cada simetria del
+// tablero, todos al dia con XOR al jugar y deshacer (toggle sirve para
+// ambas cosas). El minimo identifica la clase de posiciones simetricas;
+// el hash de la simetria 0 es el mismo de BasicGame::getHash().
+template <int Rows, int Cols>
+struct SymmetricZobrist {
+    static constexpr int CELLS = Rows * Cols;
+    static constexpr int NUM = SymmetryTables<Rows, Cols>::NUM;
+
+    // keys[s][jugador][casilla] = clave de la casilla a la que 's' la lleva
+    std::array<std::array<std::array<std::uint64_t, CELLS>, 2>, NUM> keys{};
+
+    static constexpr SymmetricZobrist build() {
+        SymmetricZobrist t{};
+        for (int s = 0; s < NUM; s++) {
+            for (int player = 0; player < 2; player++) {
+                for (int cell = 0; cell < CELLS; cell++) {
+                    int mapped = SymmetryTables<Rows, Cols>::transform(s, cell / Cols, cell % Cols);
+                    t.keys[s][player][cell] = ZOBRIST<CELLS>.cells[player][mapped];
+                }
+            }
+        }
+        return t;
+    }
+};
+
+template <int Rows, int Cols>
+struct SymmetricHash {
+    static constexpr SymmetricZobrist<Rows, Cols> TABLE = SymmetricZobrist<Rows, Cols>::build();
+    std::uint64_t hashes[SymmetricZobrist<Rows, Cols>::NUM] = {};
+
+    template <int K>
+    static SymmetricHash of(const Board<Rows, Cols, K>& board) {
+        SymmetricHash hash;
+        for (int cell = 0; cell < Rows * Cols; cell++) {
+            int owner = board.owner(cell);
+            if (owner >= 0) hash.toggle(cell, owner);
+        }
+        return hash;
+    }
+
+    void toggle(int cell, int player) {
+        for (int s = 0; s < TABLE.NUM; s++) hashes[s] ^= TABLE.keys[s][player][cell];
+    }
+
+    std::uint64_t canonical(int player) const {
+        std::uint64_t best = hashes[0];
+        for (int s = 1; s < TABLE.NUM; s++) {
+            if (hashes[s] < best) best = hashes[s];
+        }
+        return player ? best ^ ZOBRIST<Rows * Cols>.sideToMove : best;
+    }
+};
+
+#endif
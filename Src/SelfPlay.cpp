@@ -0,0 +1,185 @@
+#include "SelfPlay.h"
+#include "BoundedQueue.h"
+#include "Logger.h"
+#include "Players.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Batch = std::vector<unsigned char>;
+
+// Partidas que toma un trabajador de una sola vez del contador global
+const long long GAMES_PER_CLAIM = 4096;
+
+struct WorkerTotals {
+    long long games = 0;
+    long long xWins = 0;
+    long long oWins = 0;
+    long long draws = 0;
+};
+
+void writeHeader(std::ofstream& file, std::uint64_t games) {
+    unsigned char header[16] = {'T', 'K', 'D', 'S', 1, 3, 3, 3};
+    for (int i = 0; i < 8; i++) {
+        header[8 + i] = static_cast<unsigned char>(games >> (8 * i));
+    }
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+// Partida aleatoria contra aleatoria sin pasar por MovePolicy: una
+// permutacion parcial de las casillas (Fisher-Yates) y la tabla de victorias
+// de 512 entradas. Cada numero aleatorio de 64 bits alcanza para dos jugadas.
+int playRandomGame(unsigned char moves[9], std::uint64_t& rng, int& count) {
+    const auto& winTable = Board<3, 3, 3>::TABLES.winTable;
+    unsigned char cells[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    unsigned bits[2] = {0, 0};
+    std::uint64_t random = 0;
+
+    for (count = 0; count < 9; count++) {
+        if ((count & 1) == 0) random = nextRandom(rng);
+        std::uint32_t half = static_cast<std::uint32_t>(random >> (32 * (count & 1)));
+        int remaining = 9 - count;
+        int pick = count + static_cast<int>((static_cast<std::uint64_t>(half) * remaining) >> 32);
+        unsigned char cell = cells[pick];
+        cells[pick] = cells[count];
+        moves[count] = cell;
+        
+        int player = count & 1;
+        bits[player] |= 1u << cell;
+        if (winTable[bits[player]]) {
+            count++;
+            return player + 1;
+        }
+    }
+    return 0;
+}
+
+void playGames(const SelfPlayConfig& config, int threadId, std::atomic<long long>& nextGame,
+               BoundedQueue<Batch>& queue, WorkerTotals& totals) {
+    std::unique_ptr<MovePolicy> policies[2] = {createPolicy(config.playerX), createPolicy(config.playerO)};
+    const bool randomOnly = config.playerX == "random" && config.playerO == "random";
+    std::uint64_t rng = mixSeed(config.seed, threadId);
+
+    Batch batch;
+    batch.reserve(config.batchBytes + 16);
+
+    while (true) {
+        long long first = nextGame.fetch_add(GAMES_PER_CLAIM, std::memory_order_relaxed);
+        if (first >= config.games) break;
+        long long last = std::min(first + GAMES_PER_CLAIM, config.games);
+
+        for (long long g = first; g < last; g++) {
+            unsigned char moves[9];
+            int count = 0;
+            int outcome = 0;
+
+            if (randomOnly) {
+                outcome = playRandomGame(moves, rng, count);
+            } else {
+                Board<3, 3, 3> board;
+                int player = 0;
+                while (count < 9) {
+                    int cell = policies[player]->chooseMove(board, player, rng);
+                    board.play(cell, player);
+                    moves[count++] = static_cast<unsigned char>(cell);
+                    if (board.completesLine(cell, player)) {
+                        outcome = player + 1;
+                        break;
+                    }
+                    player ^= 1;
+                }
+            }
+
+            // Registro: cabecera de un byte + jugadas empaquetadas de a 4 bits
+            batch.push_back(static_cast<unsigned char>((outcome << 4) | count));
+            for (int i = 0; i < count; i += 2) {
+                unsigned char high = (i + 1 < count) ? moves[i + 1] : 0;
+                batch.push_back(static_cast<unsigned char>(moves[i] | (high << 4)));
+            }
+
+            totals.games++;
+            if (outcome == 1) totals.xWins++;
+            else if (outcome == 2) totals.oWins++;
+            else totals.draws++;
+
+            if (batch.size() >= config.batchBytes) {
+                queue.push(std::move(batch));
+                batch = Batch();
+                batch.reserve(config.batchBytes + 16);
+            }
+        }
+    }
+
+    if (!batch.empty()) {
+        queue.push(std::move(batch));
+    }
+}
+
+}
+
+bool runSelfPlay(const SelfPlayConfig& config, SelfPlayStats& stats) {
+    if (!createPolicy(config.playerX) || !createPolicy(config.playerO)) {
+        TRIKI_ERROR(LOG_GAME, "Jugador desconocido (usa random, solver o mcts:<simulaciones>)");
+        return false;
+    }
+
+    std::ofstream file(config.outputPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        TRIKI_ERROR(LOG_IO, "No se pudo crear el dataset: " << config.outputPath);
+        return false;
+    }
+    writeHeader(file, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    const int threads = config.threads > 0 ? config.threads : 1;
+
+    BoundedQueue<Batch> queue(config.queueBatches);
+    std::atomic<long long> nextGame{0};
+    std::vector<WorkerTotals> totals(threads);
+    long long bytes = 16;
+
+    // Un solo escritor: los lotes llegan en cualquier orden entre hilos
+    std::thread writer([&]() {
+        Batch batch;
+        while (queue.pop(batch)) {
+            file.write(reinterpret_cast<const char*>(batch.data()), batch.size());
+            bytes += static_cast<long long>(batch.size());
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back(playGames, std::cref(config), t, std::ref(nextGame),
+                             std::ref(queue), std::ref(totals[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    queue.close();
+    writer.join();
+
+    stats = SelfPlayStats();
+    for (const auto& t : totals) {
+        stats.games += t.games;
+        stats.xWins += t.xWins;
+        stats.oWins += t.oWins;
+        stats.draws += t.draws;
+    }
+
+    // Completar la cabecera con el numero real de partidas
+    file.seekp(0);
+    writeHeader(file, static_cast<std::uint64_t>(stats.games));
+    file.close();
+
+    stats.bytesWritten = bytes;
+    stats.maxQueueDepth = queue.getMaxDepth();
+    stats.blockedPushes = queue.getBlockedPushes();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return !file.fail();
+}
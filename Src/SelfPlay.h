@@ -0,0 +1,49 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <cstdint>
+#include <string>
+
+// AUTOJUEGO MASIVO SIN CONSOLA (triki 3x3)
+// N partidas repartidas entre hilos trabajadores, cada uno con sus propios
+// jugadores y generador aleatorio. Los trabajadores llenan lotes de
+// registros que pasan por una cola acotada a un unico hilo escritor.
+//
+// FORMATO DEL DATASET (.tkds):
+//   Cabecera de 16 bytes, sin relleno:
+//     bytes 0-3:  "TKDS"
+//     byte 4:     version (1)
+//     bytes 5-7:  filas, columnas, k
+//     bytes 8-15: numero de partidas (uint64 LE)
+//   Un registro por partida:
+//     byte 0: (resultado << 4) | jugadas   (resultado 0 empate, 1 gana X, 2 gana O)
+//     luego las jugadas, dos casillas por byte (la primera en los 4 bits bajos)
+// Cada posicion de la partida se reconstruye reproduciendo las jugadas.
+struct SelfPlayConfig {
+    long long games = 1000000;
+    int threads = 1;
+    std::string playerX = "random";   // Ver createPolicy() en Players.h
+    std::string playerO = "random";
+    std::uint64_t seed = 12345;
+    std::string outputPath = "selfplay.tkds";
+    std::size_t batchBytes = 1 << 16; // Tamaño de cada lote enviado al escritor
+    std::size_t queueBatches = 64;    // Capacidad de la cola (en lotes)
+};
+
+struct SelfPlayStats {
+    long long games = 0;
+    long long xWins = 0;
+    long long oWins = 0;
+    long long draws = 0;
+    long long bytesWritten = 0;
+    double seconds = 0.0;
+    std::size_t maxQueueDepth = 0;
+    std::size_t blockedPushes = 0;
+    
+    double gamesPerSecond() const { return seconds > 0.0 ? games / seconds : 0.0; }
+};
+
+// Devuelve false si los jugadores no son validos o no se pudo escribir
+bool runSelfPlay(const SelfPlayConfig& config, SelfPlayStats& stats);
+
+#endif
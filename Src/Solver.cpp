@@ -0,0 +1,123 @@
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+
+template <int Rows, int Cols, int K>
+Solver<Rows, Cols, K>::Solver(int tableBits) {
+    table.assign(std::size_t(1) << tableBits, Entry{0, 0, EMPTY});
+    tableMask = table.size() - 1;
+}
+
+template <int Rows, int Cols, int K>
+int Solver<Rows, Cols, K>::negamax(BoardType& board, Hash& hash, int player, int alpha, int beta) {
+    static constexpr MoveOrder<Rows, Cols, K> ORDER = MoveOrder<Rows, Cols, K>::build();
+
+    stats.nodes++;
+
+    const int empties = CELLS - board.moveCount();
+    if (empties == 0) {
+        return 0;  // Tablero lleno sin ganador: empate
+    }
+
+    // Consultar la tabla de transposicion
+    const std::uint64_t key = hash.canonical(player);
+    Entry& entry = table[(key ^ (key >> 29)) & tableMask];
+    if (entry.bound != EMPTY && entry.key == key) {
+        stats.tableHits++;
+        int score = entry.score;
+        if (entry.bound == EXACT) return score;
+        if (entry.bound == LOWER && score > alpha) alpha = score;
+        if (entry.bound == UPPER && score < beta) beta = score;
+        if (alpha >= beta) return score;
+    }
+
+    const int alphaOrig = alpha;
+    int best = -CELLS - 1;
+
+    for (int cell : ORDER.cells) {
+        if (!board.isEmpty(cell)) continue;
+
+        board.play(cell, player);
+        int score;
+        if (board.completesLine(cell, player)) {
+            score = empties;  // Ganar ahora: mas casillas libres = victoria mas rapida
+        } else {
+            hash.toggle(cell, player);
+            score = -negamax(board, hash, player ^ 1, -beta, -alpha);
+            hash.toggle(cell, player);
+        }
+        board.unplay(cell, player);
+
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;  // Poda beta
+    }
+
+    // Guardar el resultado con el tipo de cota correspondiente
+    entry.key = key;
+    entry.score = static_cast<std::int8_t>(best);
+    entry.bound = (best <= alphaOrig) ? UPPER : (best >= beta) ? LOWER : EXACT;
+
+    return best;
+}
+
+template <int Rows, int Cols, int K>
+typename Solver<Rows, Cols, K>::Result Solver<Rows, Cols, K>::solve(const BoardType& board, int player) {
+    static constexpr MoveOrder<Rows, Cols, K> ORDER = MoveOrder<Rows, Cols, K>::build();
+
+    stats = SearchStats{};
+    auto start = std::chrono::steady_clock::now();
+
+    BoardType work = board;
+    Hash hash = Hash::of(work);
+    Result result{-1, -CELLS - 1};
+    const int empties = CELLS - work.moveCount();
+
+    // En la raiz cada jugada se evalua por separado para conocer la mejor
+    for (int cell : ORDER.cells) {
+        if (!work.isEmpty(cell)) continue;
+
+        work.play(cell, player);
+        int score;
+        if (work.completesLine(cell, player)) {
+            score = empties;
+        } else {
+            hash.toggle(cell, player);
+            score = -negamax(work, hash, player ^ 1, -CELLS - 1, -result.score);
+            hash.toggle(cell, player);
+        }
+        work.unplay(cell, player);
+
+        if (score > result.score) {
+            result.score = score;
+            result.move = cell;
+        }
+    }
+
+    if (result.move < 0) {
+        result.score = 0;
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+template <int Rows, int Cols, int K>
+int Solver<Rows, Cols, K>::bestMove(const BasicGame<Rows, Cols, K>& game) {
+    return solve(game.getBoard(), playerIndex(game.getCurrentPlayer())).move;
+}
+
+template <int Rows, int Cols, int K>
+const typename Solver<Rows, Cols, K>::SearchStats& Solver<Rows, Cols, K>::getStats() const {
+    return stats;
+}
+
+template <int Rows, int Cols, int K>
+void Solver<Rows, Cols, K>::clearTable() {
+    std::fill(table.begin(), table.end(), Entry{0, 0, EMPTY});
+}
+
+// INSTANCIACION EXPLICITA - tableros con solucion exacta practica
+template class Solver<3, 3, 3>;
+template class Solver<4, 4, 4>;
+template class Solver<5, 5, 4>;
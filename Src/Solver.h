@@ -0,0 +1,66 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+#include "SearchTables.h"
+
+// SOLUCIONADOR DE JUEGO PERFECTO
+// Negamax con poda alfa-beta y tabla de transposicion. La clave de cada
+// posicion es el menor de sus hashes de Zobrist bajo las simetrias del
+// tablero (8 si es cuadrado, 4 si no), actualizados con XOR en cada jugada,
+// para que las posiciones equivalentes se resuelvan una sola vez.
+// Solo para tableros de hasta 32 casillas (los demas no se terminan de resolver).
+template <int Rows, int Cols, int K>
+class Solver {
+public:
+    using BoardType = Board<Rows, Cols, K>;
+    static constexpr int CELLS = BoardType::CELLS;
+    static_assert(CELLS <= 32, "El solucionador exacto solo admite tableros de hasta 32 casillas");
+
+    static constexpr int NUM_SYMMETRIES = (Rows == Cols) ? 8 : 4;
+
+    // Resultado para el jugador que mueve: > 0 gana, 0 empate, < 0 pierde.
+    // El valor absoluto crece cuanto antes termina la partida.
+    struct Result {
+        int move;   // Casilla (fila*Cols + columna), -1 si no hay jugadas
+        int score;
+    };
+
+    // Estadisticas de la ultima busqueda
+    struct SearchStats {
+        long long nodes = 0;
+        long long tableHits = 0;
+        double seconds = 0.0;
+        double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+    };
+
+    explicit Solver(int tableBits = 20);
+
+    Result solve(const BoardType& board, int player);
+    int bestMove(const BasicGame<Rows, Cols, K>& game);
+
+    const SearchStats& getStats() const;
+    void clearTable();
+
+private:
+    enum Bound : std::uint8_t { EMPTY = 0, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        std::uint64_t key;
+        std::int8_t score;
+        Bound bound;
+    };
+
+    std::vector<Entry> table;   // Tabla de transposicion (tamaño potencia de 2)
+    std::uint64_t tableMask;
+    SearchStats stats;
+
+    using Hash = SymmetricHash<Rows, Cols>;
+
+    int negamax(BoardType& board, Hash& hash, int player, int alpha, int beta);
+};
+
+#endif
@@ -0,0 +1,493 @@
+#include "SpectatorFeed.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char* const SpectatorFeed::DEFAULT_PATH = "/dev/shm/triki-espectadores";
+
+namespace {
+
+const char FEED_MAGIC[4] = {'T', 'K', 'S', 'P'};
+const std::uint32_t FEED_VERSION = 1;
+const int SNAPSHOT_RETRIES = 100;  // Un escritor muerto a mitad de foto no cuelga al lector
+
+std::uint64_t packPayload(int type, int a, int b, int c) {
+    return static_cast<std::uint64_t>(type & 0xFF) |
+           static_cast<std::uint64_t>(a & 0xFF) << 8 |
+           static_cast<std::uint64_t>(b & 0xFF) << 16 |
+           static_cast<std::uint64_t>(c & 0xFFFF) << 24;
+}
+
+// Foto: estado 0-7, filas 8-15, columnas 16-23, K 24-31, ganador 32-39,
+// jugadas 40-55
+std::uint64_t packInfo(int state, int rows, int cols, int k, char winner, int moveCount) {
+    return static_cast<std::uint64_t>(state & 0xFF) |
+           static_cast<std::uint64_t>(rows & 0xFF) << 8 |
+           static_cast<std::uint64_t>(cols & 0xFF) << 16 |
+           static_cast<std::uint64_t>(k & 0xFF) << 24 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(winner)) << 32 |
+           static_cast<std::uint64_t>(moveCount & 0xFFFF) << 40;
+}
+
+int infoField(std::uint64_t info, int shift) {
+    return static_cast<int>((info >> shift) & 0xFF);
+}
+
+int infoMoveCount(std::uint64_t info) {
+    return static_cast<int>((info >> 40) & 0xFFFF);
+}
+
+}
+
+struct SpectatorFeed::Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t capacity;   // Registros del anillo, potencia de 2
+    std::uint32_t maxGames;
+    std::atomic<std::uint64_t> head;  // Secuencia del ultimo registro publicado
+    char reserved[40];
+};
+
+struct SpectatorFeed::Record {
+    std::atomic<std::uint64_t> sequence;  // 0 mientras se escribe
+    std::atomic<std::uint64_t> id;
+    std::atomic<std::uint64_t> payload;
+};
+
+struct SpectatorFeed::Snapshot {
+    std::atomic<std::uint64_t> version;  // Impar mientras se escribe
+    std::atomic<std::uint64_t> id;
+    std::atomic<std::uint64_t> lastSequence;  // Ultimo registro ya incluido
+    std::atomic<std::uint64_t> info;
+    std::atomic<std::uint64_t> moves[MAX_MOVES / 8];  // Una casilla por byte
+};
+
+static_assert(sizeof(SpectatorFeed::Header) == 64, "La cabecera ocupa 64 bytes");
+static_assert(sizeof(SpectatorFeed::Record) == 24, "Cada registro ocupa 24 bytes");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Los atomicos compartidos entre procesos no pueden usar candados");
+
+namespace {
+
+// Seqlock de la foto; solo quien publica escribe
+void beginSnapshot(SpectatorFeed::Snapshot& snapshot) {
+    snapshot.version.store(snapshot.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void endSnapshot(SpectatorFeed::Snapshot& snapshot) {
+    snapshot.version.store(snapshot.version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+}
+
+std::size_t SpectatorFeed::fileBytes(std::uint32_t capacity, std::uint32_t maxGames) {
+    return sizeof(Header) + static_cast<std::size_t>(capacity) * sizeof(Record) +
+           static_cast<std::size_t>(maxGames) * sizeof(Snapshot);
+}
+
+SpectatorFeed::SpectatorFeed(const Config& feedConfig) : config(feedConfig) {
+    std::uint32_t capacity = 16;
+    while (capacity < config.capacity && capacity < (1u << 24)) capacity <<= 1;
+    config.capacity = capacity;
+    config.maxGames = std::max<std::uint32_t>(1, std::min<std::uint32_t>(config.maxGames, 0xFFFF));
+
+    // Quien ya publica tiene el flock del archivo actual
+    int current = ::open(config.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (current >= 0) {
+        bool busy = flock(current, LOCK_EX | LOCK_NB) != 0;
+        ::close(current);
+        if (busy) {
+            TRIKI_ERROR(LOG_IO, "Otro proceso ya publica en " << config.path);
+            return;
+        }
+    }
+
+    // Archivo nuevo completo antes del rename: un espectador nunca ve uno a medias
+    const std::string tempPath = config.path + ".tmp";
+    mapBytes = fileBytes(config.capacity, config.maxGames);
+    fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX | LOCK_NB) != 0 || ftruncate(fd, static_cast<off_t>(mapBytes)) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo crear " << tempPath << ": " << std::strerror(errno));
+        return;
+    }
+    map = mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        map = nullptr;
+        TRIKI_ERROR(LOG_MEMORY, "No se pudo mapear " << tempPath << ": " << std::strerror(errno));
+        return;
+    }
+
+    // ftruncate deja todo en cero: registros vacios y casillas libres
+    Header* created = static_cast<Header*>(map);
+    created->version = FEED_VERSION;
+    created->capacity = config.capacity;
+    created->maxGames = config.maxGames;
+    std::memcpy(created->magic, FEED_MAGIC, sizeof(FEED_MAGIC));
+    if (std::rename(tempPath.c_str(), config.path.c_str()) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo publicar " << config.path << ": " << std::strerror(errno));
+        unlink(tempPath.c_str());
+        return;
+    }
+
+    header = created;
+    ring = reinterpret_cast<Record*>(static_cast<char*>(map) + sizeof(Header));
+    games = reinterpret_cast<Snapshot*>(ring + config.capacity);
+    for (std::uint32_t slot = config.maxGames; slot > 0; slot--) {
+        freeSlots.push_back(slot - 1);
+    }
+    TRIKI_INFO(LOG_IO, "Espectadores en " << config.path << " (" << config.capacity << " registros, "
+               << config.maxGames << " partidas, " << mapBytes / 1024 << " KB)");
+}
+
+SpectatorFeed::~SpectatorFeed() {
+    if (map) munmap(map, mapBytes);
+    if (fd >= 0) ::close(fd);  // Suelta tambien el flock
+}
+
+int SpectatorFeed::findSlot(std::uint64_t id) const {
+    auto it = slots.find(id);
+    return it == slots.end() ? -1 : static_cast<int>(it->second);
+}
+
+std::uint32_t SpectatorFeed::takeSlot() {
+    if (freeSlots.empty()) {
+        // Se desaloja la partida terminada hace mas tiempo
+        std::uint64_t oldestId = 0;
+        std::uint64_t oldestSequence = ~0ULL;
+        for (const auto& entry : slots) {
+            const Snapshot& snapshot = games[entry.second];
+            std::uint64_t last = snapshot.lastSequence.load(std::memory_order_relaxed);
+            if (infoField(snapshot.info.load(std::memory_order_relaxed), 0) == STATE_ENDED &&
+                last < oldestSequence) {
+                oldestId = entry.first;
+                oldestSequence = last;
+            }
+        }
+        if (oldestSequence == ~0ULL) {
+            return config.maxGames;
+        }
+        closeGame(oldestId);
+        stats.evicted++;
+    }
+    std::uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
+
+void SpectatorFeed::publish(EventType type, std::uint64_t id, int a, int b, int c) {
+    std::uint64_t next = ++sequence;
+    Record& record = ring[next & (config.capacity - 1)];
+    record.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.id.store(id, std::memory_order_relaxed);
+    record.payload.store(packPayload(type, a, b, c), std::memory_order_relaxed);
+    record.sequence.store(next, std::memory_order_release);
+    header->head.store(next, std::memory_order_release);
+    stats.records++;
+}
+
+void SpectatorFeed::beginGame(std::uint64_t id, int rows, int cols, int k) {
+    if (!header || rows * cols > MAX_MOVES) {
+        return;
+    }
+    int found = findSlot(id);
+    std::uint32_t slot = found >= 0 ? static_cast<std::uint32_t>(found) : takeSlot();
+    if (slot == config.maxGames) {
+        stats.unpublished++;
+        return;
+    }
+    slots[id] = slot;
+
+    Snapshot& snapshot = games[slot];
+    beginSnapshot(snapshot);
+    snapshot.id.store(id, std::memory_order_relaxed);
+    snapshot.info.store(packInfo(STATE_PLAYING, rows, cols, k, ' ', 0), std::memory_order_relaxed);
+    for (auto& word : snapshot.moves) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    snapshot.lastSequence.store(sequence + 1, std::memory_order_relaxed);
+    endSnapshot(snapshot);
+    publish(EVENT_START, id, rows, cols, k);
+}
+
+void SpectatorFeed::recordMove(std::uint64_t id, int cell) {
+    int slot = findSlot(id);
+    if (slot < 0) {
+        return;
+    }
+    Snapshot& snapshot = games[slot];
+    std::uint64_t info = snapshot.info.load(std::memory_order_relaxed);
+    int count = infoMoveCount(info);
+    if (infoField(info, 0) != STATE_PLAYING || count >= MAX_MOVES) {
+        return;
+    }
+    char player = (count % 2 == 0) ? 'X' : 'O';
+
+    std::atomic<std::uint64_t>& word = snapshot.moves[count / 8];
+    const int shift = (count % 8) * 8;
+    beginSnapshot(snapshot);
+    word.store((word.load(std::memory_order_relaxed) & ~(0xFFULL << shift)) |
+               static_cast<std::uint64_t>(cell & 0xFF) << shift, std::memory_order_relaxed);
+    snapshot.info.store((info & ~(0xFFFFULL << 40)) | static_cast<std::uint64_t>(count + 1) << 40,
+                        std::memory_order_relaxed);
+    snapshot.lastSequence.store(sequence + 1, std::memory_order_relaxed);
+    endSnapshot(snapshot);
+    publish(EVENT_MOVE, id, cell, player, count + 1);
+}
+
+void SpectatorFeed::endGame(std::uint64_t id, char winner) {
+    int slot = findSlot(id);
+    if (slot < 0) {
+        return;
+    }
+    Snapshot& snapshot = games[slot];
+    std::uint64_t info = snapshot.info.load(std::memory_order_relaxed);
+    beginSnapshot(snapshot);
+    snapshot.info.store(packInfo(STATE_ENDED, infoField(info, 8), infoField(info, 16), infoField(info, 24),
+                                 winner, infoMoveCount(info)), std::memory_order_relaxed);
+    snapshot.lastSequence.store(sequence + 1, std::memory_order_relaxed);
+    endSnapshot(snapshot);
+    publish(EVENT_END, id, 0, winner, infoMoveCount(info));
+}
+
+void SpectatorFeed::closeGame(std::uint64_t id) {
+    int slot = findSlot(id);
+    if (slot < 0) {
+        return;
+    }
+    Snapshot& snapshot = games[slot];
+    beginSnapshot(snapshot);
+    snapshot.id.store(0, std::memory_order_relaxed);
+    snapshot.info.store(packInfo(STATE_FREE, 0, 0, 0, ' ', 0), std::memory_order_relaxed);
+    snapshot.lastSequence.store(sequence + 1, std::memory_order_relaxed);
+    endSnapshot(snapshot);
+    publish(EVENT_CLOSE, id, 0, 0, 0);
+    slots.erase(id);
+    freeSlots.push_back(static_cast<std::uint32_t>(slot));
+}
+
+SpectatorView::SpectatorView(const std::string& feedPath) : path(feedPath) {
+    open();
+}
+
+SpectatorView::~SpectatorView() {
+    close();
+}
+
+bool SpectatorView::open() {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(SpectatorFeed::Header)) {
+        ::close(fd);
+        return false;
+    }
+    mapBytes = static_cast<std::size_t>(info.st_size);
+    map = mmap(nullptr, mapBytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // El mapa sigue valido sin el descriptor
+    if (map == MAP_FAILED) {
+        map = nullptr;
+        return false;
+    }
+
+    const auto* mapped = static_cast<const SpectatorFeed::Header*>(map);
+    if (std::memcmp(mapped->magic, FEED_MAGIC, sizeof(FEED_MAGIC)) != 0 || mapped->version != FEED_VERSION ||
+        mapped->capacity == 0 || (mapped->capacity & (mapped->capacity - 1)) != 0 ||
+        SpectatorFeed::fileBytes(mapped->capacity, mapped->maxGames) != mapBytes) {
+        TRIKI_WARNING(LOG_IO, path << " no es una transmision de espectadores valida");
+        close();
+        return false;
+    }
+    header = mapped;
+    capacity = mapped->capacity;
+    maxGames = mapped->maxGames;
+    ring = reinterpret_cast<const SpectatorFeed::Record*>(static_cast<const char*>(map) + sizeof(*header));
+    games = reinterpret_cast<const SpectatorFeed::Snapshot*>(ring + capacity);
+    inode = static_cast<unsigned long>(info.st_ino);
+    return true;
+}
+
+void SpectatorView::close() {
+    if (map) munmap(map, mapBytes);
+    map = nullptr;
+    header = nullptr;
+    ring = nullptr;
+    games = nullptr;
+}
+
+std::vector<std::uint64_t> SpectatorView::poll() {
+    std::vector<std::uint64_t> changed;
+
+    // Quien publica volvio a abrir (archivo nuevo) o todavia no hay archivo
+    struct stat info;
+    bool replaced = stat(path.c_str(), &info) != 0 || static_cast<unsigned long>(info.st_ino) != inode;
+    if (isOpen() && replaced) {
+        close();
+    }
+    if (!isOpen()) {
+        for (const auto& entry : boards) {
+            changed.push_back(entry.first);
+        }
+        boards.clear();
+        if (!open()) {
+            return changed;
+        }
+        staleSnapshots = true;
+    }
+    // Una foto que no se pudo leer entera deja su partida sin ver: se
+    // vuelve a intentar en cada llamada hasta leerlas todas
+    if (staleSnapshots) {
+        staleSnapshots = !resync(changed);
+    }
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        std::uint64_t head = header->head.load(std::memory_order_acquire);
+        bool consistent = head + 1 >= nextSequence && head - (nextSequence - 1) <= capacity;
+        for (std::uint64_t sequence = nextSequence; consistent && sequence <= head; sequence++) {
+            const SpectatorFeed::Record& record = ring[sequence & (capacity - 1)];
+            std::uint64_t before = record.sequence.load(std::memory_order_acquire);
+            std::uint64_t id = record.id.load(std::memory_order_relaxed);
+            std::uint64_t payload = record.payload.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            std::uint64_t after = record.sequence.load(std::memory_order_relaxed);
+            // Otro numero: quien publica ya dio la vuelta sobre este registro
+            consistent = before == sequence && after == sequence && apply(sequence, id, payload, changed);
+            if (consistent) {
+                nextSequence = sequence + 1;
+            }
+        }
+        if (consistent) {
+            break;
+        }
+        stats.overruns++;
+        staleSnapshots = !resync(changed);
+    }
+
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+bool SpectatorView::resync(std::vector<std::uint64_t>& changed) {
+    stats.resyncs++;
+    // Las fotos se leen despues de 'head': lo que ya incluyen se salta al
+    // seguir leyendo el anillo desde head + 1 (por la secuencia de cada partida)
+    std::uint64_t head = header->head.load(std::memory_order_acquire);
+    for (const auto& entry : boards) {
+        changed.push_back(entry.first);
+    }
+    boards.clear();
+
+    bool complete = true;
+    for (std::uint32_t slot = 0; slot < maxGames; slot++) {
+        const SpectatorFeed::Snapshot& snapshot = games[slot];
+        Board board;
+        std::uint64_t info = 0;
+        std::uint64_t words[SpectatorFeed::MAX_MOVES / 8];
+        bool read = false;
+        for (int retry = 0; retry < SNAPSHOT_RETRIES && !read; retry++) {
+            if (retry > 0) std::this_thread::yield();
+            std::uint64_t before = snapshot.version.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            board.id = snapshot.id.load(std::memory_order_relaxed);
+            board.lastSequence = snapshot.lastSequence.load(std::memory_order_relaxed);
+            info = snapshot.info.load(std::memory_order_relaxed);
+            for (int i = 0; i < SpectatorFeed::MAX_MOVES / 8; i++) {
+                words[i] = snapshot.moves[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            read = snapshot.version.load(std::memory_order_relaxed) == before;
+        }
+        if (!read) {
+            complete = false;
+            continue;
+        }
+        int state = infoField(info, 0);
+        if (state == SpectatorFeed::STATE_FREE) {
+            continue;
+        }
+        board.rows = infoField(info, 8);
+        board.cols = infoField(info, 16);
+        board.k = infoField(info, 24);
+        board.ended = state == SpectatorFeed::STATE_ENDED;
+        board.winner = static_cast<char>(infoField(info, 32));
+        board.cells.assign(static_cast<std::size_t>(board.rows * board.cols), ' ');
+        int count = infoMoveCount(info);
+        for (int i = 0; i < count && i < SpectatorFeed::MAX_MOVES; i++) {
+            unsigned char cell = static_cast<unsigned char>(words[i / 8] >> ((i % 8) * 8));
+            board.moves.push_back(cell);
+            if (cell < board.cells.size()) board.cells[cell] = (i % 2 == 0) ? 'X' : 'O';
+        }
+        changed.push_back(board.id);
+        boards[board.id] = std::move(board);
+    }
+    nextSequence = head + 1;
+    return complete;
+}
+
+bool SpectatorView::apply(std::uint64_t sequence, std::uint64_t id, std::uint64_t payload,
+                          std::vector<std::uint64_t>& changed) {
+    const int type = static_cast<int>(payload & 0xFF);
+    const int a = static_cast<int>((payload >> 8) & 0xFF);
+    const int b = static_cast<int>((payload >> 16) & 0xFF);
+    const int c = static_cast<int>((payload >> 24) & 0xFFFF);
+
+    auto it = boards.find(id);
+    if (it != boards.end() && sequence <= it->second.lastSequence) {
+        return true;  // Ya estaba en la foto
+    }
+    stats.records++;
+
+    if (type == SpectatorFeed::EVENT_START) {
+        Board board;
+        board.id = id;
+        board.rows = a;
+        board.cols = b;
+        board.k = c;
+        board.cells.assign(static_cast<std::size_t>(a * b), ' ');
+        board.lastSequence = sequence;
+        boards[id] = std::move(board);
+        changed.push_back(id);
+        return true;
+    }
+    if (type == SpectatorFeed::EVENT_CLOSE) {
+        if (it != boards.end()) {
+            boards.erase(it);
+            changed.push_back(id);
+        }
+        return true;
+    }
+    if (it == boards.end()) {
+        return true;  // Partida que empezo antes de la foto y ya no esta
+    }
+
+    Board& board = it->second;
+    if (type == SpectatorFeed::EVENT_MOVE) {
+        if (c <= static_cast<int>(board.moves.size())) {
+            board.lastSequence = sequence;
+            return true;
+        }
+        if (c != static_cast<int>(board.moves.size()) + 1 || a >= static_cast<int>(board.cells.size())) {
+            return false;
+        }
+        board.moves.push_back(static_cast<unsigned char>(a));
+        board.cells[a] = static_cast<char>(b);
+    } else if (type == SpectatorFeed::EVENT_END) {
+        board.ended = true;
+        board.winner = static_cast<char>(b);
+    }
+    board.lastSequence = sequence;
+    changed.push_back(id);
+    return true;
+}
@@ -0,0 +1,158 @@
+#ifndef SPECTATORFEED_H
+#define SPECTATORFEED_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// TRANSMISION PARA ESPECTADORES EN MEMORIA COMPARTIDA
+// Un solo proceso publica (el servidor o el menu) y cualquier numero de
+// espectadores lee el mismo archivo mapeado con mmap, sin sockets ni
+// copias: cada cambio de una partida es un registro de 24 bytes en un
+// anillo de 'capacity' registros. Quien publica nunca espera a nadie; un
+// espectador lento que se queda mas de una vuelta atras lo detecta y se
+// resincroniza desde la foto de cada partida, que vive en el mismo archivo.
+//
+// Publicar no es seguro entre hilos: un solo hilo (el ciclo de eventos del
+// servidor o el hilo del menu) llama a beginGame/recordMove/endGame/closeGame.
+// Un segundo proceso que intente publicar en el mismo archivo no lo abre
+// (flock). Al abrir se crea un archivo nuevo (temporal + rename) y los
+// espectadores que ya estaban mirando pasan solos al nuevo.
+//
+// FORMATO: cabecera de 64 bytes ("TKSP", version 1, capacidad, casillas de
+// partida y la secuencia del ultimo registro), el anillo y una foto por
+// casilla de partida. Cada registro de 24 bytes lleva su numero de
+// secuencia (desde 1), el id de la partida y un dato de 64 bits:
+//   bits 0-7 tipo, 8-15 'a', 16-23 'b', 24-39 'c'
+// con tipo 1 inicio (a filas, b columnas, c K), 2 jugada (a casilla,
+// b 'X'/'O', c numero de jugada), 3 fin (b ganador, ' ' empate) y 4 cierre.
+// Registros y fotos se escriben con un seqlock: el lector repite o
+// descarta lo que cambio mientras lo leia.
+class SpectatorFeed {
+public:
+    static const char* const DEFAULT_PATH;  // En /dev/shm: nunca toca el disco
+
+    enum EventType { EVENT_START = 1, EVENT_MOVE = 2, EVENT_END = 3, EVENT_CLOSE = 4 };
+    enum GameState { STATE_FREE = 0, STATE_PLAYING = 1, STATE_ENDED = 2 };
+
+    static const int MAX_MOVES = 256;
+
+    struct Config {
+        std::string path = DEFAULT_PATH;
+        std::uint32_t capacity = 4096;  // Registros del anillo (se sube a potencia de 2)
+        std::uint32_t maxGames = 1024;  // Partidas visibles a la vez
+    };
+
+    struct Stats {
+        long long records = 0;
+        long long unpublished = 0;  // Partidas sin casilla libre (no se transmiten)
+        long long evicted = 0;      // Partidas terminadas desalojadas por otras nuevas
+    };
+
+    // Layout compartido (tipos atomicos sin candados, validos entre procesos)
+    struct Header;
+    struct Record;
+    struct Snapshot;
+
+    explicit SpectatorFeed(const Config& config);
+    ~SpectatorFeed();  // Deja el archivo: los espectadores ven el ultimo estado
+    SpectatorFeed(const SpectatorFeed&) = delete;
+    SpectatorFeed& operator=(const SpectatorFeed&) = delete;
+
+    bool isOpen() const { return header != nullptr; }
+    const std::string& getPath() const { return config.path; }
+
+    void beginGame(std::uint64_t id, int rows, int cols, int k);
+    void recordMove(std::uint64_t id, int cell);
+    void endGame(std::uint64_t id, char winner);
+    void closeGame(std::uint64_t id);  // La partida deja de verse
+
+    Stats getStats() const { return stats; }
+
+    // Bytes del archivo para una capacidad y un numero de partidas
+    static std::size_t fileBytes(std::uint32_t capacity, std::uint32_t maxGames);
+
+private:
+    Config config;
+    int fd = -1;
+    void* map = nullptr;
+    std::size_t mapBytes = 0;
+    Header* header = nullptr;
+    Record* ring = nullptr;
+    Snapshot* games = nullptr;
+    std::uint64_t sequence = 0;  // Ultimo registro publicado
+    std::unordered_map<std::uint64_t, std::uint32_t> slots;  // Id de partida -> casilla
+    std::vector<std::uint32_t> freeSlots;
+    Stats stats;
+
+    int findSlot(std::uint64_t id) const;  // -1 si la partida no se transmite
+    std::uint32_t takeSlot();              // maxGames si no hay ninguna
+    void publish(EventType type, std::uint64_t id, int a, int b, int c);
+};
+
+// ESPECTADOR: reconstruye los tableros leyendo el archivo de un
+// SpectatorFeed (solo lectura). poll() nunca bloquea a quien publica:
+// aplica los registros nuevos y, si el anillo ya dio la vuelta sobre lo
+// que faltaba leer, vuelve a empezar desde las fotos.
+class SpectatorView {
+public:
+    struct Board {
+        std::uint64_t id = 0;
+        int rows = 0;
+        int cols = 0;
+        int k = 0;
+        bool ended = false;
+        char winner = ' ';
+        std::vector<unsigned char> moves;  // Casillas en orden; X empieza
+        std::string cells;                 // rows*cols: 'X', 'O' o ' '
+        std::uint64_t lastSequence = 0;    // Ultimo registro aplicado
+    };
+
+    struct Stats {
+        long long records = 0;   // Registros aplicados
+        long long resyncs = 0;   // Veces que hubo que leer las fotos
+        long long overruns = 0;  // ... porque el anillo dio la vuelta sobre lo que faltaba leer
+    };
+
+    explicit SpectatorView(const std::string& path = SpectatorFeed::DEFAULT_PATH);
+    ~SpectatorView();
+    SpectatorView(const SpectatorView&) = delete;
+    SpectatorView& operator=(const SpectatorView&) = delete;
+
+    bool isOpen() const { return header != nullptr; }
+
+    // Aplica lo publicado desde la llamada anterior (y abre o vuelve a abrir
+    // el archivo si hace falta). Devuelve los ids de las partidas que
+    // cambiaron; las cerradas ya no estan en getBoards()
+    std::vector<std::uint64_t> poll();
+
+    // Partidas visibles por id
+    const std::unordered_map<std::uint64_t, Board>& getBoards() const { return boards; }
+    Stats getStats() const { return stats; }
+
+private:
+    void* map = nullptr;
+    std::size_t mapBytes = 0;
+    const SpectatorFeed::Header* header = nullptr;
+    const SpectatorFeed::Record* ring = nullptr;
+    const SpectatorFeed::Snapshot* games = nullptr;
+    std::uint32_t capacity = 0;
+    std::uint32_t maxGames = 0;
+    std::uint64_t nextSequence = 1;
+    bool staleSnapshots = false;  // Falta leer las fotos (o alguna quedo a medias)
+    std::string path;
+    unsigned long inode = 0;  // Para notar que quien publica abrio un archivo nuevo
+    std::unordered_map<std::uint64_t, Board> boards;
+    Stats stats;
+
+    bool open();
+    void close();
+    bool resync(std::vector<std::uint64_t>& changed);  // false si alguna foto quedo a medias
+    // false si la jugada no sigue a la anterior (hay que resincronizar)
+    bool apply(std::uint64_t sequence, std::uint64_t id, std::uint64_t payload,
+               std::vector<std::uint64_t>& changed);
+};
+
+#endif
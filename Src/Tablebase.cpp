@@ -0,0 +1,393 @@
+#include "Tablebase.h"
+#include "Logger.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char TABLE_MAGIC[4] = {'T', 'K', 'T', 'B'};
+const std::uint32_t TABLE_VERSION = 1;
+const std::size_t HEADER_BYTES = 4096;
+const std::uint64_t POSITIONS_PER_TASK = 4096;
+
+// Coeficientes binomiales C(n, k) para n, k <= 32
+constexpr std::array<std::array<std::uint64_t, 33>, 33> buildBinomials() {
+    std::array<std::array<std::uint64_t, 33>, 33> table{};
+    for (int n = 0; n <= 32; n++) {
+        table[n][0] = 1;
+        for (int k = 1; k <= n; k++) {
+            table[n][k] = table[n - 1][k - 1] + (k <= n - 1 ? table[n - 1][k] : 0);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<std::uint64_t, 33>, 33> BINOMIAL = buildBinomials();
+
+// Posiciones con n jugadas y primer indice de cada grupo
+template <int Cells>
+struct LayerTables {
+    std::array<std::uint64_t, Cells + 2> offset{};
+    std::array<std::uint64_t, Cells + 1> oPositions{};  // C(casillas - x, o): ancho del rango de O
+
+    static constexpr LayerTables build() {
+        LayerTables t{};
+        for (int n = 0; n <= Cells; n++) {
+            int x = (n + 1) / 2, o = n / 2;
+            t.oPositions[n] = BINOMIAL[Cells - x][o];
+            t.offset[n + 1] = t.offset[n] + BINOMIAL[Cells][x] * t.oPositions[n];
+        }
+        return t;
+    }
+};
+
+// Rango colex de los bits de 'bits' (el i-esimo bit, desde 1, en la posicion c aporta C(c, i))
+std::uint64_t rankSet(std::uint32_t bits) {
+    std::uint64_t rank = 0;
+    for (int i = 1; bits; i++) {
+        int c = __builtin_ctz(bits);
+        rank += BINOMIAL[c][i];
+        bits &= bits - 1;
+    }
+    return rank;
+}
+
+std::uint32_t unrankSet(std::uint64_t rank, int count, int size) {
+    std::uint32_t bits = 0;
+    int c = size - 1;
+    for (int i = count; i >= 1; i--) {
+        while (BINOMIAL[c][i] > rank) c--;
+        bits |= std::uint32_t(1) << c;
+        rank -= BINOMIAL[c][i];
+        c--;
+    }
+    return bits;
+}
+
+// Bits de 'bits' que caen en casillas libres, renumerados entre las libres
+std::uint32_t compress(std::uint32_t bits, std::uint32_t freeCells) {
+    std::uint32_t result = 0;
+    for (int j = 0; freeCells; j++) {
+        int c = __builtin_ctz(freeCells);
+        if ((bits >> c) & 1) result |= std::uint32_t(1) << j;
+        freeCells &= freeCells - 1;
+    }
+    return result;
+}
+
+std::uint32_t expand(std::uint32_t bits, std::uint32_t freeCells) {
+    std::uint32_t result = 0;
+    for (int j = 0; freeCells; j++) {
+        int c = __builtin_ctz(freeCells);
+        if ((bits >> j) & 1) result |= std::uint32_t(1) << c;
+        freeCells &= freeCells - 1;
+    }
+    return result;
+}
+
+// 2 bits por posicion dentro de palabras de 64 bits: 32 posiciones por palabra
+inline int loadValue(const std::uint64_t* words, std::uint64_t index) {
+    std::uint64_t word = __atomic_load_n(&words[index >> 5], __ATOMIC_RELAXED);
+    return static_cast<int>((word >> ((index & 31) * 2)) & 3);
+}
+
+}
+
+template <int Rows, int Cols, int K>
+struct Tablebase<Rows, Cols, K>::Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t k;
+    std::uint32_t reserved;
+    std::uint64_t positions;
+    std::uint64_t reachable;
+};
+
+template <int Rows, int Cols, int K>
+std::uint64_t Tablebase<Rows, Cols, K>::positionCount() {
+    static constexpr LayerTables<CELLS> LAYERS = LayerTables<CELLS>::build();
+    return LAYERS.offset[CELLS + 1];
+}
+
+template <int Rows, int Cols, int K>
+std::uint64_t Tablebase<Rows, Cols, K>::rank(const BoardType& board) {
+    static constexpr LayerTables<CELLS> LAYERS = LayerTables<CELLS>::build();
+    const std::uint32_t x = static_cast<std::uint32_t>(board.bits(0).words[0]);
+    const std::uint32_t o = static_cast<std::uint32_t>(board.bits(1).words[0]);
+    const int n = __builtin_popcount(x) + __builtin_popcount(o);
+    const std::uint32_t freeCells = ~x & static_cast<std::uint32_t>(BoardType::TABLES.fullMask.words[0]);
+    return LAYERS.offset[n] + rankSet(x) * LAYERS.oPositions[n] + rankSet(compress(o, freeCells));
+}
+
+template <int Rows, int Cols, int K>
+typename Tablebase<Rows, Cols, K>::BoardType Tablebase<Rows, Cols, K>::unrank(std::uint64_t index) {
+    static constexpr LayerTables<CELLS> LAYERS = LayerTables<CELLS>::build();
+    int n = 0;
+    while (LAYERS.offset[n + 1] <= index) n++;
+    index -= LAYERS.offset[n];
+    const int x = (n + 1) / 2, o = n / 2;
+
+    const std::uint32_t xBits = unrankSet(index / LAYERS.oPositions[n], x, CELLS);
+    const std::uint32_t freeCells = ~xBits & static_cast<std::uint32_t>(BoardType::TABLES.fullMask.words[0]);
+    const std::uint32_t oBits = expand(unrankSet(index % LAYERS.oPositions[n], o, CELLS - x), freeCells);
+
+    BoardType board;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if ((xBits >> cell) & 1) board.play(cell, 0);
+        if ((oBits >> cell) & 1) board.play(cell, 1);
+    }
+    return board;
+}
+
+template <int Rows, int Cols, int K>
+bool Tablebase<Rows, Cols, K>::build(const std::string& path, int threads, BuildStats& stats) {
+    static constexpr LayerTables<CELLS> LAYERS = LayerTables<CELLS>::build();
+    auto start = std::chrono::steady_clock::now();
+    stats = BuildStats();
+    stats.positions = positionCount();
+    threads = std::max(1, threads);
+
+    // La tabla se arma directamente dentro del archivo proyectado
+    const std::size_t words = static_cast<std::size_t>((stats.positions + 31) / 32);
+    const std::size_t fileBytes = HEADER_BYTES + words * sizeof(std::uint64_t);
+    const std::string tempPath = path + ".tmp";
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+    int out = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0 || ftruncate(out, static_cast<off_t>(fileBytes)) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo crear " << tempPath << ": " << std::strerror(errno));
+        if (out >= 0) ::close(out);
+        return false;
+    }
+    void* mapped = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0);
+    if (mapped == MAP_FAILED) {
+        TRIKI_ERROR(LOG_IO, "No se pudo proyectar " << tempPath << ": " << std::strerror(errno));
+        ::close(out);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    unsigned char* base = static_cast<unsigned char*>(mapped);
+    std::uint64_t* table = reinterpret_cast<std::uint64_t*>(base + HEADER_BYTES);
+
+    // Ejecuta 'visit' sobre cada posicion del grupo n, repartidas entre los hilos
+    auto forLayer = [&](int n, auto&& visit) {
+        std::atomic<std::uint64_t> next{LAYERS.offset[n]};
+        auto worker = [&]() {
+            while (true) {
+                std::uint64_t first = next.fetch_add(POSITIONS_PER_TASK, std::memory_order_relaxed);
+                if (first >= LAYERS.offset[n + 1]) break;
+                std::uint64_t last = std::min(first + POSITIONS_PER_TASK, LAYERS.offset[n + 1]);
+                for (std::uint64_t index = first; index < last; index++) {
+                    visit(index);
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; i++) pool.emplace_back(worker);
+        worker();
+        for (auto& thread : pool) thread.join();
+    };
+
+    // 1. ALCANZABLES: marca provisoria DRAW (10) sobre las hijas de cada
+    //    posicion alcanzable sin ganador
+    __atomic_fetch_or(&table[0], std::uint64_t(DRAW), __ATOMIC_RELAXED);  // Tablero vacio
+    for (int n = 0; n < CELLS; n++) {
+        const int player = n & 1;
+        forLayer(n, [&](std::uint64_t index) {
+            if (loadValue(table, index) == INVALID) return;
+            BoardType board = unrank(index);
+            if (board.hasLine(player ^ 1)) return;  // La partida ya termino
+            for (int cell = 0; cell < CELLS; cell++) {
+                if (!board.isEmpty(cell)) continue;
+                board.play(cell, player);
+                std::uint64_t child = rank(board);
+                board.unplay(cell, player);
+                __atomic_fetch_or(&table[child >> 5], std::uint64_t(DRAW) << ((child & 31) * 2),
+                                  __ATOMIC_RELAXED);
+            }
+        });
+    }
+
+    // 2. RETROGRADO: del tablero lleno hacia el vacio
+    std::atomic<std::uint64_t> counts[4] = {};
+    for (int n = CELLS; n >= 0; n--) {
+        const int player = n & 1;
+        forLayer(n, [&](std::uint64_t index) {
+            if (loadValue(table, index) == INVALID) return;
+            BoardType board = unrank(index);
+            int result;
+            if (board.hasLine(player ^ 1)) {
+                result = LOSS;  // El rival acaba de completar una linea
+            } else if (n == CELLS) {
+                result = DRAW;
+            } else {
+                bool anyDraw = false;
+                result = LOSS;
+                for (int cell = 0; cell < CELLS && result != WIN; cell++) {
+                    if (!board.isEmpty(cell)) continue;
+                    board.play(cell, player);
+                    int child = loadValue(table, rank(board));
+                    board.unplay(cell, player);
+                    if (child == LOSS) result = WIN;
+                    else if (child == DRAW) anyDraw = true;
+                }
+                if (result != WIN && anyDraw) result = DRAW;
+            }
+            // La marca provisoria es DRAW: un XOR la cambia por el valor final
+            __atomic_fetch_xor(&table[index >> 5], std::uint64_t(DRAW ^ result) << ((index & 31) * 2),
+                               __ATOMIC_RELAXED);
+            counts[result].fetch_add(1, std::memory_order_relaxed);
+        });
+        TRIKI_DEBUG(LOG_GAME, "Tabla " << Rows << "x" << Cols << ": " << n << " jugadas resueltas ("
+                    << LAYERS.offset[n + 1] - LAYERS.offset[n] << " posiciones)");
+    }
+    stats.wins = counts[WIN];
+    stats.draws = counts[DRAW];
+    stats.losses = counts[LOSS];
+    stats.reachable = stats.wins + stats.draws + stats.losses;
+
+    // La cabecera va al final: un archivo a medias nunca parece valido
+    Header header{};
+    std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    header.version = TABLE_VERSION;
+    header.rows = Rows;
+    header.cols = Cols;
+    header.k = K;
+    header.positions = stats.positions;
+    header.reachable = stats.reachable;
+    std::memcpy(base, &header, sizeof(header));
+
+    bool ok = msync(mapped, fileBytes, MS_SYNC) == 0;
+    munmap(mapped, fileBytes);
+    ok = fsync(out) == 0 && ok;
+    ::close(out);
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+        TRIKI_ERROR(LOG_IO, "No se pudo escribir " << path << ": " << std::strerror(errno));
+        unlink(tempPath.c_str());
+        return false;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TRIKI_INFO(LOG_IO, "Tabla de finales escrita: " << path << " (" << fileBytes << " bytes)");
+    return true;
+}
+
+template <int Rows, int Cols, int K>
+std::unique_ptr<Tablebase<Rows, Cols, K>> Tablebase<Rows, Cols, K>::open(const std::string& path) {
+    std::unique_ptr<Tablebase> table(new Tablebase());
+    table->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (table->fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    const std::size_t expected = HEADER_BYTES + static_cast<std::size_t>((positionCount() + 31) / 32) * 8;
+    if (fstat(table->fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != expected) {
+        TRIKI_WARNING(LOG_IO, "Tabla de finales con tamaño inesperado: " << path);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, expected, PROT_READ, MAP_SHARED, table->fd, 0);
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+    table->map = static_cast<const unsigned char*>(mapped);
+    table->mapBytes = expected;
+    // Consultas sueltas: sin lectura anticipada, solo la pagina de cada posicion
+    madvise(mapped, expected, MADV_RANDOM);
+
+    Header header;
+    std::memcpy(&header, table->map, sizeof(header));
+    if (std::memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 || header.version != TABLE_VERSION ||
+        header.rows != Rows || header.cols != Cols || header.k != K || header.positions != positionCount()) {
+        TRIKI_WARNING(LOG_IO, "Tabla de finales invalida o de otro tablero: " << path);
+        return nullptr;
+    }
+    table->values = reinterpret_cast<const std::uint64_t*>(table->map + HEADER_BYTES);
+    table->reachable = header.reachable;
+    TRIKI_DEBUG(LOG_IO, "Tabla de finales abierta: " << path << " (" << header.reachable << " posiciones)");
+    return table;
+}
+
+template <int Rows, int Cols, int K>
+std::string Tablebase<Rows, Cols, K>::defaultPath() {
+    return "tablas/" + std::to_string(Rows) + "x" + std::to_string(Cols) + "k" + std::to_string(K) + ".tkb";
+}
+
+template <int Rows, int Cols, int K>
+const Tablebase<Rows, Cols, K>* Tablebase<Rows, Cols, K>::shared() {
+    static std::unique_ptr<Tablebase> instance = open(defaultPath());
+    return instance.get();
+}
+
+template <int Rows, int Cols, int K>
+Tablebase<Rows, Cols, K>::~Tablebase() {
+    if (map) munmap(const_cast<unsigned char*>(map), mapBytes);
+    if (fd >= 0) ::close(fd);
+}
+
+template <int Rows, int Cols, int K>
+typename Tablebase<Rows, Cols, K>::Value Tablebase<Rows, Cols, K>::valueAt(std::uint64_t index) const {
+    return static_cast<Value>(loadValue(values, index));
+}
+
+template <int Rows, int Cols, int K>
+typename Tablebase<Rows, Cols, K>::Value Tablebase<Rows, Cols, K>::value(const BoardType& board) const {
+    // X empieza: tiene las mismas fichas que O o una mas
+    const int x = board.bits(0).count(), o = board.bits(1).count();
+    if (x != o && x != o + 1) {
+        return INVALID;
+    }
+    return valueAt(rank(board));
+}
+
+template <int Rows, int Cols, int K>
+int Tablebase<Rows, Cols, K>::bestMove(const BoardType& board) const {
+    const Value current = value(board);
+    if (current == INVALID || board.hasLine(0) || board.hasLine(1) || board.isFull()) {
+        return -1;
+    }
+    // La mejor hija es la peor para el rival: LOSS, luego DRAW, luego WIN
+    const int player = board.moveCount() & 1;
+    BoardType work = board;
+    int best = -1, bestValue = 0;
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (!work.isEmpty(cell)) continue;
+        work.play(cell, player);
+        int child = valueAt(rank(work));
+        work.unplay(cell, player);
+        if (child > bestValue) {
+            bestValue = child;
+            best = cell;
+            if (child == LOSS) break;
+        }
+    }
+    return best;
+}
+
+template <int Rows, int Cols, int K>
+std::uint64_t Tablebase<Rows, Cols, K>::getPositionCount() const {
+    return positionCount();
+}
+
+template <int Rows, int Cols, int K>
+std::uint64_t Tablebase<Rows, Cols, K>::getReachableCount() const {
+    return reachable;
+}
+
+// INSTANCIACION EXPLICITA - variantes sin tabla en compilacion
+template class Tablebase<4, 4, 4>;
+template class Tablebase<5, 5, 4>;
@@ -0,0 +1,88 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Board.h"
+
+// TABLA DE FINALES (TABLEBASE) PARA TABLEROS MEDIANOS
+// Valor con juego perfecto (gana / empata / pierde quien mueve) de todas las
+// posiciones alcanzables, 2 bits por posicion. Se construye una sola vez
+// ("triki tablebase 4x4") y se consulta con mmap: el sistema solo lee del
+// disco las paginas que se tocan, asi que abrir una tabla de varios GB es
+// instantaneo.
+//
+// INDICE (hash perfecto): las posiciones se agrupan por numero de jugadas n
+// (X tiene ceil(n/2) fichas y O floor(n/2)). Dentro de un grupo el indice es
+//   rango(fichas de X) * C(casillas - x, o) + rango(fichas de O entre las libres)
+// con el rango de cada conjunto en el sistema combinatorio (colex), sin huecos.
+// 4x4: 10 millones de posiciones, 2,5 MB.
+//
+// CONSTRUCCION RETROGRADA, en paralelo por grupos:
+//   1. Hacia adelante, desde el tablero vacio: se marcan las posiciones
+//      alcanzables (las hijas de una posicion sin ganador).
+//   2. Hacia atras, desde el tablero lleno: cada posicion se decide con sus
+//      hijas, que ya estan resueltas porque tienen una jugada mas.
+// Dentro de un grupo las posiciones no dependen entre si y se reparten entre
+// los hilos; los bits se escriben con operaciones atomicas sobre la tabla.
+//
+// ARCHIVO: cabecera de 4 KB y los valores, 4 por byte (enteros en el orden
+// de la maquina). Las posiciones no alcanzables quedan en 0.
+template <int Rows, int Cols, int K>
+class Tablebase {
+public:
+    using BoardType = Board<Rows, Cols, K>;
+    static constexpr int CELLS = BoardType::CELLS;
+    static_assert(CELLS <= 32, "La tabla de finales solo admite tableros de hasta 32 casillas");
+
+    // Valor para el jugador al que le toca mover (mismos codigos que PerfectTable)
+    enum Value { INVALID = 0, WIN = 1, DRAW = 2, LOSS = 3 };
+
+    struct BuildStats {
+        std::uint64_t positions = 0;  // Tamaño del indice
+        std::uint64_t reachable = 0;
+        std::uint64_t wins = 0;
+        std::uint64_t draws = 0;
+        std::uint64_t losses = 0;
+        double seconds = 0.0;
+    };
+
+    // Construye la tabla en 'path' (primero en un temporal que se renombra al final)
+    static bool build(const std::string& path, int threads, BuildStats& stats);
+
+    static std::unique_ptr<Tablebase> open(const std::string& path);  // nullptr si no es valida
+    static std::string defaultPath();  // tablas/<filas>x<columnas>k<k>.tkb
+
+    // Tabla de defaultPath(), abierta al primer uso; nullptr si no existe
+    static const Tablebase* shared();
+
+    ~Tablebase();
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+
+    Value value(const BoardType& board) const;  // INVALID si no es alcanzable
+    int bestMove(const BoardType& board) const;  // -1 si la partida termino
+    std::uint64_t getPositionCount() const;
+    std::uint64_t getReachableCount() const;
+
+    static std::uint64_t positionCount();
+    // Sin validar: el numero de fichas de cada jugador debe corresponder a las jugadas
+    static std::uint64_t rank(const BoardType& board);
+    static BoardType unrank(std::uint64_t index);
+
+private:
+    struct Header;
+
+    int fd = -1;
+    const unsigned char* map = nullptr;
+    std::size_t mapBytes = 0;
+    const std::uint64_t* values = nullptr;  // 32 posiciones por palabra
+    std::uint64_t reachable = 0;
+
+    Tablebase() = default;
+    Value valueAt(std::uint64_t index) const;
+};
+
+#endif
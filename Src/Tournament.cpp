@@ -0,0 +1,257 @@
+#include "Tournament.h"
+#include "Game.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Players.h"
+#include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Tiempo por jugada de un jugador en un hilo (se suman al final)
+struct MoveTimes {
+    Metrics::Histogram histogram;
+
+    void record(std::uint64_t nanos) {
+        histogram.buckets[Metrics::bucketIndex(nanos)]++;
+        histogram.count++;
+        histogram.sumNanos += nanos;
+        histogram.maxNanos = std::max(histogram.maxNanos, nanos);
+    }
+
+    void merge(const MoveTimes& other) {
+        for (int b = 0; b < Metrics::BUCKETS; b++) {
+            histogram.buckets[b] += other.histogram.buckets[b];
+        }
+        histogram.count += other.histogram.count;
+        histogram.sumNanos += other.histogram.sumNanos;
+        histogram.maxNanos = std::max(histogram.maxNanos, other.histogram.maxNanos);
+    }
+};
+
+// Apertura: 'plies' casillas libres al azar. Con menos de 5 jugadas nadie
+// puede haber ganado todavia.
+std::vector<int> randomOpening(int plies, std::uint64_t& rng) {
+    std::vector<int> cells = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int> opening;
+    for (int i = 0; i < plies; i++) {
+        int pick = i + static_cast<int>(nextRandom(rng) % (9 - i));
+        std::swap(cells[i], cells[pick]);
+        opening.push_back(cells[i]);
+    }
+    return opening;
+}
+
+// Una partida completa con Game; devuelve el ganador ('X', 'O' o ' ')
+char playGame(Game& game, MovePolicy* policies[2], MoveTimes* times[2], const std::vector<int>& opening,
+              std::uint64_t& rng) {
+    game.resetGame();
+    for (int cell : opening) {
+        game.playTurn(cell / 3, cell % 3);
+    }
+    while (!game.isGameEnded()) {
+        int player = playerIndex(game.getCurrentPlayer());
+        std::uint64_t start = Metrics::now();
+        int cell = policies[player]->chooseMove(game.getBoard(), player, rng);
+        times[player]->record(Metrics::now() - start);
+        game.playTurn(cell / 3, cell % 3);
+    }
+    return game.getWinner();
+}
+
+// Puntos esperados con una diferencia de Elo 'diff' a favor
+double expectedScore(double diff) {
+    return 1.0 / (1.0 + std::pow(10.0, -diff / 400.0));
+}
+
+// Diferencia de Elo que corresponde a una fraccion de puntos
+double eloFromScore(double score) {
+    score = std::min(0.999, std::max(0.001, score));
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+}
+
+bool runTournament(const TournamentConfig& config, TournamentStats& stats) {
+    const int playerCount = static_cast<int>(config.players.size());
+    if (playerCount < 2) {
+        TRIKI_ERROR(LOG_GAME, "El torneo necesita al menos dos jugadores");
+        return false;
+    }
+    for (const auto& spec : config.players) {
+        if (!createPolicy(spec)) {
+            TRIKI_ERROR(LOG_GAME, "Jugador desconocido: " << spec
+                        << " (usa random, solver o mcts:<simulaciones>)");
+            return false;
+        }
+    }
+
+    stats = TournamentStats();
+    for (int i = 0; i < playerCount; i++) {
+        for (int j = i + 1; j < playerCount; j++) {
+            if (config.gauntlet && i > 0) break;
+            TournamentMatchStats match;
+            match.first = i;
+            match.second = j;
+            stats.matches.push_back(match);
+        }
+    }
+
+    const int pairs = std::max(1, config.pairsPerMatch);
+    const int plies = std::min(4, std::max(0, config.openingPlies));
+    const int threads = std::max(1, config.threads);
+    const long long units = static_cast<long long>(stats.matches.size()) * pairs;
+
+    // Resultado de cada partida visto desde 'first': 1 gana, 0 empate, -1 pierde.
+    // Cada par escribe en su lugar, asi el orden de los hilos no importa.
+    std::vector<signed char> outcomes(static_cast<std::size_t>(units) * 2, 0);
+    std::vector<std::vector<MoveTimes>> times(threads, std::vector<MoveTimes>(playerCount));
+    std::atomic<long long> nextUnit{0};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            // Jugadores propios del hilo (MovePolicy no es segura entre hilos)
+            std::vector<std::unique_ptr<MovePolicy>> policies;
+            for (const auto& spec : config.players) {
+                policies.push_back(createPolicy(spec));
+            }
+            Game game;
+            for (long long unit = nextUnit.fetch_add(1); unit < units; unit = nextUnit.fetch_add(1)) {
+                const TournamentMatchStats& match = stats.matches[unit / pairs];
+                std::uint64_t pairSeed = mixSeed(mixSeed(config.seed, unit / pairs), unit % pairs);
+                std::uint64_t openingRng = pairSeed;
+                std::vector<int> opening = randomOpening(plies, openingRng);
+
+                // Misma apertura dos veces: 'first' con X y luego con O
+                for (int swap = 0; swap < 2; swap++) {
+                    int xPlayer = swap ? match.second : match.first;
+                    int oPlayer = swap ? match.first : match.second;
+                    MovePolicy* sides[2] = {policies[xPlayer].get(), policies[oPlayer].get()};
+                    MoveTimes* sideTimes[2] = {&times[t][xPlayer], &times[t][oPlayer]};
+                    std::uint64_t rng = mixSeed(pairSeed, 1 + swap);
+                    char winner = playGame(game, sides, sideTimes, opening, rng);
+
+                    signed char outcome = 0;
+                    if (winner != ' ') {
+                        bool firstWon = (winner == 'X') == (swap == 0);
+                        outcome = firstWon ? 1 : -1;
+                    }
+                    outcomes[static_cast<std::size_t>(unit) * 2 + swap] = outcome;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    stats.players.resize(playerCount);
+    for (int i = 0; i < playerCount; i++) {
+        stats.players[i].name = config.players[i];
+    }
+    for (long long unit = 0; unit < units; unit++) {
+        TournamentMatchStats& match = stats.matches[unit / pairs];
+        TournamentPlayerStats& first = stats.players[match.first];
+        TournamentPlayerStats& second = stats.players[match.second];
+        for (int swap = 0; swap < 2; swap++) {
+            signed char outcome = outcomes[static_cast<std::size_t>(unit) * 2 + swap];
+            if (outcome > 0) {
+                match.wins++;
+                first.wins++;
+                second.losses++;
+            } else if (outcome < 0) {
+                match.losses++;
+                first.losses++;
+                second.wins++;
+            } else {
+                match.draws++;
+                first.draws++;
+                second.draws++;
+            }
+            first.games++;
+            second.games++;
+            stats.games++;
+        }
+    }
+
+    for (int i = 0; i < playerCount; i++) {
+        MoveTimes total;
+        for (int t = 0; t < threads; t++) {
+            total.merge(times[t][i]);
+        }
+        const Metrics::Histogram& histogram = total.histogram;
+        TournamentPlayerStats& player = stats.players[i];
+        player.moves = static_cast<long long>(histogram.count);
+        player.meanMoveMicros = histogram.meanNanos() / 1000.0;
+        player.p50MoveMicros = histogram.percentile(0.50) / 1000.0;
+        player.p99MoveMicros = histogram.percentile(0.99) / 1000.0;
+        player.maxMoveMicros = histogram.maxNanos / 1000.0;
+    }
+
+    computeElo(stats);
+    return true;
+}
+
+void computeElo(TournamentStats& stats) {
+    const int playerCount = static_cast<int>(stats.players.size());
+    if (playerCount == 0) {
+        return;
+    }
+    std::vector<double> rating(playerCount, 0.0);
+
+    // Newton sobre la verosimilitud de cada jugador con los demas fijos. Un
+    // empate virtual contra un rival de Elo 0 evita que un jugador invicto
+    // (o sin ningun punto) se vaya al infinito.
+    const double slope = std::log(10.0) / 400.0;
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        double largestStep = 0.0;
+        for (int i = 0; i < playerCount; i++) {
+            double expected = expectedScore(rating[i]);
+            double score = 0.5;
+            double curvature = expected * (1.0 - expected) * slope;
+            for (const auto& match : stats.matches) {
+                if (match.first != i && match.second != i) continue;
+                bool isFirst = match.first == i;
+                double games = static_cast<double>(match.wins + match.draws + match.losses);
+                double points = (isFirst ? match.wins : match.losses) + 0.5 * match.draws;
+                double p = expectedScore(rating[i] - rating[isFirst ? match.second : match.first]);
+                score += points;
+                expected += games * p;
+                curvature += games * p * (1.0 - p) * slope;
+            }
+            double step = std::max(-400.0, std::min(400.0, (score - expected) / curvature));
+            rating[i] += step;
+            largestStep = std::max(largestStep, std::fabs(step));
+        }
+        if (largestStep < 1e-6) {
+            break;
+        }
+    }
+
+    double mean = 0.0;
+    for (double r : rating) mean += r;
+    mean /= playerCount;
+
+    for (int i = 0; i < playerCount; i++) {
+        TournamentPlayerStats& player = stats.players[i];
+        player.elo = rating[i] - mean;
+
+        // Error estandar de la fraccion de puntos (con el empate virtual)
+        // llevado a Elo en los dos extremos del intervalo
+        double games = static_cast<double>(player.games) + 1.0;
+        double score = (player.wins + 0.5 * (player.draws + 1)) / games;
+        double variance = (player.wins * (1.0 - score) * (1.0 - score) +
+                           (player.draws + 1) * (0.5 - score) * (0.5 - score) +
+                           player.losses * score * score) / games;
+        double error = 1.96 * std::sqrt(variance / games);
+        player.eloMargin = (eloFromScore(score + error) - eloFromScore(score - error)) / 2.0;
+    }
+}
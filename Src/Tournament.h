@@ -0,0 +1,70 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// TORNEO ENTRE JUGADORES AUTOMATICOS CON ELO (triki 3x3)
+// Todos contra todos, o el primer jugador contra cada uno de los demas
+// (gauntlet). Cada emparejamiento juega 'pairsPerMatch' pares de partidas:
+// una apertura al azar de 'openingPlies' jugadas y luego la misma apertura
+// con los colores cambiados, asi ningun jugador sale favorecido por empezar.
+//
+// Las partidas se juegan con Game (playTurn) en un numero fijo de hilos que
+// toman pares de un contador compartido, cada hilo con sus propios
+// jugadores. La semilla de cada emparejamiento sale de la semilla del
+// torneo y la de cada par de la del emparejamiento: el resultado es el mismo
+// con cualquier numero de hilos.
+struct TournamentConfig {
+    std::vector<std::string> players;  // Ver createPolicy() en Players.h
+    bool gauntlet = false;             // false: todos contra todos
+    int pairsPerMatch = 50;            // Cada par son dos partidas
+    int openingPlies = 2;              // Jugadas al azar antes de que jueguen (0..4)
+    int threads = 1;
+    std::uint64_t seed = 12345;
+};
+
+struct TournamentPlayerStats {
+    std::string name;
+    long long games = 0;
+    long long wins = 0;
+    long long draws = 0;
+    long long losses = 0;
+    double elo = 0.0;          // Promedio de todos los jugadores = 0
+    double eloMargin = 0.0;    // Intervalo de confianza del 95%: elo +- eloMargin
+    long long moves = 0;
+    double meanMoveMicros = 0.0;
+    double p50MoveMicros = 0.0;
+    double p99MoveMicros = 0.0;
+    double maxMoveMicros = 0.0;
+
+    double score() const { return games > 0 ? (wins + 0.5 * draws) / games : 0.0; }
+};
+
+// Resultado de un emparejamiento, visto desde 'first'
+struct TournamentMatchStats {
+    int first = 0;
+    int second = 0;
+    long long wins = 0;
+    long long draws = 0;
+    long long losses = 0;
+};
+
+struct TournamentStats {
+    std::vector<TournamentPlayerStats> players;
+    std::vector<TournamentMatchStats> matches;
+    long long games = 0;
+    double seconds = 0.0;
+
+    double gamesPerSecond() const { return seconds > 0.0 ? games / seconds : 0.0; }
+};
+
+// Devuelve false si hay menos de dos jugadores o alguno no es valido
+bool runTournament(const TournamentConfig& config, TournamentStats& stats);
+
+// Elo por maxima verosimilitud (los empates valen medio punto) a partir de
+// los emparejamientos; completa elo y eloMargin de cada jugador
+void computeElo(TournamentStats& stats);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+// CLAVES DE ZOBRIST - un numero aleatorio de 64 bits por (jugador, casilla)
+// y otro para el turno de 'O'. El hash de una posicion es el XOR de las
+// claves de sus fichas, asi que poner o quitar una ficha cuesta un XOR.
+// La semilla es fija: los hashes son los mismos en cada ejecucion (se usan
+// como nombre de archivo en el guardado por contenido).
+template <int Cells>
+struct ZobristKeys {
+    std::array<std::array<std::uint64_t, Cells>, 2> cells{};
+    std::uint64_t sideToMove = 0;  // Se aplica cuando mueve 'O'
+
+    // splitmix64: suficiente para repartir bien los bits de cada clave
+    static constexpr std::uint64_t next(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr ZobristKeys build() {
+        ZobristKeys keys{};
+        std::uint64_t state = 0x7472696B69ULL + Cells;  // "triki" y el tamaño del tablero
+        for (int player = 0; player < 2; player++) {
+            for (int cell = 0; cell < Cells; cell++) {
+                keys.cells[player][cell] = next(state);
+            }
+        }
+        keys.sideToMove = next(state);
+        return keys;
+    }
+};
+
+template <int Cells>
+inline constexpr ZobristKeys<Cells> ZOBRIST = ZobristKeys<Cells>::build();
+
+#endif
@@ -1,24 +1,48 @@
 #include "Game.h"
+#include "Console.h"
 #include "FileManager.h"
+#include "Solver.h"
+#include "Random.h"
+#include "ParallelSolver.h"
+#include "Mcts.h"
+#include "SelfPlay.h"
+#include "Tournament.h"
+#include "GameServer.h"
+#include "LoadClient.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Journal.h"
+#include "SpectatorFeed.h"
+#include "BoardRenderer.h"
+#include "Analytics.h"
+#include "Tablebase.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <set>
 #include <string>
 #include <limits>
+#include <memory>
+#include <thread>
+#include <csignal>
 
 void showMainMenu() {
     std::cout << "\n=== TRIKI CON MANEJO DE MEMORIA Y ARCHIVOS ===\n";
     std::cout << "1. Nueva partida\n";
-    std::cout << "2. Cargar partida guardada\n";
-    std::cout << "3. Ver partidas disponibles\n";
-    std::cout << "4. Eliminar partida\n";
-    std::cout << "5. Informacion del sistema\n";
-    std::cout << "6. Salir\n";
+    std::cout << "2. Nueva partida contra la CPU\n";
+    std::cout << "3. Cargar partida guardada\n";
+    std::cout << "4. Ver partidas disponibles\n";
+    std::cout << "5. Eliminar partida\n";
+    std::cout << "6. Informacion del sistema\n";
+    std::cout << "7. Metricas\n";
+    std::cout << "8. Salir\n";
     std::cout << "Selecciona una opcion: ";
 }
 
-void showSavedGames() {
-    FileManager fileManager;
-    auto games = fileManager.listSavedGames();
-    
+void printSavedGames(const std::vector<std::string>& games) {
     std::cout << "\n=== PARTIDAS GUARDADAS ===\n";
     if (games.empty()) {
         std::cout << "No hay partidas guardadas.\n";
@@ -31,8 +55,11 @@ void showSavedGames() {
     std::cout << "=========================\n";
 }
 
-std::string selectSavedGame() {
-    FileManager fileManager;
+void showSavedGames(FileManager& fileManager) {
+    printSavedGames(fileManager.listSavedGames());
+}
+
+std::string selectSavedGame(FileManager& fileManager) {
     auto games = fileManager.listSavedGames();
     
     if (games.empty()) {
@@ -40,7 +67,7 @@ std::string selectSavedGame() {
         return "";
     }
     
-    showSavedGames();
+    printSavedGames(games);
     std::cout << "Selecciona el numero de partida (0 para cancelar): ";
     
     int choice;
@@ -54,13 +81,93 @@ std::string selectSavedGame() {
     return games[choice - 1];
 }
 
-void playNewGame() {
+// Diario de jugadas de la sesion interactiva (nullptr si no se pudo abrir)
+MoveJournal* activeJournal = nullptr;
+
+// Transmision para "triki espectador" (nullptr si no se pudo abrir)
+SpectatorFeed* activeFeed = nullptr;
+std::uint64_t lastSpectatorId = 0;
+
+// Transmite la partida tal como esta; devuelve su id (0 sin transmision)
+template <typename GameType>
+std::uint64_t publishGame(const GameType& game) {
+    if (!activeFeed) {
+        return 0;
+    }
+    using BoardType = typename GameType::BoardType;
+    std::uint64_t id = ++lastSpectatorId;
+    activeFeed->beginGame(id, BoardType::ROWS, BoardType::COLS, BoardType::WIN_LENGTH);
+    for (int i = 0; i < game.getMoveCount(); i++) {
+        activeFeed->recordMove(id, game.getMove(i));
+    }
+    if (game.isGameEnded()) {
+        activeFeed->endGame(id, game.getWinner());
+    }
+    return id;
+}
+
+template <typename GameType>
+void publishMove(std::uint64_t id, const GameType& game, int cell) {
+    if (!id) {
+        return;
+    }
+    activeFeed->recordMove(id, cell);
+    if (game.isGameEnded()) {
+        activeFeed->endGame(id, game.getWinner());
+    }
+}
+
+// Cada jugada queda en el diario, ya en disco, antes de pedir la siguiente
+// (si el programa se cae la partida se recupera al volver a abrirlo), y
+// sale al mismo tiempo para los espectadores
+void trackGame(Game& game) {
+    std::uint64_t spectatorId = publishGame(game);
+    std::uint64_t journalId = 0;
+    if (activeJournal && !game.isGameEnded()) {
+        journalId = activeJournal->newGameId();
+        activeJournal->beginGame(journalId);
+        for (int i = 0; i < game.getMoveCount(); i++) {
+            activeJournal->recordMove(journalId, game.getMove(i));
+        }
+    }
+    if (!journalId && !spectatorId) {
+        return;
+    }
+    game.setMoveListener([journalId, spectatorId](const Game& current, int cell) {
+        publishMove(spectatorId, current, cell);
+        if (!journalId) {
+            return;
+        }
+        std::uint64_t sequence = activeJournal->recordMove(journalId, cell);
+        if (current.isGameEnded()) {
+            sequence = activeJournal->endGame(journalId);
+        }
+        if (!activeJournal->waitDurable(sequence)) {
+            TRIKI_WARNING(LOG_IO, "La jugada no quedo en el diario: si el programa se cae no se recupera");
+        }
+    });
+}
+
+// Guarda con el FileManager del menu y muestra como quedo el directorio
+// (el menu tiene la depuracion activa)
+bool saveFromMenu(const Game& triki, FileManager& fileManager, const std::string& filename) {
+    if (!triki.saveGame(filename, fileManager)) {
+        return false;
+    }
+    if (Logger::isEnabled(LOG_DEBUG, LOG_IO)) {
+        showDirectoryInfo(fileManager);
+    }
+    return true;
+}
+
+void playNewGame(FileManager& fileManager) {
     Game triki;
+    trackGame(triki);
     char saveChoice;
     
     std::cout << "\n=== NUEVA PARTIDA ===\n";
-    triki.showMemoryInfo();
-    triki.playGame();
+    Console<Game>::showMemoryInfo(triki);
+    Console<Game>::playGame(triki);
     
     // Limpiar buffer ANTES de leer
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -77,7 +184,7 @@ void playNewGame() {
         std::cout << "Nombre del archivo (sin extension): ";
         std::getline(std::cin, filename);  // Usar getline en lugar de >>
         
-        if (triki.saveGame(filename)) {
+        if (saveFromMenu(triki, fileManager, filename)) {
             std::cout << "Partida guardada exitosamente!\n";
         } else {
             std::cout << "Error al guardar la partida.\n";
@@ -85,20 +192,97 @@ void playNewGame() {
     }
 }
 
-void loadAndPlayGame() {
-    std::string filename = selectSavedGame();
+// Triki 3x3 contra el solucionador exacto
+void playTrikiAgainstCpu(char cpuSymbol) {
+    Game triki;
+    Solver<3, 3, 3> solver;
+    trackGame(triki);
+    
+    // La CPU juega perfecto: busca la mejor jugada y reporta el rendimiento
+    Console<Game>::playGame(triki, [&solver](const Game& game) {
+        int cell = solver.bestMove(game);
+        const auto& stats = solver.getStats();
+        std::cout << "[CPU] Nodos: " << stats.nodes
+                  << ", aciertos en tabla: " << stats.tableHits
+                  << ", nodos/s: " << static_cast<long long>(stats.nodesPerSecond()) << "\n";
+        return cell;
+    }, cpuSymbol);
+}
+
+// Gomoku 15x15 contra MCTS con un presupuesto de tiempo por jugada
+void playGomokuAgainstCpu(char cpuSymbol) {
+    Gomoku gomoku;
+    MctsEngine<15, 15, 5>::Config config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    config.maxMillis = 2000;
+    config.expandVisits = 8;
+    MctsEngine<15, 15, 5> engine(config);
+    std::uint64_t spectatorId = publishGame(gomoku);
+    gomoku.setMoveListener([spectatorId](const Gomoku& current, int cell) {
+        publishMove(spectatorId, current, cell);
+    });
+    
+    // 15x15 es demasiado para redibujar completo en cada turno: en una
+    // terminal solo se escriben las casillas que cambian
+    auto renderer = createRenderer("auto");
+    Console<Gomoku>::playGame(gomoku, [&engine](const Gomoku& game) {
+        auto result = engine.search(game.getBoard(), playerIndex(game.getCurrentPlayer()));
+        std::cout << "[CPU] Simulaciones: " << result.playouts
+                  << " (" << static_cast<long long>(result.playoutsPerSecond()) << "/s)"
+                  << ", nodos: " << result.nodesUsed << "\n";
+        for (std::size_t i = 0; i < result.moves.size() && i < 3; i++) {
+            const auto& move = result.moves[i];
+            std::cout << "      " << move.move / 15 << " " << move.move % 15
+                      << ": " << move.visits << " visitas, "
+                      << static_cast<int>(move.winRate * 100) << "%\n";
+        }
+        return result.move;
+    }, cpuSymbol, *renderer);
+}
+
+void playAgainstCpu() {
+    int variant;
+    char humanSymbol;
+    
+    std::cout << "\n=== PARTIDA CONTRA LA CPU ===\n";
+    std::cout << "1. Triki 3x3 (juego perfecto)\n";
+    std::cout << "2. Gomoku 15x15 (Monte Carlo)\n";
+    std::cout << "Selecciona la variante: ";
+    std::cin >> variant;
+    std::cout << "Quieres jugar con X (empiezas) u O? ";
+    std::cin >> humanSymbol;
+    humanSymbol = (humanSymbol == 'o' || humanSymbol == 'O') ? 'O' : 'X';
+    char cpuSymbol = (humanSymbol == 'X') ? 'O' : 'X';
+    
+    if (variant == 2) {
+        playGomokuAgainstCpu(cpuSymbol);
+    } else {
+        playTrikiAgainstCpu(cpuSymbol);
+    }
+}
+
+void loadAndPlayGame(FileManager& fileManager) {
+    std::string filename = selectSavedGame(fileManager);
     if (filename.empty()) {
         return;
     }
     
     Game triki;
     
-    if (triki.loadGame(filename)) {
+    if (triki.loadGame(filename, fileManager)) {
+        Logger::flush();
+        Console<Game>::displayBoard(triki);
         std::cout << "\nPartida cargada. Continuando juego...\n";
         
         // Continuar solo si el juego no ha terminado
         if (!triki.isGameEnded()) {
-            triki.playGame();
+            char perfectWinner = triki.getPerfectPlayWinner();
+            std::cout << "Con juego perfecto desde aqui: "
+                      << (perfectWinner == ' ' ? std::string("Empate") :
+                          "gana " + std::string(1, perfectWinner)) << "\n";
+            
+            trackGame(triki);
+            Console<Game>::playGame(triki);
             
             // Ofrecer guardar de nuevo
             char saveChoice;
@@ -106,7 +290,7 @@ void loadAndPlayGame() {
             std::cin >> saveChoice;
             
             if (saveChoice == 's' || saveChoice == 'S') {
-                if (triki.saveGame(filename.substr(0, filename.find(".triki")))) {
+                if (saveFromMenu(triki, fileManager, filename.substr(0, filename.find(".triki")))) {
                     std::cout << "Progreso guardado!\n";
                 }
             }
@@ -118,8 +302,8 @@ void loadAndPlayGame() {
     }
 }
 
-void deleteGame() {
-    std::string filename = selectSavedGame();
+void deleteGame(FileManager& fileManager) {
+    std::string filename = selectSavedGame(fileManager);
     if (filename.empty()) {
         return;
     }
@@ -129,7 +313,6 @@ void deleteGame() {
     std::cin >> confirm;
     
     if (confirm == 's' || confirm == 'S') {
-        FileManager fileManager;
         if (fileManager.deleteGame(filename)) {
             std::cout << "Partida eliminada exitosamente.\n";
         }
@@ -138,9 +321,7 @@ void deleteGame() {
     }
 }
 
-void showSystemInfo() {
-    FileManager fileManager;
-    
+void showSystemInfo(FileManager& fileManager) {
     std::cout << "\n=== INFORMACION DEL SISTEMA ===\n";
     std::cout << "Demostrando conceptos de C++:\n";
     std::cout << "- Manejo dinamico de memoria (new/delete)\n";
@@ -150,14 +331,659 @@ void showSystemInfo() {
     std::cout << "- Gestion automatica de directorios\n";
     std::cout << "- Heap vs Stack memory\n\n";
     
-    fileManager.showDirectoryInfo();
+    showDirectoryInfo(fileManager);
     
     // Crear objeto temporal para mostrar info de memoria
     Game tempGame;
-    tempGame.showMemoryInfo();
+    Console<Game>::showMemoryInfo(tempGame);
+}
+
+// Numeros del registro de metricas en este momento (los mismos que se
+// publican en formato Prometheus)
+void showMetrics(const MetricsExporter& exporter) {
+    Metrics::Snapshot snapshot = Metrics::snapshot();
+    const auto& c = snapshot.counters;
+    
+    std::cout << "\n=== METRICAS ===\n";
+    std::cout << "Jugadas (makeMove): " << c[METRIC_MAKE_MOVES]
+              << ", revisiones de ganador: " << c[METRIC_WINNER_CHECKS] << "\n";
+    std::cout << "Guardados: " << c[METRIC_SAVES] << " (" << c[METRIC_SAVE_BYTES] << " bytes, "
+              << c[METRIC_SAVE_ERRORS] << " fallidos)\n";
+    std::cout << "Cargas: " << c[METRIC_LOADS] << " (" << c[METRIC_LOAD_BYTES] << " bytes, "
+              << c[METRIC_LOAD_ERRORS] << " fallidas)\n";
+    std::cout << "Listados del directorio: " << c[METRIC_DIRECTORY_SCANS] << " ("
+              << c[METRIC_SCANNED_ENTRIES] << " partidas recorridas)\n";
+    std::cout << "Limpiezas: " << c[METRIC_CLEANUPS] << " (" << c[METRIC_CLEANUP_DELETIONS] << " borradas)\n";
+    
+    const char* names[METRIC_HISTOGRAM_COUNT] = {"saveGame", "loadGame", "listSavedGames", "cleanOldSaves"};
+    std::cout << "Latencias en us (cantidad, media, p50, p99, maxima):\n";
+    for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+        const auto& histogram = snapshot.histograms[h];
+        std::cout << "  " << names[h] << ": " << histogram.count << ", " << histogram.meanNanos() / 1000.0
+                  << ", " << histogram.percentile(0.50) / 1000.0 << ", " << histogram.percentile(0.99) / 1000.0
+                  << ", " << histogram.maxNanos / 1000.0 << "\n";
+    }
+    if (exporter.isOpen()) {
+        std::cout << "Formato Prometheus en " << exporter.getPath() << "\n";
+    }
+    std::cout << "================\n";
+}
+
+// Numeros de la linea de comandos: todo el texto tiene que ser el numero.
+// Si no lo es lo informa con el nombre del argumento y devuelve false (el
+// comando sale con 1 en vez de terminar con una excepcion).
+bool parseArgument(const char* text, const char* name, long long& value) {
+    std::string argument = text;
+    try {
+        std::size_t used = 0;
+        value = std::stoll(argument, &used);
+        if (used == argument.size()) return true;
+    } catch (const std::exception&) {
+    }
+    std::cerr << "[ERROR] Argumento invalido para " << name << ": '" << argument << "' (se esperaba un entero)\n";
+    return false;
+}
+
+bool parseArgument(const char* text, const char* name, int& value) {
+    long long wide;
+    if (!parseArgument(text, name, wide)) return false;
+    if (wide < std::numeric_limits<int>::min() || wide > std::numeric_limits<int>::max()) {
+        std::cerr << "[ERROR] Argumento fuera de rango para " << name << ": " << text << "\n";
+        return false;
+    }
+    value = static_cast<int>(wide);
+    return true;
+}
+
+bool parseArgument(const char* text, const char* name, std::uint64_t& value) {
+    std::string argument = text;
+    try {
+        std::size_t used = 0;
+        value = std::stoull(argument, &used);
+        if (used == argument.size() && argument[0] != '-') return true;
+    } catch (const std::exception&) {
+    }
+    std::cerr << "[ERROR] Argumento invalido para " << name << ": '" << argument
+              << "' (se esperaba un entero sin signo)\n";
+    return false;
+}
+
+bool parseArgument(const char* text, const char* name, double& value) {
+    std::string argument = text;
+    try {
+        std::size_t used = 0;
+        value = std::stod(argument, &used);
+        if (used == argument.size()) return true;
+    } catch (const std::exception&) {
+    }
+    std::cerr << "[ERROR] Argumento invalido para " << name << ": '" << argument << "' (se esperaba un numero)\n";
+    return false;
+}
+
+// Valor de jugar 'cell' segun el solucionador en serie (misma escala que Result.score)
+template <int Rows, int Cols, int K>
+int serialMoveValue(Solver<Rows, Cols, K>& serial, Board<Rows, Cols, K> board, int player, int cell) {
+    const int empties = Board<Rows, Cols, K>::CELLS - board.moveCount();
+    board.play(cell, player);
+    if (board.completesLine(cell, player)) return empties;
+    return -serial.solve(board, player ^ 1).score;
+}
+
+// Posiciones sin terminar para comparar: en 3x3 todas las alcanzables, en
+// los demas 'count' partidas al azar cortadas con pocas casillas libres
+template <int Rows, int Cols, int K>
+void collectPositions(Board<Rows, Cols, K>& board, int player, std::set<std::uint64_t>& seen,
+                      std::vector<Board<Rows, Cols, K>>& positions) {
+    constexpr int CELLS = Board<Rows, Cols, K>::CELLS;
+    std::uint64_t key = board.bits(0).words[0] | (static_cast<std::uint64_t>(board.bits(1).words[0]) << 32);
+    if (board.hasLine(0) || board.hasLine(1) || board.isFull() || !seen.insert(key).second) return;
+    positions.push_back(board);
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.play(cell, player);
+        collectPositions(board, player ^ 1, seen, positions);
+        board.unplay(cell, player);
+    }
+}
+
+// Comprueba jugada por jugada el solucionador paralelo contra el serial: el
+// puntaje debe coincidir y la jugada elegida debe alcanzarlo
+template <int Rows, int Cols, int K>
+int verifyMoves(int threads, int tableBits, int count) {
+    using BoardType = Board<Rows, Cols, K>;
+    constexpr int CELLS = BoardType::CELLS;
+    const int VERIFY_EMPTIES = 10;  // Con mas casillas libres el serial tarda demasiado
+    
+    std::vector<BoardType> positions;
+    if (CELLS <= 9) {
+        BoardType empty;
+        std::set<std::uint64_t> seen;
+        collectPositions(empty, 0, seen, positions);
+    } else {
+        std::uint64_t rng = mixSeed(12345, CELLS);
+        while (static_cast<int>(positions.size()) < count) {
+            BoardType board;
+            int length = CELLS - 1 - static_cast<int>(nextRandom(rng) % VERIFY_EMPTIES);
+            for (int player = 0; board.moveCount() < length; player ^= 1) {
+                int cell;
+                do {
+                    cell = static_cast<int>(nextRandom(rng) % CELLS);
+                } while (!board.isEmpty(cell));
+                board.play(cell, player);
+                if (board.hasLine(player)) break;
+            }
+            if (!board.hasLine(0) && !board.hasLine(1)) positions.push_back(board);
+        }
+    }
+    
+    std::cout << "Verificando " << positions.size() << " posiciones contra el solucionador en serie...\n";
+    ParallelSolver<Rows, Cols, K> parallel(threads, tableBits);
+    Solver<Rows, Cols, K> serial;
+    long long wrong = 0;
+    for (const auto& board : positions) {
+        int player = board.moveCount() % 2;
+        auto expected = serial.solve(board, player);
+        auto result = parallel.solve(board, player);
+        int moveValue = serialMoveValue(serial, board, player, result.move);
+        if (result.score == expected.score && moveValue == expected.score) continue;
+        if (wrong++ < 5) {
+            std::cout << "  DIFERENCIA: X=" << board.bits(0).words[0] << " O=" << board.bits(1).words[0]
+                      << " puntaje " << result.score << " (serial " << expected.score << "), jugada "
+                      << result.move << " vale " << moveValue << "\n";
+        }
+    }
+    std::cout << "Diferencias: " << wrong << "\n";
+    return wrong == 0 ? 0 : 1;
 }
 
-int main() {
+// Resuelve una variante con la busqueda paralela y muestra el resumen por hilo
+template <int Rows, int Cols, int K>
+int solveVariant(int threads, int tableBits, int verify) {
+    ParallelSolver<Rows, Cols, K> solver(threads, tableBits);
+    Board<Rows, Cols, K> emptyBoard;
+    
+    std::cout << "Resolviendo " << Rows << "x" << Cols << " (k=" << K << ") con "
+              << solver.getThreadCount() << " hilos...\n";
+    auto result = solver.solve(emptyBoard, 0);
+    
+    std::cout << "Resultado con juego perfecto: "
+              << (result.score > 0 ? "gana X" : result.score < 0 ? "gana O" : "empate")
+              << " (primera jugada: " << result.move / Cols << " " << result.move % Cols << ")\n";
+    solver.printSummary(std::cout);
+    return verify > 0 ? verifyMoves<Rows, Cols, K>(threads, tableBits, verify) : 0;
+}
+
+// triki solve <3x3|4x4|5x5> [hilos] [bits de la tabla] [posiciones a verificar]
+// Con posiciones > 0 compara ademas jugada por jugada contra el solucionador
+// en serie (en 3x3 siempre todas las posiciones alcanzables)
+int runSolveCommand(int argc, char* argv[]) {
+    std::string variant = (argc > 2) ? argv[2] : "4x4";
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    int tableBits = 24;
+    int verify = 0;
+    if (argc > 3 && !parseArgument(argv[3], "hilos", threads)) return 1;
+    if (argc > 4 && !parseArgument(argv[4], "bits de la tabla", tableBits)) return 1;
+    if (argc > 5 && !parseArgument(argv[5], "posiciones a verificar", verify)) return 1;
+    
+    if (variant == "3x3") return solveVariant<3, 3, 3>(threads, tableBits, verify);
+    if (variant == "4x4") return solveVariant<4, 4, 4>(threads, tableBits, verify);
+    if (variant == "5x5") return solveVariant<5, 5, 4>(threads, tableBits, verify);
+    
+    std::cerr << "Variante desconocida: " << variant << " (usa 3x3, 4x4 o 5x5)\n";
+    return 1;
+}
+
+// Construye la tabla de finales de una variante y comprueba la posicion inicial
+template <int Rows, int Cols, int K>
+int buildTablebase(int threads, const std::string& path) {
+    using Table = Tablebase<Rows, Cols, K>;
+    std::string target = path.empty() ? Table::defaultPath() : path;
+    std::cout << "Construyendo la tabla de finales " << Rows << "x" << Cols << " (k=" << K << ") con "
+              << threads << " hilos: " << Table::positionCount() << " posiciones, "
+              << (Table::positionCount() + 3) / 4 << " bytes...\n";
+    
+    typename Table::BuildStats stats;
+    if (!Table::build(target, threads, stats)) {
+        Logger::flush();
+        std::cerr << "[ERROR] No se pudo construir " << target << "\n";
+        return 1;
+    }
+    auto table = Table::open(target);
+    Board<Rows, Cols, K> emptyBoard;
+    auto value = table ? table->value(emptyBoard) : Table::INVALID;
+    Logger::flush();
+    
+    std::cout << "Alcanzables: " << stats.reachable << " (gana quien mueve " << stats.wins
+              << ", empate " << stats.draws << ", pierde " << stats.losses << ")\n";
+    std::cout << "Tiempo: " << stats.seconds << " s\n";
+    std::cout << "Tablero vacio con juego perfecto: "
+              << (value == Table::WIN ? "gana X" : value == Table::LOSS ? "gana O" :
+                  value == Table::DRAW ? "empate" : "?") << "\n";
+    std::cout << "Tabla escrita en " << target << "\n";
+    return value == Table::INVALID ? 1 : 0;
+}
+
+// triki tablebase <4x4|5x5> [hilos] [archivo]
+int runTablebaseCommand(int argc, char* argv[]) {
+    std::string variant = (argc > 2) ? argv[2] : "4x4";
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (argc > 3 && !parseArgument(argv[3], "hilos", threads)) return 1;
+    std::string path = (argc > 4) ? argv[4] : "";
+    threads = std::max(1, threads);
+    
+    if (variant == "4x4") return buildTablebase<4, 4, 4>(threads, path);
+    if (variant == "5x5") return buildTablebase<5, 5, 4>(threads, path);
+    
+    std::cerr << "Variante desconocida: " << variant << " (usa 4x4 o 5x5)\n";
+    return 1;
+}
+
+// triki selfplay <partidas> <archivo> [hilos] [jugadorX] [jugadorO] [semilla]
+int runSelfPlayCommand(int argc, char* argv[]) {
+    SelfPlayConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2 && !parseArgument(argv[2], "partidas", config.games)) return 1;
+    if (argc > 3) config.outputPath = argv[3];
+    if (argc > 4 && !parseArgument(argv[4], "hilos", config.threads)) return 1;
+    if (argc > 5) config.playerX = argv[5];
+    if (argc > 6) config.playerO = argv[6];
+    if (argc > 7 && !parseArgument(argv[7], "semilla", config.seed)) return 1;
+    
+    std::cout << "Autojuego: " << config.games << " partidas, " << config.threads << " hilos, "
+              << config.playerX << " (X) vs " << config.playerO << " (O), semilla " << config.seed << "\n";
+    
+    SelfPlayStats stats;
+    if (!runSelfPlay(config, stats)) {
+        return 1;
+    }
+    
+    std::cout << "\n=== RESUMEN DE AUTOJUEGO ===\n";
+    std::cout << "Partidas: " << stats.games << " (X: " << stats.xWins << ", O: " << stats.oWins
+              << ", empates: " << stats.draws << ")\n";
+    std::cout << "Dataset: " << config.outputPath << " (" << stats.bytesWritten << " bytes)\n";
+    std::cout << "Tiempo: " << stats.seconds << " s, " << static_cast<long long>(stats.gamesPerSecond())
+              << " partidas/s\n";
+    std::cout << "Cola: profundidad maxima " << stats.maxQueueDepth << ", esperas del productor "
+              << stats.blockedPushes << "\n";
+    std::cout << "============================\n";
+    return 0;
+}
+
+// triki tournament <roundrobin|gauntlet> <jugador,jugador,...> [pares por emparejamiento] [hilos] [semilla] [jugadas de apertura]
+int runTournamentCommand(int argc, char* argv[]) {
+    TournamentConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string format = (argc > 2) ? argv[2] : "roundrobin";
+    std::string players = (argc > 3) ? argv[3] : "random,solver,mcts:100,mcts:1000";
+    if (argc > 4 && !parseArgument(argv[4], "pares", config.pairsPerMatch)) return 1;
+    if (argc > 5 && !parseArgument(argv[5], "hilos", config.threads)) return 1;
+    if (argc > 6 && !parseArgument(argv[6], "semilla", config.seed)) return 1;
+    if (argc > 7 && !parseArgument(argv[7], "jugadas de apertura", config.openingPlies)) return 1;
+    if (format != "roundrobin" && format != "gauntlet") {
+        std::cerr << "[ERROR] Formato desconocido: " << format << " (usa roundrobin o gauntlet)\n";
+        return 1;
+    }
+    config.gauntlet = format == "gauntlet";
+    for (std::size_t start = 0; start <= players.size();) {
+        std::size_t comma = std::min(players.find(',', start), players.size());
+        if (comma > start) config.players.push_back(players.substr(start, comma - start));
+        start = comma + 1;
+    }
+    
+    std::cout << "Torneo " << format << ": " << players << ", " << config.pairsPerMatch
+              << " pares por emparejamiento, " << config.threads << " hilos, semilla " << config.seed << "\n";
+    
+    TournamentStats stats;
+    if (!runTournament(config, stats)) {
+        return 1;
+    }
+    
+    std::cout << "\n=== CLASIFICACION ===\n";
+    std::vector<int> order(stats.players.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = static_cast<int>(i);
+    std::sort(order.begin(), order.end(), [&stats](int a, int b) { return stats.players[a].elo > stats.players[b].elo; });
+    for (int i : order) {
+        const auto& player = stats.players[i];
+        std::cout << player.name << ": Elo " << static_cast<long long>(std::lround(player.elo)) << " +- "
+                  << static_cast<long long>(std::lround(player.eloMargin)) << " (" << player.wins << " G, "
+                  << player.draws << " E, " << player.losses << " P, " << static_cast<int>(player.score() * 100)
+                  << "%)\n";
+    }
+    std::cout << "\n=== EMPAREJAMIENTOS (G-E-P del primero) ===\n";
+    for (const auto& match : stats.matches) {
+        std::cout << stats.players[match.first].name << " vs " << stats.players[match.second].name << ": "
+                  << match.wins << "-" << match.draws << "-" << match.losses << "\n";
+    }
+    std::cout << "\n=== TIEMPO POR JUGADA (us: media, p50, p99, maxima) ===\n";
+    for (const auto& player : stats.players) {
+        std::cout << player.name << ": " << player.moves << " jugadas, " << player.meanMoveMicros << ", "
+                  << player.p50MoveMicros << ", " << player.p99MoveMicros << ", " << player.maxMoveMicros << "\n";
+    }
+    std::cout << "\nPartidas: " << stats.games << " en " << stats.seconds << " s ("
+              << static_cast<long long>(stats.gamesPerSecond()) << " partidas/s)\n";
+    std::cout << "=====================\n";
+    return 0;
+}
+
+// triki analyze [directorio] [hilos] [json|csv] [archivo]
+int runAnalyzeCommand(int argc, char* argv[]) {
+    AnalyticsConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2) config.directory = argv[2];
+    if (argc > 3 && !parseArgument(argv[3], "hilos", config.threads)) return 1;
+    std::string format = argc > 4 ? argv[4] : "json";
+    if (format != "json" && format != "csv") {
+        std::cerr << "Formato desconocido: " << format << " (json o csv)\n";
+        return 1;
+    }
+    // El registro tambien sale por stdout: con el informe ahi solo se dejan
+    // los errores, que se dan justamente cuando no hay informe
+    if (argc <= 5) {
+        Logger::setLevel(LOG_ERROR);
+    }
+    
+    AnalyticsReport report;
+    if (!runAnalytics(config, report)) {
+        return 1;
+    }
+    
+    // El informe va a stdout o a un archivo; el resumen siempre a stderr
+    std::ofstream file;
+    if (argc > 5) {
+        file.open(argv[5]);
+        if (!file.is_open()) {
+            std::cerr << "[ERROR] No se pudo crear " << argv[5] << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = file.is_open() ? file : std::cout;
+    if (format == "json") {
+        writeAnalyticsJson(report, out);
+    } else {
+        writeAnalyticsCsv(report, out);
+    }
+    
+    std::cerr << "Analisis: " << report.files << " partidas (" << report.corrupt << " danadas) en "
+              << report.seconds << " s con " << config.threads << " hilos, "
+              << static_cast<long long>(report.filesPerSecond()) << " partidas/s"
+              << (report.packed ? " (almacen empaquetado)" : " (archivos sueltos)") << "\n";
+    return 0;
+}
+
+GameServer* activeServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer) activeServer->stop();
+}
+
+// triki server <puerto|ruta.sock> [max_sesiones] [diario] [ventana en us] [metricas] [espectadores]
+// Pasa al almacen empaquetado las partidas sueltas (.triki) del directorio
+// y, ya en disco, borra los archivos importados
+int runMigrateCommand(int argc, char* argv[]) {
+    std::string directory = argc > 2 ? argv[2] : "saves";
+    FileManager fileManager(directory);
+    std::shared_ptr<SaveStore> store = fileManager.getStore();
+    if (!store) {
+        std::cerr << "[ERROR] No se pudo abrir el almacen de " << directory << "\n";
+        return 1;
+    }
+    int imported = store->importLooseFiles(true);
+    if (imported < 0) {
+        return 1;
+    }
+    std::cout << imported << " partidas sueltas pasadas al almacen de " << directory << "\n";
+    return 0;
+}
+
+int runServerCommand(int argc, char* argv[]) {
+    GameServer::Config config;
+    if (argc > 2) config.address = argv[2];
+    if (argc > 3 && !parseArgument(argv[3], "max_sesiones", config.maxSessions)) return 1;
+    if (argc > 4) config.journalPath = argv[4];
+    if (argc > 5 && !parseArgument(argv[5], "ventana en us", config.commitWindowMicros)) return 1;
+    // Socket (.sock) o archivo con las metricas en formato Prometheus
+    // ("-" para no publicarlas y dar el argumento siguiente)
+    std::unique_ptr<MetricsExporter> exporter;
+    if (argc > 6 && std::string(argv[6]) != "-") exporter = std::make_unique<MetricsExporter>(argv[6]);
+    // Transmision para "triki espectador" ("-" = la ruta por defecto)
+    if (argc > 7) config.spectatorPath = std::string(argv[7]) == "-" ? SpectatorFeed::DEFAULT_PATH : argv[7];
+    
+    GameServer server(config);
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    
+    bool ok = server.run();
+    activeServer = nullptr;
+    if (!ok) {
+        return 1;
+    }
+    
+    const auto& stats = server.getStats();
+    std::cout << "\n=== SERVIDOR DETENIDO ===\n";
+    std::cout << "Conexiones: " << stats.connections << ", ordenes: " << stats.commands
+              << ", jugadas: " << stats.moves << ", errores: " << stats.errors << "\n";
+    std::cout << "Sesiones simultaneas (maximo): " << stats.peakSessions << "\n";
+    if (!config.journalPath.empty()) {
+        std::cout << "Diario: " << stats.journal.records << " registros en " << stats.journal.commits
+                  << " fsync (" << stats.journal.recordsPerCommit() << " por fsync), "
+                  << stats.journal.compactions << " compactaciones\n";
+    }
+    if (stats.io.submitted > 0) {
+        std::cout << "E/S asincrona: " << stats.io.completed << " pedidos en " << stats.io.batches
+                  << " tandas (maximo " << stats.io.maxBatchSize << "), cola maxima " << stats.io.maxQueueDepth
+                  << ", latencia media " << stats.io.averageLatencyMicros << " us, maxima "
+                  << stats.io.maxLatencyMicros << " us, fallidos " << stats.io.failed << "\n";
+    }
+    if (!config.spectatorPath.empty()) {
+        std::cout << "Espectadores: " << stats.spectators.records << " registros, "
+                  << stats.spectators.unpublished << " partidas sin transmitir, "
+                  << stats.spectators.evicted << " desalojadas\n";
+    }
+    return 0;
+}
+
+// Titulo del cuadro de un tablero de la transmision
+std::string spectatorTitle(const SpectatorView::Board& board) {
+    std::string title = "=== Partida " + std::to_string(board.id) + " (" + std::to_string(board.rows) + "x" +
+                        std::to_string(board.cols) + ", k=" + std::to_string(board.k) + "), jugada " +
+                        std::to_string(board.moves.size());
+    if (board.ended) {
+        title += " - " + (board.winner != ' ' ? std::string("gana ") + board.winner : std::string("empate"));
+    }
+    return title + " ===";
+}
+
+std::atomic<bool> spectatorRunning{true};
+
+void stopSpectator(int) {
+    spectatorRunning = false;
+}
+
+// triki espectador [ruta] [id] [segundos] [pantalla]
+// Sigue la transmision de un servidor o del menu y dibuja cada tablero que
+// cambia (solo el de 'id' si se da, 0 = todos) hasta Ctrl+C o 'segundos'.
+// 'pantalla' es auto, terminal, texto o ninguno (ver createRenderer).
+int runSpectatorCommand(int argc, char* argv[]) {
+    std::string path = (argc > 2) ? argv[2] : SpectatorFeed::DEFAULT_PATH;
+    std::uint64_t followId = 0;
+    double seconds = 0.0;
+    if (argc > 3 && !parseArgument(argv[3], "id", followId)) return 1;
+    if (argc > 4 && !parseArgument(argv[4], "segundos", seconds)) return 1;
+    std::string screen = (argc > 5) ? argv[5] : "auto";
+    
+    auto renderer = createRenderer(screen);
+    if (!renderer) {
+        std::cerr << "[ERROR] Pantalla desconocida: " << screen << " (usa auto, terminal, texto o ninguno)\n";
+        return 1;
+    }
+    
+    std::signal(SIGINT, stopSpectator);
+    std::signal(SIGTERM, stopSpectator);
+    auto start = std::chrono::steady_clock::now();
+    
+    SpectatorView view(path);
+    bool wasOpen = false;
+    long long overruns = 0;
+    // Ultimo tablero dibujado (rows = 0: ninguno todavia) y el ultimo aviso,
+    // que va debajo junto con los contadores
+    SpectatorView::Board shown;
+    std::string notice = "Mirando " + path + " (Ctrl+C para salir)";
+    auto draw = [&]() {
+        const auto& stats = view.getStats();
+        renderer->render(shown.rows ? spectatorTitle(shown) : std::string(), shown.cells.data(), shown.rows,
+                         shown.cols, notice + "\nRegistros aplicados: " + std::to_string(stats.records) +
+                         ", vueltas perdidas: " + std::to_string(stats.overruns));
+    };
+    draw();
+    while (spectatorRunning) {
+        std::vector<std::uint64_t> changed = view.poll();
+        bool redraw = false;
+        if (view.isOpen() != wasOpen) {
+            wasOpen = view.isOpen();
+            notice = wasOpen ? "[transmision abierta]" : "[esperando la transmision]";
+            redraw = true;
+        }
+        if (view.getStats().overruns > overruns) {
+            overruns = view.getStats().overruns;
+            notice = "[retraso: el anillo dio la vuelta, resincronizado desde las fotos]";
+            redraw = true;
+        }
+        
+        const auto& boards = view.getBoards();
+        for (std::uint64_t id : changed) {
+            if (followId && id != followId) continue;
+            auto it = boards.find(id);
+            if (it != boards.end()) {
+                shown = it->second;
+                draw();
+                redraw = false;
+            } else {
+                notice = "[partida " + std::to_string(id) + " cerrada]";
+                redraw = true;
+            }
+        }
+        if (redraw) {
+            draw();
+        }
+        
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (seconds > 0 && elapsed.count() >= seconds) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    
+    const auto& stats = view.getStats();
+    const auto& drawn = renderer->getStats();
+    std::cout << "\nRegistros aplicados: " << stats.records << ", vueltas perdidas: " << stats.overruns
+              << ", partidas visibles: " << view.getBoards().size() << "\n";
+    std::cout << "Cuadros: " << drawn.frames << " (" << drawn.fullRedraws << " completos), caracteres escritos: "
+              << drawn.changedChars << ", bytes: " << drawn.bytesWritten << "\n";
+    return 0;
+}
+
+// triki client <puerto|ruta.sock> [conexiones] [partidas por conexion]
+int runClientCommand(int argc, char* argv[]) {
+    LoadClientConfig config;
+    if (argc > 2) config.address = argv[2];
+    if (argc > 3 && !parseArgument(argv[3], "conexiones", config.connections)) return 1;
+    if (argc > 4 && !parseArgument(argv[4], "partidas por conexion", config.gamesPerConnection)) return 1;
+    
+    std::cout << "Carga: " << config.connections << " conexiones x " << config.gamesPerConnection
+              << " partidas contra " << config.address << "\n";
+    
+    LoadClientStats stats;
+    bool ok = runLoadClient(config, stats);
+    
+    std::cout << "\n=== RESUMEN DE CARGA ===\n";
+    std::cout << "Partidas: " << stats.games << ", jugadas: " << stats.moves
+              << ", errores: " << stats.errors << "\n";
+    std::cout << "Tiempo: " << stats.seconds << " s, " << static_cast<long long>(stats.movesPerSecond())
+              << " jugadas/s\n";
+    std::cout << "Latencia de MOVE: p50 " << stats.p50Micros << " us, p99 " << stats.p99Micros
+              << " us, maxima " << stats.maxMicros << " us\n";
+    std::cout << "========================\n";
+    return ok && stats.errors == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Modo por linea de comandos (sin menu interactivo)
+    if (argc > 1) {
+        std::string command = argv[1];
+        if (command == "solve") {
+            return runSolveCommand(argc, argv);
+        }
+        if (command == "tablebase") {
+            return runTablebaseCommand(argc, argv);
+        }
+        if (command == "selfplay") {
+            return runSelfPlayCommand(argc, argv);
+        }
+        if (command == "tournament") {
+            return runTournamentCommand(argc, argv);
+        }
+        if (command == "analyze") {
+            return runAnalyzeCommand(argc, argv);
+        }
+        if (command == "migrar") {
+            return runMigrateCommand(argc, argv);
+        }
+        if (command == "server") {
+            return runServerCommand(argc, argv);
+        }
+        if (command == "client") {
+            return runClientCommand(argc, argv);
+        }
+        if (command == "espectador") {
+            return runSpectatorCommand(argc, argv);
+        }
+        std::cerr << "Comando desconocido: " << command << "\n";
+        std::cerr << "Uso: triki solve <3x3|4x4|5x5> [hilos] [bits de la tabla] [posiciones a verificar]\n";
+        std::cerr << "     triki tablebase <4x4|5x5> [hilos] [archivo]\n";
+        std::cerr << "     triki selfplay <partidas> <archivo> [hilos] [jugadorX] [jugadorO] [semilla]\n";
+        std::cerr << "     triki tournament <roundrobin|gauntlet> <jugador,jugador,...> [pares] [hilos] [semilla] [apertura]\n";
+        std::cerr << "     triki analyze [directorio] [hilos] [json|csv] [archivo]\n";
+        std::cerr << "     triki migrar [directorio]\n";
+        std::cerr << "     triki server <puerto|ruta.sock> [max_sesiones] [diario] [ventana en us] [metricas.sock|archivo|-]"
+                     " [espectadores|-]\n";
+        std::cerr << "     triki client <puerto|ruta.sock> [conexiones] [partidas por conexion]\n";
+        std::cerr << "     triki espectador [transmision] [id] [segundos] [auto|terminal|texto|ninguno]\n";
+        return 1;
+    }
+    
+    // El menu es didactico: muestra tambien los mensajes de memoria y archivos
+    Logger::setLevel(LOG_DEBUG);
+    
+    // Un solo FileManager para toda la sesion: el directorio se revisa una
+    // vez y las consultas del menu se responden desde memoria
+    FileManager fileManager;
+    // Partidas iguales guardadas desde el menu comparten un solo archivo
+    fileManager.setContentAddressed(true);
+    
+    // Partidas interrumpidas en una ejecucion anterior
+    std::string journalPath = fileManager.getSaveDirectory() + "/diario.wal";
+    auto recovered = MoveJournal::recoverToSnapshots(journalPath);
+    Logger::flush();
+    for (const auto& name : recovered) {
+        std::cout << "Partida interrumpida recuperada como '" << name << "'\n";
+    }
+    MoveJournal::Config journalConfig;
+    journalConfig.path = journalPath;
+    MoveJournal journal(journalConfig);
+    if (journal.isOpen()) {
+        activeJournal = &journal;
+    }
+    
+    // Metricas en vivo para Prometheus (p. ej. "nc -U saves/metricas.sock")
+    MetricsExporter metricsExporter(fileManager.getSaveDirectory() + "/metricas.sock");
+    
+    // Las partidas del menu tambien se pueden mirar con "triki espectador"
+    SpectatorFeed spectatorFeed(SpectatorFeed::Config{});
+    if (spectatorFeed.isOpen()) {
+        activeFeed = &spectatorFeed;
+    }
+    
     std::cout << "=== PROYECTO TRIKI - KAREN ORTIZ ===\n";
     std::cout << "Demostrando: Estructuras de datos, punteros, manejo de memoria\n";
     
@@ -170,21 +996,27 @@ int main() {
         
         switch (choice) {
             case 1:
-                playNewGame();
+                playNewGame(fileManager);
                 break;
             case 2:
-                loadAndPlayGame();
+                playAgainstCpu();
                 break;
             case 3:
-                showSavedGames();
+                loadAndPlayGame(fileManager);
                 break;
             case 4:
-                deleteGame();
+                showSavedGames(fileManager);
                 break;
             case 5:
-                showSystemInfo();
+                deleteGame(fileManager);
                 break;
             case 6:
+                showSystemInfo(fileManager);
+                break;
+            case 7:
+                showMetrics(metricsExporter);
+                break;
+            case 8:
                 std::cout << "Gracias por usar el sistema!\n";
                 std::cout << "Liberando memoria automaticamente...\n";
                 running = false;
@@ -194,6 +1026,8 @@ int main() {
                 break;
         }
         
+        Logger::flush();  // Que los mensajes de la opcion salgan antes del siguiente aviso
+        
         if (running) {
             std::cout << "\nPresiona Enter para continuar...";
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');